@@ -10,6 +10,8 @@
 -- local M = { HOT_RELOAD = true }
 
 local HOT_RELOAD_MARK = "HOT_RELOAD"
+--- 原生实现的模块依赖图与引用替换，见 HotReloadLib.cpp
+local native = package.loaded["UnLua.HotReloadLib"]
 local loaded_modules = setmetatable({}, { __mode = "v" })
 local ignore_modules = {}
 local config = {
@@ -118,6 +120,26 @@ local function get_last_modified_time(module_name)
     return UE.UUnLuaFunctionLibrary.GetFileLastModifiedTimestamp(filename)
 end
 
+--- 正在执行的模块栈，用于记录require依赖关系
+local loading_stack = {}
+
+local function add_dependency(module_name)
+    local parent = loading_stack[#loading_stack]
+    if native and parent then
+        native.add_dependency(parent, module_name)
+    end
+end
+
+local function exec_module(module_name, func, ...)
+    if native then
+        native.clear_dependencies(module_name)
+    end
+    loading_stack[#loading_stack + 1] = module_name
+    local result = table.pack(xpcall(func, load_error_handler, ...))
+    loading_stack[#loading_stack] = nil
+    return table.unpack(result, 1, result.n)
+end
+
 local function make_sandbox()
     local reloading
     local loaded
@@ -148,6 +170,7 @@ local function make_sandbox()
         -- https://github.com/lua/lua/blob/v5.4.0/loadlib.c#L680
         -- https://github.com/lua/lua/blob/v5.3/loadlib.c#L617
         -- lua5.4之后会返回2个值，这里保持一样的行为
+        add_dependency(module_name)
         if package.loaded[module_name] ~= nil then
             return package.loaded[module_name], nil
         end
@@ -162,7 +185,7 @@ local function make_sandbox()
 
         local func, env = load(module_name)
         if func then
-            local _, new_module = xpcall(func, load_error_handler, ...)
+            local _, new_module = exec_module(module_name, func, ...)
             if loaded_modules[module_name] == nil then
                 loaded_modules[module_name] = new_module
                 package.loaded[module_name] = new_module
@@ -196,6 +219,7 @@ local function make_sandbox()
     end
 
     proxy.require = function(module_name, ...)
+        add_dependency(module_name)
         if reloading then
             if loaded[module_name] ~= nil then
                 return loaded[module_name]
@@ -376,6 +400,12 @@ local function update_global(value_map)
     exclude[package.loaded] = true
     exclude[loaded_modules] = true
 
+    if native then
+        local count = native.patch(value_map, exclude)
+        print("patched references :", count)
+        return
+    end
+
     local update_table
 
     local function update_running_stack(co, level)
@@ -574,7 +604,7 @@ local function reload_modules(module_names)
         else
             local func, env = sandbox.load(module_name)
             if func ~= nil then
-                local ok, new_module = xpcall(func, load_error_handler)
+                local ok, new_module = exec_module(module_name, func)
                 if not ok then
                     sandbox.exit()
                     return
@@ -601,8 +631,30 @@ local function reload_modules(module_names)
     sandbox.exit()
 end
 
+--- 展开为指定模块以及依赖它们的已加载模块，被依赖的模块排在前面
+local function expand_dependents(module_names)
+    if not native then
+        return module_names
+    end
+
+    local ret = {}
+    for _, module_name in ipairs(native.collect_dependents(module_names)) do
+        if loaded_modules[module_name] and not ignore_modules[module_name] then
+            ret[#ret + 1] = module_name
+        end
+    end
+    return ret
+end
+
 function M.reload(module_names)
     if module_names then
+        module_names = expand_dependents(module_names)
+        for _, module_name in ipairs(module_names) do
+            if loaded_module_times[module_name] then
+                loaded_module_times[module_name] = get_last_modified_time(module_name)
+            end
+        end
+        print("reload modules:", dump(module_names))
         reload_modules(module_names)
         return
     end
@@ -50,16 +50,20 @@ namespace UnLua
                 FString Name = FString("F" + StructType->GetName());
                 uint8 StructPadding = StructType->GetMinAlignment();
                 uint8 Padding = StructPadding < 8 ? 8 : StructPadding;
-                void* Userdata = NewUserdataWithPadding(L, StructType->GetStructureSize(), TCHAR_TO_UTF8(*Name), Padding);
+                bool bRecycled;
+                void* Userdata = NewStructUserdata(L, StructType->GetStructureSize(), TCHAR_TO_UTF8(*Name), Padding, bRecycled);
                 if (Userdata != nullptr)
                 {
-                    if (StructType->StructFlags & STRUCT_CopyNative)
+                    if (!bRecycled)
                     {
-                        //Do ScriptStruct Construct
-                        UScriptStruct::ICppStructOps* TheCppStructOps = StructType->GetCppStructOps();
-                        TheCppStructOps->Construct(Userdata);
+                        if (StructType->StructFlags & STRUCT_CopyNative)
+                        {
+                            //Do ScriptStruct Construct
+                            UScriptStruct::ICppStructOps* TheCppStructOps = StructType->GetCppStructOps();
+                            TheCppStructOps->Construct(Userdata);
+                        }
+                        StructType->InitializeStruct(Userdata);
                     }
-                    StructType->InitializeStruct(Userdata);
                     StructType->CopyScriptStruct(Userdata, RowPtr);
                 }
             }
@@ -29,6 +29,122 @@ static FORCEINLINE void TMap_Guard(lua_State* L, FLuaMap* Map)
         luaL_error(L, TCHAR_TO_UTF8(*FString::Printf(TEXT("invalid TMap value type:%s"), *Map->ValueInterface->GetName())));
 }
 
+/**
+ * 可以直接从Lua栈上取值并计算哈希的键类型，避免通过ITypeInterface初始化/写入/析构临时键
+ */
+enum class EMapKeyKind : uint8
+{
+    Generic,
+    Integer,
+    Name,
+    String,
+    Object,
+};
+
+static EMapKeyKind GetMapKeyKind(const FProperty* Property)
+{
+    if (!Property || Property->ArrayDim != 1)
+        return EMapKeyKind::Generic;
+
+    if (const auto EnumProperty = CastField<FEnumProperty>(Property))
+        return GetMapKeyKind(EnumProperty->GetUnderlyingProperty());
+    // 有符号与无符号整数的哈希和比较结果一致，按大小区分即可
+    if (Property->IsA<FByteProperty>() || Property->IsA<FIntProperty>() || Property->IsA<FUInt32Property>()
+        || Property->IsA<FInt64Property>() || Property->IsA<FUInt64Property>())
+        return EMapKeyKind::Integer;
+    if (Property->IsA<FNameProperty>())
+        return EMapKeyKind::Name;
+    if (Property->IsA<FStrProperty>())
+        return EMapKeyKind::String;
+    if (Property->GetClass() == FObjectProperty::StaticClass())
+        return EMapKeyKind::Object;
+    return EMapKeyKind::Generic;
+}
+
+template <typename T>
+struct TMapNativeKey
+{
+    static uint32 Hash(const void* Key) { return GetTypeHash(*(const T*)Key); }
+    static bool Equals(const void* A, const void* B) { return *(const T*)A == *(const T*)B; }
+};
+
+/**
+ * 用原生键调用Func(Key, GetKeyHash, KeyEquality)，键的内存布局与TMap中的键一致。
+ * bForAdd为true时会把键写入TMap，FString这类需要分配内存的键走通用路径。
+ * 返回false表示不适用快速路径。
+ */
+template <typename FuncType>
+static bool TMap_WithNativeKey(lua_State* L, FLuaMap* Map, int32 Index, bool bForAdd, FuncType&& Func)
+{
+    const auto KeyProperty = Map->KeyInterface->GetUProperty();
+    switch (GetMapKeyKind(KeyProperty))
+    {
+    case EMapKeyKind::Integer:
+        {
+            if (!lua_isinteger(L, Index))
+                return false;
+            const uint64 Value = (uint64)lua_tointeger(L, Index);
+            switch (KeyProperty->ElementSize)
+            {
+            case sizeof(uint8):
+                {
+                    const uint8 Key = (uint8)Value;
+                    Func(&Key, TMapNativeKey<uint8>::Hash, TMapNativeKey<uint8>::Equals);
+                    return true;
+                }
+            case sizeof(uint32):
+                {
+                    const uint32 Key = (uint32)Value;
+                    Func(&Key, TMapNativeKey<uint32>::Hash, TMapNativeKey<uint32>::Equals);
+                    return true;
+                }
+            case sizeof(uint64):
+                {
+                    Func(&Value, TMapNativeKey<uint64>::Hash, TMapNativeKey<uint64>::Equals);
+                    return true;
+                }
+            default:
+                return false;
+            }
+        }
+    case EMapKeyKind::Name:
+        {
+            if (lua_type(L, Index) != LUA_TSTRING)
+                return false;
+            const FName Key(UTF8_TO_TCHAR(lua_tostring(L, Index)), bForAdd ? FNAME_Add : FNAME_Find);
+            if (Key.IsNone())
+                return false;
+            Func(&Key, TMapNativeKey<FName>::Hash, TMapNativeKey<FName>::Equals);
+            return true;
+        }
+    case EMapKeyKind::String:
+        {
+            if (bForAdd || lua_type(L, Index) != LUA_TSTRING)
+                return false;
+            // 与GetTypeHash(FString)/FString::operator==一致，大小写不敏感
+            const FUTF8ToTCHAR Chars(lua_tostring(L, Index));
+            const TCHAR* Key = Chars.Get();
+            Func(Key,
+                [](const void* A) { return FCrc::Strihash_DEPRECATED((const TCHAR*)A); },
+                [](const void* A, const void* B) { return FCString::Stricmp((const TCHAR*)A, **(const FString*)B) == 0; });
+            return true;
+        }
+    case EMapKeyKind::Object:
+        {
+            UObject* Key = UnLua::GetUObject(L, Index, false);
+            if (!Key || UnLua::LowLevel::IsReleasedPtr(Key) || !Key->IsA(((const FObjectProperty*)KeyProperty)->PropertyClass))
+                return false;
+            const UnLua::ITypeInterface* KeyInterface = Map->KeyInterface.Get();
+            Func(&Key,
+                [KeyInterface](const void* A) { return KeyInterface->GetValueTypeHash(A); },
+                [](const void* A, const void* B) { return *(UObject* const*)A == *(UObject* const*)B; });
+            return true;
+        }
+    default:
+        return false;
+    }
+}
+
 static int32 TMap_New(lua_State* L)
 {
     int32 NumParams = lua_gettop(L);
@@ -135,12 +251,19 @@ static int32 TMap_Add(lua_State* L)
     TMap_Guard(L, Map);
 
     void* ValueCache = (uint8*)Map->ElementCache + Map->MapLayout.ValueOffset;
-    Map->KeyInterface->Initialize(Map->ElementCache);
     Map->ValueInterface->Initialize(ValueCache);
-    Map->KeyInterface->WriteValue_InContainer(L, Map->ElementCache, 2);
     Map->ValueInterface->WriteValue_InContainer(L, Map->ValueInterface->GetOffset() > 0 ? Map->ElementCache : ValueCache, 3);
-    Map->Add(Map->ElementCache, ValueCache);
-    Map->KeyInterface->Destruct(Map->ElementCache);
+    const bool bNativeKey = TMap_WithNativeKey(L, Map, 2, true, [Map, ValueCache](const void* Key, auto GetKeyHash, auto KeyEquality)
+    {
+        Map->Add(Key, ValueCache, GetKeyHash, KeyEquality);
+    });
+    if (!bNativeKey)
+    {
+        Map->KeyInterface->Initialize(Map->ElementCache);
+        Map->KeyInterface->WriteValue_InContainer(L, Map->ElementCache, 2);
+        Map->Add(Map->ElementCache, ValueCache);
+        Map->KeyInterface->Destruct(Map->ElementCache);
+    }
     Map->ValueInterface->Destruct(ValueCache);
     return 0;
 }
@@ -157,10 +280,18 @@ static int32 TMap_Remove(lua_State* L)
     FLuaMap* Map = (FLuaMap*)(GetCppInstanceFast(L, 1));
     TMap_Guard(L, Map);
 
-    Map->KeyInterface->Initialize(Map->ElementCache);
-    Map->KeyInterface->WriteValue_InContainer(L, Map->ElementCache, 2);
-    bool bSuccess = Map->Remove(Map->ElementCache);
-    Map->KeyInterface->Destruct(Map->ElementCache);
+    bool bSuccess = false;
+    const bool bNativeKey = TMap_WithNativeKey(L, Map, 2, false, [Map, &bSuccess](const void* Key, auto GetKeyHash, auto KeyEquality)
+    {
+        bSuccess = Map->Remove(Key, GetKeyHash, KeyEquality);
+    });
+    if (!bNativeKey)
+    {
+        Map->KeyInterface->Initialize(Map->ElementCache);
+        Map->KeyInterface->WriteValue_InContainer(L, Map->ElementCache, 2);
+        bSuccess = Map->Remove(Map->ElementCache);
+        Map->KeyInterface->Destruct(Map->ElementCache);
+    }
     lua_pushboolean(L, bSuccess);
     return 1;
 }
@@ -177,6 +308,21 @@ static int32 TMap_Find(lua_State* L)
     FLuaMap* Map = (FLuaMap*)(GetCppInstanceFast(L, 1));
     TMap_Guard(L, Map);
 
+    void* Value = nullptr;
+    const bool bNativeKey = TMap_WithNativeKey(L, Map, 2, false, [Map, &Value](const void* Key, auto GetKeyHash, auto KeyEquality)
+    {
+        Value = Map->Find(Key, GetKeyHash, KeyEquality);
+    });
+    if (bNativeKey)
+    {
+        // 直接从TMap中的值创建拷贝，不经过ElementCache
+        if (Value)
+            Map->ValueInterface->ReadValue(L, Value, true);
+        else
+            lua_pushnil(L);
+        return 1;
+    }
+
     void* ValueCache = (uint8*)Map->ElementCache + Map->MapLayout.ValueOffset;
     Map->KeyInterface->Initialize(Map->ElementCache);
     Map->ValueInterface->Initialize(ValueCache);
@@ -207,9 +353,18 @@ static int32 TMap_FindRef(lua_State* L)
     FLuaMap* Map = (FLuaMap*)(GetCppInstanceFast(L, 1));
     TMap_Guard(L, Map);
 
-    Map->KeyInterface->Initialize(Map->ElementCache);
-    Map->KeyInterface->WriteValue_InContainer(L, Map->ElementCache, 2);
-    void* Value = Map->Find(Map->ElementCache);
+    void* Value = nullptr;
+    const bool bNativeKey = TMap_WithNativeKey(L, Map, 2, false, [Map, &Value](const void* Key, auto GetKeyHash, auto KeyEquality)
+    {
+        Value = Map->Find(Key, GetKeyHash, KeyEquality);
+    });
+    if (!bNativeKey)
+    {
+        Map->KeyInterface->Initialize(Map->ElementCache);
+        Map->KeyInterface->WriteValue_InContainer(L, Map->ElementCache, 2);
+        Value = Map->Find(Map->ElementCache);
+        Map->KeyInterface->Destruct(Map->ElementCache);
+    }
     if (Value)
     {
         Map->ValueInterface->ReadValue(L, Value, false);
@@ -218,7 +373,6 @@ static int32 TMap_FindRef(lua_State* L)
     {
         lua_pushnil(L);
     }
-    Map->KeyInterface->Destruct(Map->ElementCache);
     return 1;
 }
 
@@ -304,33 +458,19 @@ static int32 TMap_ToTable(lua_State* L)
     FLuaMap* Map = (FLuaMap*)(GetCppInstanceFast(L, 1));
     TMap_Guard(L, Map);
 
-    void* MemData = FMemory::Malloc(sizeof(FLuaArray), alignof(FLuaArray));
-    FLuaArray* Keys = Map->Keys(MemData);
-    Keys->Inner->Initialize(Keys->ElementCache);
-    lua_newtable(L);
-    for (int32 i = 0; i < Keys->Num(); ++i)
+    // 直接遍历稀疏数组，每个键值对只读取一次
+    lua_createtable(L, 0, Map->Num());
+    for (int32 Index = 0, Remaining = Map->Num(); Remaining > 0; ++Index)
     {
-        Keys->Get(i, Keys->ElementCache);
-        Keys->Inner->ReadValue_InContainer(L, Keys->ElementCache, true);
-
-        void* ValueCache = (uint8*)Map->ElementCache + Map->MapLayout.ValueOffset;
-        Map->ValueInterface->Initialize(ValueCache);
-        bool bSuccess = Map->Find(Keys->ElementCache, ValueCache);
-        if (bSuccess)
-        {
-            Map->ValueInterface->ReadValue_InContainer(L, Map->ValueInterface->GetOffset() > 0 ? Map->ElementCache : ValueCache, true);
-        }
-        else
-        {
-            lua_pushnil(L);
-        }
+        if (!Map->IsValidIndex(Index))
+            continue;
 
+        const uint8* Pair = Map->GetData(Index);
+        Map->KeyInterface->ReadValue(L, Pair, true);
+        Map->ValueInterface->ReadValue(L, Pair + Map->MapLayout.ValueOffset, true);
         lua_rawset(L, -3);
-
-        Map->ValueInterface->Destruct(ValueCache);
+        --Remaining;
     }
-    Keys->Inner->Destruct(Keys->ElementCache);
-    FMemory::Free(MemData);
     return 1;
 }
 
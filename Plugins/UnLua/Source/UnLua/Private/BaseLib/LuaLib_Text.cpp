@@ -15,23 +15,252 @@
 #if UNLUA_ENABLE_FTEXT
 
 #include "UnLuaEx.h"
+#include "LuaCore.h"
+#include "LowLevel.h"
+#include "Internationalization/TextLocalizationManager.h"
 
 namespace UnLua
 {
+    static const char* DISPLAY_STRING_CACHE_KEY = "UnLuaTextDisplayStrings";
+
+    /**
+     * 按FText实例缓存转换后的字符串，本地化版本变化（切换语言、刷新本地化资源）后整体失效
+     */
+    static void PushDisplayString(lua_State* L, int32 Index, const FText& Text)
+    {
+        Index = lua_absindex(L, Index);
+        const lua_Integer Revision = FTextLocalizationManager::Get().GetTextRevision();
+        bool bValid = false;
+        if (lua_getfield(L, LUA_REGISTRYINDEX, DISPLAY_STRING_CACHE_KEY) == LUA_TTABLE)
+        {
+            lua_rawgeti(L, -1, 0);
+            bValid = lua_tointeger(L, -1) == Revision;
+            lua_pop(L, 1);
+        }
+        if (!bValid)
+        {
+            lua_pop(L, 1);
+            LowLevel::CreateWeakKeyTable(L);
+            lua_pushinteger(L, Revision);
+            lua_rawseti(L, -2, 0);
+            lua_pushvalue(L, -1);
+            lua_setfield(L, LUA_REGISTRYINDEX, DISPLAY_STRING_CACHE_KEY);
+        }
+
+        lua_pushvalue(L, Index);
+        if (lua_rawget(L, -2) != LUA_TSTRING)
+        {
+            lua_pop(L, 1);
+            lua_pushstring(L, TCHAR_TO_UTF8(*Text.ToString()));
+            lua_pushvalue(L, Index);
+            lua_pushvalue(L, -2);
+            lua_rawset(L, -4);
+        }
+        lua_remove(L, -2);
+    }
+
+    static void PushText(lua_State* L, FText&& Text)
+    {
+        new(NewTypedUserdata(L, FText)) FText(MoveTemp(Text));
+    }
+
+    /**
+     * 取得Index处FText的userdata，其他类型的userdata返回nullptr
+     */
+    static FText* GetTextInstance(lua_State* L, int32 Index)
+    {
+        if (!luaL_testudata(L, Index, "FText"))
+            return nullptr;
+        return (FText*)GetCppInstanceFast(L, Index);
+    }
+
+    /**
+     * 取得Index处的FText，Lua字符串转为FText::FromString，其他类型返回false
+     */
+    static bool GetText(lua_State* L, int32 Index, FText& OutText)
+    {
+        switch (lua_type(L, Index))
+        {
+        case LUA_TSTRING:
+            OutText = FText::FromString(UTF8_TO_TCHAR(lua_tostring(L, Index)));
+            return true;
+        case LUA_TUSERDATA:
+            {
+                const auto Text = GetTextInstance(L, Index);
+                if (!Text)
+                    return false;
+                OutText = *Text;
+                return true;
+            }
+        default:
+            return false;
+        }
+    }
+
+    static FFormatArgumentValue GetFormatArgument(lua_State* L, int32 Index)
+    {
+        switch (lua_type(L, Index))
+        {
+        case LUA_TNUMBER:
+            if (lua_isinteger(L, Index))
+                return FFormatArgumentValue((int64)lua_tointeger(L, Index));
+            return FFormatArgumentValue((double)lua_tonumber(L, Index));
+        case LUA_TBOOLEAN:
+            return FFormatArgumentValue(FText::FromString(lua_toboolean(L, Index) ? TEXT("true") : TEXT("false")));
+        default:
+            {
+                FText Text;
+                if (!GetText(L, Index, Text))
+                    luaL_error(L, "invalid format argument of type %s", luaL_typename(L, Index));
+                return FFormatArgumentValue(Text);
+            }
+        }
+    }
+
+    static FNumberFormattingOptions GetNumberFormattingOptions(lua_State* L, int32 Index)
+    {
+        FNumberFormattingOptions Options;
+        if (lua_isnumber(L, Index))
+            Options.SetMinimumFractionalDigits((int32)lua_tointeger(L, Index));
+        if (lua_isnumber(L, Index + 1))
+            Options.SetMaximumFractionalDigits((int32)lua_tointeger(L, Index + 1));
+        return Options;
+    }
+
     static int32 FText_ToString(lua_State* L)
     {
         const auto NumParams = lua_gettop(L);
         if (NumParams != 1)
             return luaL_error(L, "invalid parameters for __tostring");
 
-        const auto Text = (FText*)GetCppInstanceFast(L, 1);
+        const auto Text = GetTextInstance(L, 1);
         if (!Text)
         {
             lua_pushstring(L, "");
             return 1;
         }
 
-        lua_pushstring(L, TCHAR_TO_UTF8(*Text->ToString()));
+        PushDisplayString(L, 1, *Text);
+        return 1;
+    }
+
+    /**
+     * FText.Format(Pattern, {Name = Value, ...}) 使用命名参数
+     * FText.Format(Pattern, {Value1, Value2, ...}) 或 FText.Format(Pattern, Value1, Value2, ...) 使用顺序参数
+     */
+    static int32 FText_Format(lua_State* L)
+    {
+        FText Pattern;
+        if (!GetText(L, 1, Pattern))
+            return luaL_error(L, "invalid format pattern");
+
+        const auto NumParams = lua_gettop(L);
+        if (NumParams == 2 && lua_type(L, 2) == LUA_TTABLE)
+        {
+            const int32 Num = (int32)lua_rawlen(L, 2);
+            if (Num > 0)
+            {
+                FFormatOrderedArguments Arguments;
+                Arguments.Reserve(Num);
+                for (int32 i = 1; i <= Num; i++)
+                {
+                    lua_rawgeti(L, 2, i);
+                    Arguments.Add(GetFormatArgument(L, -1));
+                    lua_pop(L, 1);
+                }
+                PushText(L, FText::Format(FTextFormat(Pattern), MoveTemp(Arguments)));
+                return 1;
+            }
+
+            FFormatNamedArguments Arguments;
+            lua_pushnil(L);
+            while (lua_next(L, 2) != 0)
+            {
+                if (lua_type(L, -2) == LUA_TSTRING)
+                    Arguments.Add(UTF8_TO_TCHAR(lua_tostring(L, -2)), GetFormatArgument(L, -1));
+                lua_pop(L, 1);
+            }
+            PushText(L, FText::Format(FTextFormat(Pattern), MoveTemp(Arguments)));
+            return 1;
+        }
+
+        FFormatOrderedArguments Arguments;
+        Arguments.Reserve(NumParams - 1);
+        for (int32 i = 2; i <= NumParams; i++)
+            Arguments.Add(GetFormatArgument(L, i));
+        PushText(L, FText::Format(FTextFormat(Pattern), MoveTemp(Arguments)));
+        return 1;
+    }
+
+    /**
+     * FText.AsNumber(Value [, MinFractionalDigits, MaxFractionalDigits])
+     */
+    static int32 FText_AsNumber(lua_State* L)
+    {
+        const auto Options = GetNumberFormattingOptions(L, 2);
+        if (lua_isinteger(L, 1))
+            PushText(L, FText::AsNumber((int64)lua_tointeger(L, 1), &Options));
+        else
+            PushText(L, FText::AsNumber((double)luaL_checknumber(L, 1), &Options));
+        return 1;
+    }
+
+    /**
+     * FText.AsPercent(Value [, MinFractionalDigits, MaxFractionalDigits])，0.5显示为50%
+     */
+    static int32 FText_AsPercent(lua_State* L)
+    {
+        const auto Options = GetNumberFormattingOptions(L, 2);
+        PushText(L, FText::AsPercent((double)luaL_checknumber(L, 1), &Options));
+        return 1;
+    }
+
+    static int32 FText_AsCultureInvariant(lua_State* L)
+    {
+        PushText(L, FText::AsCultureInvariant(UTF8_TO_TCHAR(luaL_checkstring(L, 1))));
+        return 1;
+    }
+
+    static int32 FText_IsEmpty(lua_State* L)
+    {
+        FText Text;
+        lua_pushboolean(L, !GetText(L, 1, Text) || Text.IsEmpty());
+        return 1;
+    }
+
+    static int32 FText_IsEmptyOrWhitespace(lua_State* L)
+    {
+        FText Text;
+        lua_pushboolean(L, !GetText(L, 1, Text) || Text.IsEmptyOrWhitespace());
+        return 1;
+    }
+
+    static int32 FText_Compare(lua_State* L)
+    {
+        FText A, B;
+        if (!GetText(L, 1, A))
+            return luaL_error(L, "attempt to compare %s with FText", luaL_typename(L, 1));
+        if (!GetText(L, 2, B))
+            return luaL_error(L, "attempt to compare FText with %s", luaL_typename(L, 2));
+        return A.CompareTo(B);
+    }
+
+    static int32 FText_Eq(lua_State* L)
+    {
+        FText A, B;
+        lua_pushboolean(L, GetText(L, 1, A) && GetText(L, 2, B) && A.EqualTo(B));
+        return 1;
+    }
+
+    static int32 FText_Lt(lua_State* L)
+    {
+        lua_pushboolean(L, FText_Compare(L) < 0);
+        return 1;
+    }
+
+    static int32 FText_Le(lua_State* L)
+    {
+        lua_pushboolean(L, FText_Compare(L) <= 0);
         return 1;
     }
 
@@ -41,7 +270,7 @@ namespace UnLua
         if (NumParams != 1)
             return 0;
 
-        const auto Text = (FText*)GetCppInstanceFast(L, 1);
+        const auto Text = GetTextInstance(L, 1);
         if (!Text)
             return 0;
         Text->~FText();
@@ -52,6 +281,16 @@ namespace UnLua
     {
         {"__gc", FText_Delete},
         {"__tostring", FText_ToString},
+        {"__eq", FText_Eq},
+        {"__lt", FText_Lt},
+        {"__le", FText_Le},
+        {"ToString", FText_ToString},
+        {"Format", FText_Format},
+        {"AsNumber", FText_AsNumber},
+        {"AsPercent", FText_AsPercent},
+        {"AsCultureInvariant", FText_AsCultureInvariant},
+        {"IsEmpty", FText_IsEmpty},
+        {"IsEmptyOrWhitespace", FText_IsEmptyOrWhitespace},
         {nullptr, nullptr}
     };
 
@@ -78,7 +317,6 @@ namespace UnLua
     BEGIN_EXPORT_CLASS(FText)
         ADD_STATIC_FUNCTION(FromStringTable)
         ADD_STATIC_FUNCTION_EX("FromString", FText, FromString, const FString&)
-        ADD_FUNCTION(ToString)
         ADD_FUNCTION(IsNumeric)
         ADD_FUNCTION(CompareTo)
         ADD_FUNCTION(CompareToCaseIgnored)
@@ -15,6 +15,8 @@
 #include "UnLuaEx.h"
 #include "LuaCore.h"
 #include "LuaDynamicBinding.h"
+#include "LuaEnv.h"
+#include "SnapshotLib.h"
 #include "Engine/World.h"
 
 /**
@@ -161,6 +163,220 @@ static int32 UWorld_SpawnActorEx(lua_State* L)
     return 1;
 }
 
+/**
+ * 读取延迟创建的选项表 { Owner, Instigator, Level, Name, CollisionHandling, ModuleName, Fields }
+ */
+static void ReadDeferredSpawnOptions(lua_State* L, UWorld* World, int32 Index, FActorSpawnParameters& SpawnParameters, const char*& ModuleName, int32& FieldsIndex)
+{
+    SpawnParameters.bDeferConstruction = true;
+    ModuleName = nullptr;
+    FieldsIndex = 0;
+    if (lua_type(L, Index) != LUA_TTABLE)
+        return;
+
+    if (lua_getfield(L, Index, "CollisionHandling") == LUA_TNUMBER)
+        SpawnParameters.SpawnCollisionHandlingOverride = (ESpawnActorCollisionHandlingMethod)lua_tointeger(L, -1);
+    lua_pop(L, 1);
+
+    if (lua_getfield(L, Index, "Owner") != LUA_TNIL)
+    {
+        AActor* Owner = Cast<AActor>(UnLua::GetUObject(L, -1));
+        check(!Owner || (Owner && World == Owner->GetWorld()));
+        SpawnParameters.Owner = Owner;
+    }
+    lua_pop(L, 1);
+
+    if (lua_getfield(L, Index, "Instigator") != LUA_TNIL)
+    {
+        AActor* Actor = Cast<AActor>(UnLua::GetUObject(L, -1));
+        if (Actor)
+        {
+            APawn* Instigator = Cast<APawn>(Actor);
+            SpawnParameters.Instigator = Instigator ? Instigator : Actor->GetInstigator();
+        }
+    }
+    lua_pop(L, 1);
+
+    if (lua_getfield(L, Index, "Level") != LUA_TNIL)
+    {
+        ULevel* Level = Cast<ULevel>(UnLua::GetUObject(L, -1));
+        if (Level)
+            SpawnParameters.OverrideLevel = Level;
+    }
+    lua_pop(L, 1);
+
+    if (lua_getfield(L, Index, "Name") == LUA_TSTRING)
+        SpawnParameters.Name = FName(lua_tostring(L, -1));
+    lua_pop(L, 1);
+
+    // 字符串仍被选项表引用，弹出后指针依然有效
+    if (lua_getfield(L, Index, "ModuleName") == LUA_TSTRING)
+        ModuleName = lua_tostring(L, -1);
+    lua_pop(L, 1);
+
+    // 字段表留在栈上，由调用者负责清理
+    if (lua_getfield(L, Index, "Fields") == LUA_TTABLE)
+        FieldsIndex = lua_gettop(L);
+    else
+        lua_pop(L, 1);
+}
+
+/**
+ * 在保护模式下写入属性表，参数为 ClassDesc, Actor, Properties, Fields
+ */
+static int32 ApplyDeferredValues(lua_State* L)
+{
+    const auto ClassDesc = (FClassDesc*)lua_touserdata(L, 1);
+    const auto Actor = (AActor*)lua_touserdata(L, 2);
+    UnLua::SnapshotLib::ApplyValues(L, ClassDesc, Actor, 3, lua_isnil(L, 4) ? 0 : 4);
+    return 0;
+}
+
+/**
+ * 延迟创建Actor，在FinishSpawning之前把属性表写入Actor，属性表不需要注册到Lua注册表。
+ * 写入出错时销毁这个还没有完成构造的Actor，再抛出错误。
+ */
+static AActor* SpawnActorDeferred(lua_State* L, UWorld* World, UClass* Class, FClassDesc* ClassDesc, const FTransform& Transform,
+                                  const FActorSpawnParameters& SpawnParameters, const TCHAR* ModuleName, int32 PropertiesIndex, int32 FieldsIndex)
+{
+    AActor* NewActor;
+    {
+        FScopedLuaDynamicBinding Binding(L, Class, ModuleName, LUA_NOREF);
+        NewActor = World->SpawnActor(Class, &Transform, SpawnParameters);
+    }
+    if (!NewActor)
+        return nullptr;
+
+    if (lua_type(L, PropertiesIndex) == LUA_TTABLE)
+    {
+        lua_pushcfunction(L, ApplyDeferredValues);
+        lua_pushlightuserdata(L, ClassDesc);
+        lua_pushlightuserdata(L, NewActor);
+        lua_pushvalue(L, PropertiesIndex);
+        if (FieldsIndex != 0)
+            lua_pushvalue(L, FieldsIndex);
+        else
+            lua_pushnil(L);
+        if (lua_pcall(L, 4, 0, 0) != LUA_OK)
+        {
+            NewActor->Destroy();
+            lua_error(L);
+            return nullptr;
+        }
+    }
+
+    NewActor->FinishSpawning(Transform);
+    return NewActor;
+}
+
+/**
+ * World:SpawnActorDeferred(ActorClass, InitialTransform, Properties, Options)
+ * Properties为属性名到值的表，在FinishSpawning之前写入，构造脚本和BeginPlay可以看到这些值。
+ * Options为可选的表 { Owner, Instigator, Level, Name, CollisionHandling, ModuleName, Fields }，
+ * 指定Fields（属性名数组）时只写这些属性，并按类缓存解析结果。
+ */
+static int32 UWorld_SpawnActorDeferred(lua_State* L)
+{
+    int32 NumParams = lua_gettop(L);
+    if (NumParams < 2)
+        return luaL_error(L, "invalid parameters");
+
+    UWorld* World = Cast<UWorld>(UnLua::GetUObject(L, 1));
+    if (!World)
+        return luaL_error(L, "invalid world");
+
+    UClass* Class = Cast<UClass>(UnLua::GetUObject(L, 2));
+    if (!Class || !Class->IsChildOf(AActor::StaticClass()))
+        return luaL_error(L, "invalid actor class");
+
+    FTransform Transform;
+    if (NumParams > 2)
+    {
+        FTransform* TransformPtr = (FTransform*)GetCppInstanceFast(L, 3);
+        if (TransformPtr)
+        {
+            Transform = *TransformPtr;
+        }
+    }
+
+    lua_settop(L, 5);
+    FActorSpawnParameters SpawnParameters;
+    const char* ModuleName;
+    int32 FieldsIndex;
+    ReadDeferredSpawnOptions(L, World, 5, SpawnParameters, ModuleName, FieldsIndex);
+
+    FClassDesc* ClassDesc = UnLua::FLuaEnv::FindEnvChecked(L).GetClassRegistry()->Register(Class);
+    AActor* NewActor = SpawnActorDeferred(L, World, Class, ClassDesc, Transform, SpawnParameters, ModuleName ? UTF8_TO_TCHAR(ModuleName) : nullptr, 4, FieldsIndex);
+    UnLua::PushUObject(L, NewActor);
+    return 1;
+}
+
+/**
+ * World:SpawnActors(ActorClass, Transforms, Properties, Options)
+ * 一次调用批量创建同一类型的Actor，Transforms为FTransform数组，返回Actor数组（创建失败的位置为nil）。
+ * Properties为所有Actor共用的属性表，或者与Transforms一一对应的属性表数组。Options同SpawnActorDeferred，忽略Name。
+ */
+static int32 UWorld_SpawnActors(lua_State* L)
+{
+    int32 NumParams = lua_gettop(L);
+    if (NumParams < 3)
+        return luaL_error(L, "invalid parameters");
+
+    UWorld* World = Cast<UWorld>(UnLua::GetUObject(L, 1));
+    if (!World)
+        return luaL_error(L, "invalid world");
+
+    UClass* Class = Cast<UClass>(UnLua::GetUObject(L, 2));
+    if (!Class || !Class->IsChildOf(AActor::StaticClass()))
+        return luaL_error(L, "invalid actor class");
+
+    luaL_checktype(L, 3, LUA_TTABLE);
+    const int32 Num = (int32)lua_rawlen(L, 3);
+
+    lua_settop(L, 5);
+    FActorSpawnParameters SpawnParameters;
+    const char* ModuleName;
+    int32 FieldsIndex;
+    ReadDeferredSpawnOptions(L, World, 5, SpawnParameters, ModuleName, FieldsIndex);
+    SpawnParameters.Name = NAME_None;
+
+    bool bPerActorProperties = false;
+    if (lua_type(L, 4) == LUA_TTABLE)
+    {
+        bPerActorProperties = lua_rawgeti(L, 4, 1) == LUA_TTABLE;
+        lua_pop(L, 1);
+    }
+
+    const FUTF8ToTCHAR ModuleNameTCHAR(ModuleName ? ModuleName : "");
+    FClassDesc* ClassDesc = UnLua::FLuaEnv::FindEnvChecked(L).GetClassRegistry()->Register(Class);
+
+    lua_createtable(L, Num, 0);
+    const int32 ResultIndex = lua_gettop(L);
+    for (int32 i = 1; i <= Num; ++i)
+    {
+        lua_rawgeti(L, 3, i);
+        FTransform* TransformPtr = (FTransform*)GetCppInstanceFast(L, -1);
+        const FTransform Transform = TransformPtr ? *TransformPtr : FTransform::Identity;
+        lua_pop(L, 1);
+
+        int32 PropertiesIndex = 4;
+        if (bPerActorProperties)
+        {
+            lua_rawgeti(L, 4, i);
+            PropertiesIndex = lua_gettop(L);
+        }
+
+        AActor* NewActor = SpawnActorDeferred(L, World, Class, ClassDesc, Transform, SpawnParameters, ModuleName ? ModuleNameTCHAR.Get() : nullptr, PropertiesIndex, FieldsIndex);
+        if (bPerActorProperties)
+            lua_pop(L, 1);
+
+        UnLua::PushUObject(L, NewActor);
+        lua_rawseti(L, ResultIndex, i);
+    }
+
+    return 1;
+}
+
 DEFINE_TYPE(ESpawnActorCollisionHandlingMethod)
 
 DEFINE_TYPE(EObjectFlags)
@@ -202,6 +418,8 @@ static const luaL_Reg UWorldLib[] =
 {
     {"SpawnActor", UWorld_SpawnActor},
     {"SpawnActorEx", UWorld_SpawnActorEx},
+    {"SpawnActorDeferred", UWorld_SpawnActorDeferred},
+    {"SpawnActors", UWorld_SpawnActors},
     {nullptr, nullptr}
 };
 
@@ -0,0 +1,78 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "CallStats.h"
+#include "UnLuaBase.h"
+
+namespace UnLua
+{
+    bool FCallStats::bEnabled = false;
+
+    static TSet<FCallStats*>& GetAllStats()
+    {
+        static TSet<FCallStats*> AllStats;
+        return AllStats;
+    }
+
+    FCallStats::~FCallStats()
+    {
+        if (IsRegistered())
+            GetAllStats().Remove(this);
+    }
+
+    void FCallStats::Start()
+    {
+        for (const auto Stats : GetAllStats())
+        {
+            Stats->Calls = 0;
+            Stats->TotalCycles = 0;
+            Stats->CalleeCycles = 0;
+        }
+        bEnabled = true;
+    }
+
+    void FCallStats::Stop()
+    {
+        bEnabled = false;
+    }
+
+    void FCallStats::Dump(int32 Count)
+    {
+        TArray<const FCallStats*> Sorted;
+        Sorted.Reserve(GetAllStats().Num());
+        for (const auto Stats : GetAllStats())
+        {
+            if (Stats->Calls > 0)
+                Sorted.Add(Stats);
+        }
+        Sorted.Sort([](const FCallStats& A, const FCallStats& B) { return A.TotalCycles > B.TotalCycles; });
+
+        UE_LOG(LogUnLua, Log, TEXT("%-8s %10s %12s %10s %12s %12s  %s"), TEXT("Kind"), TEXT("Calls"), TEXT("Total(ms)"), TEXT("Avg(us)"), TEXT("Callee(ms)"), TEXT("Marshal(ms)"), TEXT("Name"));
+        for (int32 i = 0; i < Sorted.Num() && (Count <= 0 || i < Count); i++)
+        {
+            const auto& Stats = *Sorted[i];
+            const double Total = FPlatformTime::ToMilliseconds64(Stats.TotalCycles);
+            const double Callee = FPlatformTime::ToMilliseconds64(Stats.CalleeCycles);
+            UE_LOG(LogUnLua, Log, TEXT("%-8s %10llu %12.3f %10.3f %12.3f %12.3f  %s"), Stats.Kind, Stats.Calls, Total, Total * 1000.0 / Stats.Calls, Callee, Total - Callee, *Stats.Name);
+        }
+    }
+
+    void FCallStats::Register(const TCHAR* InKind, const FString& InName)
+    {
+        Kind = InKind;
+        Name = InName;
+        GetAllStats().Add(this);
+    }
+}
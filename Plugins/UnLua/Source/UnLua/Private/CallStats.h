@@ -0,0 +1,69 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace UnLua
+{
+    /**
+     * 一个调用入口的调用次数与耗时，lua.stats.start之后才会记录
+     *
+     * TotalCycles包含参数转换，CalleeCycles只包含被调用的Lua函数或UFunction本身
+     */
+    class FCallStats
+    {
+    public:
+        FCallStats() = default;
+
+        FCallStats(const FCallStats&) = delete;
+
+        FCallStats& operator=(const FCallStats&) = delete;
+
+        ~FCallStats();
+
+        FORCEINLINE static bool IsEnabled() { return bEnabled; }
+
+        /* 清空已有的记录并开始记录 */
+        static void Start();
+
+        static void Stop();
+
+        /* 按总耗时从高到低输出前Count项 */
+        static void Dump(int32 Count);
+
+        FORCEINLINE bool IsRegistered() const { return Kind != nullptr; }
+
+        /* 第一次记录时登记名字，之后的调用不再格式化字符串 */
+        void Register(const TCHAR* InKind, const FString& InName);
+
+        FORCEINLINE void Record(uint64 Total, uint64 Callee)
+        {
+            Calls++;
+            TotalCycles += Total;
+            CalleeCycles += Callee;
+        }
+
+    private:
+        static bool bEnabled;
+
+        const TCHAR* Kind = nullptr;
+        FString Name;
+        uint64 Calls = 0;
+        uint64 TotalCycles = 0;
+        uint64 CalleeCycles = 0;
+    };
+}
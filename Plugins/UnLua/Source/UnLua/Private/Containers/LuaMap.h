@@ -124,10 +124,25 @@ public:
     {
         //MapHelper.AddPair(Key, Value);
         const UnLua::ITypeInterface *LocalKeyInterface = KeyInterface.Get();
-        const UnLua::ITypeInterface *LocalValueInterface = ValueInterface.Get();
-        Map->Add(Key, Value, MapLayout,
+        Add(Key, Value,
             [LocalKeyInterface](const void* ElementKey) { return LocalKeyInterface->GetValueTypeHash(ElementKey); },
-            [LocalKeyInterface](const void* A, const void* B) { return LocalKeyInterface->Identical(A, B); },
+            [LocalKeyInterface](const void* A, const void* B) { return LocalKeyInterface->Identical(A, B); });
+    }
+
+    /**
+     * Add a pair to the map with custom hash/equality functions
+     *
+     * @param Key - the key, must have the same memory layout as the map's keys
+     * @param Value - the value
+     * @param GetKeyHash - must produce the same hash as the key interface
+     * @param KeyEquality - compares two keys
+     */
+    template <typename HashFuncType, typename EqualityFuncType>
+    FORCEINLINE void Add(const void *Key, const void *Value, HashFuncType GetKeyHash, EqualityFuncType KeyEquality)
+    {
+        const UnLua::ITypeInterface *LocalKeyInterface = KeyInterface.Get();
+        const UnLua::ITypeInterface *LocalValueInterface = ValueInterface.Get();
+        Map->Add(Key, Value, MapLayout, GetKeyHash, KeyEquality,
             [LocalKeyInterface, Key](void* NewElementKey)
             {
                 LocalKeyInterface->Initialize(NewElementKey);
@@ -168,10 +183,20 @@ public:
     {
         //return MapHelper.RemovePair(Key);
         const UnLua::ITypeInterface *LocalKeyInterface = KeyInterface.Get();
-        if (uint8* Entry = Map->FindValue(Key, MapLayout,
+        return Remove(Key,
             [LocalKeyInterface](const void* ElementKey) { return LocalKeyInterface->GetValueTypeHash(ElementKey); },
-            [LocalKeyInterface](const void* A, const void* B) { return LocalKeyInterface->Identical(A, B); }
-        ))
+            [LocalKeyInterface](const void* A, const void* B) { return LocalKeyInterface->Identical(A, B); });
+    }
+
+    /**
+     * Remove a pair from the map with custom hash/equality functions
+     *
+     * @param Key - the key, only passed to GetKeyHash and as the first argument of KeyEquality
+     */
+    template <typename HashFuncType, typename EqualityFuncType>
+    FORCEINLINE bool Remove(const void *Key, HashFuncType GetKeyHash, EqualityFuncType KeyEquality)
+    {
+        if (uint8* Entry = Map->FindValue(Key, MapLayout, GetKeyHash, KeyEquality))
         {
             int32 Idx = (Entry - (uint8*)Map->GetData(0, MapLayout)) / MapLayout.SetLayout.Size;
             DestructItems(Idx, 1);
@@ -228,6 +253,18 @@ public:
         );
     }
 
+    /**
+     * Find the associated value of a Key from the map with custom hash/equality functions
+     *
+     * @param Key - the key, only passed to GetKeyHash and as the first argument of KeyEquality
+     * @return - the address of the associated value
+     */
+    template <typename HashFuncType, typename EqualityFuncType>
+    FORCEINLINE void* Find(const void *Key, HashFuncType GetKeyHash, EqualityFuncType KeyEquality)
+    {
+        return Map->FindValue(Key, MapLayout, GetKeyHash, KeyEquality);
+    }
+
     /**
      * Empty the map, and reallocate it for the expected number of pairs.
      *
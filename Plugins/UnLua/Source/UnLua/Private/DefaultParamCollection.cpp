@@ -13,30 +13,103 @@
 // See the License for the specific language governing permissions and limitations under the License.
 
 #include "DefaultParamCollection.h"
-#include "Misc/EngineVersionComparison.h"
 #include "CoreUObject.h"
+#include "Algo/BinarySearch.h"
 
-TMap<FName, FFunctionCollection> GDefaultParamCollection;
+namespace
+{
+    /**
+     * 由UnLuaDefaultParamCollector生成，只包含常量数据，最后一项是结尾占位
+     */
+    const FDefaultParamEntry GDefaultParamEntries[] =
+    {
+#include "DefaultParamCollection.inl"
+        {0, nullptr, nullptr, nullptr, EDefaultParamType::Bool, {}, nullptr}
+    };
+
+    constexpr int32 GNumDefaultParamEntries = UE_ARRAY_COUNT(GDefaultParamEntries) - 1;
 
-#if UE_VERSION_OLDER_THAN(5, 2, 0)
-PRAGMA_DISABLE_OPTIMIZATION
-#else
-UE_DISABLE_OPTIMIZATION
-#endif
+    IParamValue* CreateParamValue(const FDefaultParamEntry& Entry)
+    {
+        const double* V = Entry.Values;
+        switch (Entry.Type)
+        {
+        case EDefaultParamType::Bool:
+            return new FBoolParamValue(V[0] != 0);
+        case EDefaultParamType::Byte:
+            return new FByteParamValue((uint8)V[0]);
+        case EDefaultParamType::Int:
+            return new FIntParamValue((int32)V[0]);
+        case EDefaultParamType::Enum:
+            return new FEnumParamValue((int64)V[0]);
+        case EDefaultParamType::RuntimeEnum:
+            return new FRuntimeEnumParamValue(Entry.String, (int32)V[0]);
+        case EDefaultParamType::Float:
+            return new FFloatParamValue((float)V[0]);
+        case EDefaultParamType::Double:
+            return new FDoubleParamValue(V[0]);
+        case EDefaultParamType::Name:
+            return new FNameParamValue(FName(Entry.String));
+        case EDefaultParamType::Text:
+            return new FTextParamValue(FText::FromString(Entry.String));
+        case EDefaultParamType::InvariantText:
+            return new FTextParamValue(FText::AsCultureInvariant(Entry.String));
+        case EDefaultParamType::String:
+            return new FStringParamValue(Entry.String);
+        case EDefaultParamType::Vector:
+            return new FVectorParamValue(FVector(V[0], V[1], V[2]));
+        case EDefaultParamType::Vector2D:
+            return new FVector2DParamValue(FVector2D(V[0], V[1]));
+        case EDefaultParamType::Rotator:
+            return new FRotatorParamValue(FRotator(V[0], V[1], V[2]));
+        case EDefaultParamType::LinearColor:
+            return new FLinearColorParamValue(FLinearColor((float)V[0], (float)V[1], (float)V[2], (float)V[3]));
+        case EDefaultParamType::Color:
+            return new FColorParamValue(FColor((uint8)V[0], (uint8)V[1], (uint8)V[2], (uint8)V[3]));
+        case EDefaultParamType::ScriptArray:
+            return new FScriptArrayParamValue();
+        case EDefaultParamType::ScriptDelegate:
+            return new FScriptDelegateParamValue(FScriptDelegate());
+        case EDefaultParamType::MulticastScriptDelegate:
+            return new FMulticastScriptDelegateParamValue(FMulticastScriptDelegate());
+        default:
+            checkNoEntry();
+            return nullptr;
+        }
+    }
+}
 
-void CreateDefaultParamCollection()
+FParameterCollection* FindDefaultParamCollection(const FString& ClassName, FName FunctionName)
 {
-    static bool CollectionCreated = false;
-    if (!CollectionCreated)
+    if (GNumDefaultParamEntries == 0)
+        return nullptr;
+
+    const FString FunctionNameStr = FunctionName.ToString();
+    const uint32 Hash = HashDefaultParamFunction(*ClassName, *FunctionNameStr);
+    const TArrayView<const FDefaultParamEntry> Entries(GDefaultParamEntries, GNumDefaultParamEntries);
+    int32 First = Algo::LowerBoundBy(Entries, Hash, &FDefaultParamEntry::FunctionHash);
+
+    // 哈希冲突时同一个哈希下可能有多个函数，用名字找到属于这个函数的连续条目
+    while (First < Entries.Num() && Entries[First].FunctionHash == Hash
+        && (ClassName != Entries[First].ClassName || FunctionNameStr != Entries[First].FunctionName))
     {
-        CollectionCreated = true;
+        ++First;
+    }
+    if (First == Entries.Num() || Entries[First].FunctionHash != Hash)
+        return nullptr;
 
-#include "DefaultParamCollection.inl"
+    // 构造出来的集合常驻，供所有Env的FFunctionDesc共享
+    static TMap<int32, FParameterCollection*> Collections;
+    FParameterCollection*& Collection = Collections.FindOrAdd(First);
+    if (!Collection)
+    {
+        Collection = new FParameterCollection();
+        for (int32 i = First; i < Entries.Num() && Entries[i].FunctionHash == Hash; ++i)
+        {
+            const FDefaultParamEntry& Entry = Entries[i];
+            if (ClassName == Entry.ClassName && FunctionNameStr == Entry.FunctionName)
+                Collection->Parameters.Add(Entry.ParamName, CreateParamValue(Entry));
+        }
     }
+    return Collection;
 }
-
-#if UE_VERSION_OLDER_THAN(5, 2, 0)
-PRAGMA_ENABLE_OPTIMIZATION
-#else
-UE_ENABLE_OPTIMIZATION
-#endif
@@ -103,11 +103,64 @@ struct FParameterCollection
     TMap<FName, IParamValue*> Parameters;
 };
 
-struct FFunctionCollection
+enum class EDefaultParamType : uint8
 {
-    TMap<FName, FParameterCollection> Functions;
+    Bool,
+    Byte,
+    Int,
+    Enum,
+    RuntimeEnum,
+    Float,
+    Double,
+    Name,
+    Text,
+    InvariantText,
+    String,
+    Vector,
+    Vector2D,
+    Rotator,
+    LinearColor,
+    Color,
+    ScriptArray,
+    ScriptDelegate,
+    MulticastScriptDelegate,
 };
 
-extern TMap<FName, FFunctionCollection> GDefaultParamCollection;
+/**
+ * DefaultParamCollection.inl中的常量条目，整张表按FunctionHash升序排列
+ */
+struct FDefaultParamEntry
+{
+    uint32 FunctionHash;        // HashDefaultParamFunction(ClassName, FunctionName)
+    const TCHAR* ClassName;
+    const TCHAR* FunctionName;
+    const TCHAR* ParamName;
+    EDefaultParamType Type;
+    double Values[4];           // 数值/向量/颜色的分量，RuntimeEnum为枚举下标
+    const TCHAR* String;        // Name/Text/String的值，RuntimeEnum为枚举的C++类型名
+};
 
-extern void CreateDefaultParamCollection();
+/**
+ * 对"ClassName.FunctionName"做FNV-1a，需要与UnLuaDefaultParamCollector中的实现保持一致
+ */
+inline uint32 HashDefaultParamFunction(const TCHAR* ClassName, const TCHAR* FunctionName)
+{
+    uint32 Hash = 2166136261u;
+    auto Accumulate = [&Hash](const TCHAR* Str)
+    {
+        for (; *Str; ++Str)
+        {
+            Hash ^= (uint32)*Str;
+            Hash *= 16777619u;
+        }
+    };
+    Accumulate(ClassName);
+    Accumulate(TEXT("."));
+    Accumulate(FunctionName);
+    return Hash;
+}
+
+/**
+ * 查找函数的默认参数，首次查找时才从常量表构造，没有默认参数时返回nullptr
+ */
+extern FParameterCollection* FindDefaultParamCollection(const FString& ClassName, FName FunctionName);
@@ -0,0 +1,380 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "HeapSnapshot.h"
+#include "Misc/FileHelper.h"
+#include "UnLuaBase.h"
+
+#ifdef __cplusplus
+#if !LUA_COMPILE_AS_CPP
+extern "C" {
+#endif
+#endif
+
+#include "lfunc.h"
+#include "lstate.h"
+#include "lobject.h"
+
+#ifdef __cplusplus
+#if !LUA_COMPILE_AS_CPP
+}
+#endif
+#endif
+
+namespace UnLua
+{
+    static const char* OBJECT_MAP_KEY = "UnLua_ObjectMap";
+
+    /**
+     * 广度优先遍历，待遍历的对象暂存在栈上的一张队列表里，避免递归过深
+     */
+    struct FHeapWalker
+    {
+        FHeapWalker(lua_State* InL, FHeapSnapshot& InSnapshot)
+            : L(InL), Snapshot(InSnapshot)
+        {
+            lua_newtable(L);
+            QueueIndex = lua_gettop(L);
+            Visited.Add(lua_topointer(L, QueueIndex));
+        }
+
+        void Walk(int32 Index, const FString& Root)
+        {
+            Current = &Snapshot.Roots.FindOrAdd(Root);
+            Visit(Index);
+            while (QueueHead < QueueTail)
+            {
+                lua_rawgeti(L, QueueIndex, ++QueueHead);
+                Traverse(lua_gettop(L));
+                lua_pop(L, 1);
+            }
+            QueueHead = QueueTail = 0;
+        }
+
+    private:
+        void Visit(int32 Index)
+        {
+            Index = lua_absindex(L, Index);
+            const int32 Type = lua_type(L, Index);
+            if (Type != LUA_TSTRING && Type != LUA_TTABLE && Type != LUA_TFUNCTION && Type != LUA_TUSERDATA && Type != LUA_TTHREAD)
+                return;
+
+            // 轻量C函数不是GC对象
+            if (Type == LUA_TFUNCTION && lua_iscfunction(L, Index))
+            {
+                if (!lua_getupvalue(L, Index, 1))
+                    return;
+                lua_pop(L, 1);
+            }
+
+            const void* Ptr = lua_topointer(L, Index);
+            bool bVisited;
+            Visited.Add(Ptr, &bVisited);
+            if (bVisited)
+                return;
+
+            const char* TypeName = lua_typename(L, Type);
+            FString UserdataName;
+            int64 Bytes = 0;
+            switch (Type)
+            {
+            case LUA_TSTRING:
+                Bytes = sizeof(TString) + lua_rawlen(L, Index) + 1;
+                break;
+            case LUA_TTABLE:
+                {
+                    const Table* T = (const Table*)Ptr;
+                    Bytes = sizeof(Table) + (int64)T->alimit * sizeof(TValue);
+                    if (T->lastfree)
+                        Bytes += (int64)sizenode(T) * sizeof(Node);
+                    break;
+                }
+            case LUA_TFUNCTION:
+                {
+                    const int32 NumUpvalues = CountUpvalues(Index);
+                    if (lua_iscfunction(L, Index))
+                    {
+                        Bytes = sizeCclosure(NumUpvalues);
+                    }
+                    else
+                    {
+                        Bytes = sizeLclosure(NumUpvalues);
+                        Bytes += GetProtoSize(((const LClosure*)Ptr)->p);
+                    }
+                    break;
+                }
+            case LUA_TUSERDATA:
+                {
+                    int32 NumUservalues = 0;
+                    while (lua_getiuservalue(L, Index, NumUservalues + 1) != LUA_TNONE)
+                    {
+                        lua_pop(L, 1);
+                        ++NumUservalues;
+                    }
+                    lua_pop(L, 1);
+                    Bytes = sizeudata(NumUservalues, lua_rawlen(L, Index));
+
+                    if (lua_getmetatable(L, Index))
+                    {
+                        if (lua_getfield(L, -1, "__name") == LUA_TSTRING)
+                            UserdataName = FString::Printf(TEXT("userdata:%s"), UTF8_TO_TCHAR(lua_tostring(L, -1)));
+                        lua_pop(L, 2);
+                    }
+                    break;
+                }
+            case LUA_TTHREAD:
+                {
+                    const lua_State* Thread = lua_tothread(L, Index);
+                    Bytes = sizeof(lua_State) + (int64)stacksize(Thread) * sizeof(StackValue);
+                    break;
+                }
+            default:
+                break;
+            }
+
+            Current->Count++;
+            Current->Bytes += Bytes;
+            auto& TypeEntry = Snapshot.Types.FindOrAdd(UserdataName.IsEmpty() ? FString(UTF8_TO_TCHAR(TypeName)) : UserdataName);
+            TypeEntry.Count++;
+            TypeEntry.Bytes += Bytes;
+            Snapshot.TotalBytes += Bytes;
+
+            if (Type == LUA_TSTRING)
+                return;
+            lua_pushvalue(L, Index);
+            lua_rawseti(L, QueueIndex, ++QueueTail);
+        }
+
+        void Traverse(int32 Index)
+        {
+            luaL_checkstack(L, 4, "heap snapshot");
+            switch (lua_type(L, Index))
+            {
+            case LUA_TTABLE:
+                VisitMetatable(Index);
+                lua_pushnil(L);
+                while (lua_next(L, Index) != 0)
+                {
+                    Visit(-2);
+                    Visit(-1);
+                    lua_pop(L, 1);
+                }
+                break;
+            case LUA_TFUNCTION:
+                for (int32 i = 1; lua_getupvalue(L, Index, i); i++)
+                {
+                    Visit(-1);
+                    lua_pop(L, 1);
+                }
+                break;
+            case LUA_TUSERDATA:
+                VisitMetatable(Index);
+                for (int32 i = 1; lua_getiuservalue(L, Index, i) != LUA_TNONE; i++)
+                {
+                    Visit(-1);
+                    lua_pop(L, 1);
+                }
+                lua_pop(L, 1);
+                break;
+            case LUA_TTHREAD:
+                {
+                    // 正在执行快照的线程栈上是快照自己的临时数据
+                    lua_State* Thread = lua_tothread(L, Index);
+                    if (Thread == L)
+                        break;
+                    const int32 Top = lua_gettop(Thread);
+                    for (int32 i = 1; i <= Top && lua_checkstack(Thread, 1); i++)
+                    {
+                        lua_pushvalue(Thread, i);
+                        lua_xmove(Thread, L, 1);
+                        Visit(-1);
+                        lua_pop(L, 1);
+                    }
+                    break;
+                }
+            default:
+                break;
+            }
+        }
+
+        void VisitMetatable(int32 Index)
+        {
+            if (lua_getmetatable(L, Index))
+            {
+                Visit(-1);
+                lua_pop(L, 1);
+            }
+        }
+
+        int32 CountUpvalues(int32 Index)
+        {
+            int32 Num = 0;
+            while (lua_getupvalue(L, Index, Num + 1))
+            {
+                lua_pop(L, 1);
+                ++Num;
+            }
+            return Num;
+        }
+
+        /* 函数原型可能被多个闭包共享，只计一次 */
+        int64 GetProtoSize(const Proto* P)
+        {
+            bool bVisited;
+            Visited.Add(P, &bVisited);
+            if (bVisited)
+                return 0;
+
+            int64 Bytes = sizeof(Proto)
+                + (int64)P->sizecode * sizeof(Instruction)
+                + (int64)P->sizek * sizeof(TValue)
+                + (int64)P->sizep * sizeof(Proto*)
+                + (int64)P->sizeupvalues * sizeof(Upvaldesc)
+                + (int64)P->sizelineinfo * sizeof(ls_byte)
+                + (int64)P->sizeabslineinfo * sizeof(AbsLineInfo)
+                + (int64)P->sizelocvars * sizeof(LocVar);
+            for (int32 i = 0; i < P->sizep; i++)
+                Bytes += GetProtoSize(P->p[i]);
+            return Bytes;
+        }
+
+        lua_State* L;
+        FHeapSnapshot& Snapshot;
+        FHeapSnapshot::FEntry* Current = nullptr;
+        TSet<const void*> Visited;
+        int32 QueueIndex;
+        int32 QueueHead = 0;
+        int32 QueueTail = 0;
+    };
+
+    FHeapSnapshot FHeapSnapshot::Capture(lua_State* L)
+    {
+        FHeapSnapshot Snapshot;
+        const int32 Top = lua_gettop(L);
+        luaL_checkstack(L, 8, "heap snapshot");
+        FHeapWalker Walker(L, Snapshot);
+
+        // 模块优先，绑定对象的实例表以模块为元表，先遍历模块才能把模块本身归到模块名下
+        lua_getfield(L, LUA_REGISTRYINDEX, LUA_LOADED_TABLE);
+        const int32 LoadedIndex = lua_gettop(L);
+        TArray<FString> ModuleNames;
+        lua_pushnil(L);
+        while (lua_next(L, LoadedIndex) != 0)
+        {
+            if (lua_type(L, -2) == LUA_TSTRING)
+                ModuleNames.Add(UTF8_TO_TCHAR(lua_tostring(L, -2)));
+            lua_pop(L, 1);
+        }
+        ModuleNames.Remove(TEXT("_G"));
+        ModuleNames.Sort();
+        for (const auto& Name : ModuleNames)
+        {
+            lua_getfield(L, LoadedIndex, TCHAR_TO_UTF8(*Name));
+            Walker.Walk(-1, TEXT("module:") + Name);
+            lua_pop(L, 1);
+        }
+        lua_pop(L, 1);
+
+        if (lua_getfield(L, LUA_REGISTRYINDEX, OBJECT_MAP_KEY) == LUA_TTABLE)
+        {
+            const int32 ObjectMapIndex = lua_gettop(L);
+            lua_pushnil(L);
+            while (lua_next(L, ObjectMapIndex) != 0)
+            {
+                const auto Object = (UObject*)lua_touserdata(L, -2);
+                const FString ClassName = Object && IsUObjectValid(Object) ? Object->GetClass()->GetName() : TEXT("Invalid");
+                Walker.Walk(-1, TEXT("object:") + ClassName);
+                lua_pop(L, 1);
+            }
+        }
+        lua_pop(L, 1);
+
+        lua_rawgeti(L, LUA_REGISTRYINDEX, LUA_RIDX_GLOBALS);
+        Walker.Walk(-1, TEXT("global"));
+        lua_pop(L, 1);
+
+        lua_pushvalue(L, LUA_REGISTRYINDEX);
+        Walker.Walk(-1, TEXT("registry"));
+        lua_settop(L, Top);
+
+        for (auto It = Snapshot.Roots.CreateIterator(); It; ++It)
+        {
+            if (It.Value().Count == 0)
+                It.RemoveCurrent();
+        }
+        return Snapshot;
+    }
+
+    static void DiffEntries(const TMap<FString, FHeapSnapshot::FEntry>& Old, const TMap<FString, FHeapSnapshot::FEntry>& New, TMap<FString, FHeapSnapshot::FEntry>& Out)
+    {
+        for (const auto& Pair : New)
+        {
+            const auto OldEntry = Old.Find(Pair.Key);
+            FHeapSnapshot::FEntry Entry;
+            Entry.Count = Pair.Value.Count - (OldEntry ? OldEntry->Count : 0);
+            Entry.Bytes = Pair.Value.Bytes - (OldEntry ? OldEntry->Bytes : 0);
+            if (Entry.Count != 0 || Entry.Bytes != 0)
+                Out.Add(Pair.Key, Entry);
+        }
+        for (const auto& Pair : Old)
+        {
+            if (New.Contains(Pair.Key))
+                continue;
+            FHeapSnapshot::FEntry Entry;
+            Entry.Count = -Pair.Value.Count;
+            Entry.Bytes = -Pair.Value.Bytes;
+            Out.Add(Pair.Key, Entry);
+        }
+    }
+
+    FHeapSnapshot FHeapSnapshot::Diff(const FHeapSnapshot& Old, const FHeapSnapshot& New)
+    {
+        FHeapSnapshot Result;
+        DiffEntries(Old.Roots, New.Roots, Result.Roots);
+        DiffEntries(Old.Types, New.Types, Result.Types);
+        Result.TotalBytes = New.TotalBytes - Old.TotalBytes;
+        return Result;
+    }
+
+    static void AppendEntries(FString& Out, const TCHAR* Title, const TMap<FString, FHeapSnapshot::FEntry>& Entries, int32 Count)
+    {
+        TArray<TPair<FString, FHeapSnapshot::FEntry>> Sorted;
+        Sorted.Reserve(Entries.Num());
+        for (const auto& Pair : Entries)
+            Sorted.Emplace(Pair.Key, Pair.Value);
+        Sorted.Sort([](const TPair<FString, FHeapSnapshot::FEntry>& A, const TPair<FString, FHeapSnapshot::FEntry>& B)
+        {
+            return FMath::Abs(A.Value.Bytes) > FMath::Abs(B.Value.Bytes);
+        });
+
+        Out += FString::Printf(TEXT("[%s]\n%14s %10s  %s\n"), Title, TEXT("Bytes"), TEXT("Count"), TEXT("Path"));
+        for (int32 i = 0; i < Sorted.Num() && (Count <= 0 || i < Count); i++)
+            Out += FString::Printf(TEXT("%14lld %10lld  %s\n"), Sorted[i].Value.Bytes, Sorted[i].Value.Count, *Sorted[i].Key);
+        Out += TEXT("\n");
+    }
+
+    FString FHeapSnapshot::ToString(int32 Count) const
+    {
+        FString Out = FString::Printf(TEXT("Total: %lld bytes\n\n"), TotalBytes);
+        AppendEntries(Out, TEXT("Roots"), Roots, Count);
+        AppendEntries(Out, TEXT("Types"), Types, Count);
+        return Out;
+    }
+
+    bool FHeapSnapshot::SaveToFile(const FString& FilePath, int32 Count) const
+    {
+        return FFileHelper::SaveStringToFile(ToString(Count), *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+    }
+}
@@ -0,0 +1,53 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "lua.hpp"
+
+namespace UnLua
+{
+    /**
+     * Lua堆快照，遍历一次lua_State，把可达对象的估算大小归到首先到达它的根路径上
+     *
+     * 根路径依次为：package.loaded中的模块（module:<名字>）、绑定的UObject（object:<类名>）、全局表（global）、注册表（registry）。
+     * 同时按对象类型汇总，结构体与容器等userdata按元表名区分（userdata:<名字>）。
+     */
+    class UNLUA_API FHeapSnapshot
+    {
+    public:
+        struct FEntry
+        {
+            int64 Count = 0;
+            int64 Bytes = 0;
+        };
+
+        TMap<FString, FEntry> Roots;
+        TMap<FString, FEntry> Types;
+        int64 TotalBytes = 0;
+
+        /* 对L所在的Lua环境做一次快照，调用前最好先完整GC一次 */
+        static FHeapSnapshot Capture(lua_State* L);
+
+        /* New相对Old的变化，只保留有变化的项 */
+        static FHeapSnapshot Diff(const FHeapSnapshot& Old, const FHeapSnapshot& New);
+
+        /* 按字节数（绝对值）从高到低输出，Count为每一节最多输出的行数，0为全部 */
+        FString ToString(int32 Count = 0) const;
+
+        bool SaveToFile(const FString& FilePath, int32 Count = 0) const;
+    };
+}
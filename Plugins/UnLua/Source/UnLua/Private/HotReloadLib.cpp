@@ -0,0 +1,481 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+//
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License");
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+
+#include "HotReloadLib.h"
+#include "UnLuaBase.h"
+
+namespace UnLua
+{
+    namespace HotReloadLib
+    {
+        static const char* CONTEXT_METATABLE_NAME = "UnLuaHotReloadContext";
+
+        /**
+         * 模块之间的 require 依赖图
+         */
+        struct FModuleGraph
+        {
+            TMap<FString, TSet<FString>> Dependencies; // 模块 -> 它 require 的模块
+            TMap<FString, TSet<FString>> Dependents; // 模块 -> require 它的模块
+
+            void AddDependency(const FString& Module, const FString& Dependency)
+            {
+                Dependencies.FindOrAdd(Module).Add(Dependency);
+                Dependents.FindOrAdd(Dependency).Add(Module);
+            }
+
+            void ClearDependencies(const FString& Module)
+            {
+                TSet<FString> Old;
+                if (!Dependencies.RemoveAndCopyValue(Module, Old))
+                    return;
+
+                for (const auto& Dependency : Old)
+                {
+                    if (auto Exists = Dependents.Find(Dependency))
+                        Exists->Remove(Module);
+                }
+            }
+
+            /* 收集指定模块以及所有直接/间接依赖它们的模块，被依赖的模块排在前面 */
+            void CollectDependents(const TArray<FString>& Roots, TArray<FString>& OutModules) const
+            {
+                TSet<FString> Collected;
+                TArray<FString> Pending(Roots);
+                while (Pending.Num() > 0)
+                {
+                    const FString Module = Pending.Pop();
+                    bool bAlreadyInSet;
+                    Collected.Add(Module, &bAlreadyInSet);
+                    if (bAlreadyInSet)
+                        continue;
+
+                    if (const auto Exists = Dependents.Find(Module))
+                        Pending.Append(Exists->Array());
+                }
+
+                // Kahn 拓扑排序，只考虑集合内部的依赖边
+                TMap<FString, int32> InDegrees;
+                for (const auto& Module : Collected)
+                {
+                    int32& InDegree = InDegrees.Add(Module, 0);
+                    if (const auto Exists = Dependencies.Find(Module))
+                    {
+                        for (const auto& Dependency : *Exists)
+                        {
+                            if (Dependency != Module && Collected.Contains(Dependency))
+                                ++InDegree;
+                        }
+                    }
+                }
+
+                OutModules.Reserve(Collected.Num());
+                for (const auto& Root : Roots)
+                {
+                    if (InDegrees.FindRef(Root) == 0 && !OutModules.Contains(Root))
+                        OutModules.Add(Root);
+                }
+                for (const auto& Pair : InDegrees)
+                {
+                    if (Pair.Value == 0 && !OutModules.Contains(Pair.Key))
+                        OutModules.Add(Pair.Key);
+                }
+
+                for (int32 Index = 0; Index < OutModules.Num(); ++Index)
+                {
+                    const auto Exists = Dependents.Find(OutModules[Index]);
+                    if (!Exists)
+                        continue;
+
+                    for (const auto& Dependent : *Exists)
+                    {
+                        int32* InDegree = InDegrees.Find(Dependent);
+                        if (InDegree && --(*InDegree) == 0)
+                            OutModules.Add(Dependent);
+                    }
+                }
+
+                // 循环依赖的模块保持任意顺序
+                if (OutModules.Num() < Collected.Num())
+                {
+                    for (const auto& Module : Collected)
+                        OutModules.AddUnique(Module);
+                }
+            }
+        };
+
+        /**
+         * 在 C++ 中遍历 Lua 堆，把所有对旧值的引用替换为新值。
+         * 旧值按指针预先建立索引，遍历时每个槽位只需要一次哈希查找，不再回到 Lua 层查表。
+         */
+        class FReferencePatcher
+        {
+        public:
+            FReferencePatcher(lua_State* L, int32 ValueMapIdx, int32 ExcludeIdx)
+                : L(L), ValueMapIdx(ValueMapIdx)
+            {
+                lua_pushnil(L);
+                while (lua_next(L, ValueMapIdx) != 0)
+                {
+                    Replacements.Add(lua_topointer(L, -2));
+                    lua_pop(L, 1);
+                }
+
+                if (lua_istable(L, ExcludeIdx))
+                {
+                    lua_pushnil(L);
+                    while (lua_next(L, ExcludeIdx) != 0)
+                    {
+                        if (lua_toboolean(L, -1))
+                            Visited.Add(lua_topointer(L, -2));
+                        lua_pop(L, 1);
+                    }
+                }
+                Visited.Add(lua_topointer(L, ValueMapIdx));
+
+                lua_newtable(L);
+                QueueIdx = lua_gettop(L);
+                Visited.Add(lua_topointer(L, QueueIdx));
+            }
+
+            int32 Run()
+            {
+                PatchRunningStack();
+
+                lua_pushglobaltable(L);
+                Enqueue(-1);
+                lua_pop(L, 1);
+
+                lua_pushvalue(L, LUA_REGISTRYINDEX);
+                Enqueue(-1);
+                lua_pop(L, 1);
+
+                while (Head <= Tail)
+                {
+                    lua_rawgeti(L, QueueIdx, Head);
+                    lua_pushnil(L);
+                    lua_rawseti(L, QueueIdx, Head);
+                    ++Head;
+
+                    const int32 Index = lua_gettop(L);
+                    switch (lua_type(L, Index))
+                    {
+                    case LUA_TTABLE:
+                        PatchTable(Index);
+                        break;
+                    case LUA_TUSERDATA:
+                        PatchUserdata(Index);
+                        break;
+                    case LUA_TFUNCTION:
+                        PatchFunction(Index);
+                        break;
+                    default:
+                        break;
+                    }
+                    lua_settop(L, Index - 1);
+                }
+
+                return NumPatched;
+            }
+
+        private:
+            FORCEINLINE static bool IsCollectable(int32 Type)
+            {
+                return Type == LUA_TTABLE || Type == LUA_TFUNCTION || Type == LUA_TUSERDATA;
+            }
+
+            /* 若栈上指定位置的值需要替换，则将新值压栈并返回true */
+            bool PushReplacement(int32 Index)
+            {
+                if (!IsCollectable(lua_type(L, Index)))
+                    return false;
+
+                if (!Replacements.Contains(lua_topointer(L, Index)))
+                    return false;
+
+                lua_pushvalue(L, Index);
+                lua_rawget(L, ValueMapIdx);
+                if (lua_isnil(L, -1))
+                {
+                    lua_pop(L, 1);
+                    return false;
+                }
+                return true;
+            }
+
+            void Enqueue(int32 Index)
+            {
+                if (!IsCollectable(lua_type(L, Index)))
+                    return;
+
+                bool bAlreadyInSet;
+                Visited.Add(lua_topointer(L, Index), &bAlreadyInSet);
+                if (bAlreadyInSet)
+                    return;
+
+                lua_pushvalue(L, Index);
+                lua_rawseti(L, QueueIdx, ++Tail);
+            }
+
+            void PatchTable(int32 TableIdx)
+            {
+                if (lua_getmetatable(L, TableIdx))
+                {
+                    Enqueue(-1);
+                    lua_pop(L, 1);
+                }
+
+                lua_newtable(L);
+                const int32 ReplacedKeysIdx = lua_gettop(L);
+                bool bHasReplacedKeys = false;
+
+                lua_pushnil(L);
+                while (lua_next(L, TableIdx) != 0)
+                {
+                    if (PushReplacement(-1))
+                    {
+                        lua_pushvalue(L, -3);
+                        lua_pushvalue(L, -2);
+                        lua_rawset(L, TableIdx);
+                        Enqueue(-1);
+                        lua_pop(L, 1);
+                        ++NumPatched;
+                    }
+                    else
+                    {
+                        Enqueue(-1);
+                    }
+                    lua_pop(L, 1);
+
+                    if (PushReplacement(-1))
+                    {
+                        lua_pushvalue(L, -2);
+                        lua_insert(L, -2);
+                        lua_rawset(L, ReplacedKeysIdx);
+                        bHasReplacedKeys = true;
+                    }
+                    else
+                    {
+                        Enqueue(-1);
+                    }
+                }
+
+                if (bHasReplacedKeys)
+                {
+                    lua_pushnil(L);
+                    while (lua_next(L, ReplacedKeysIdx) != 0)
+                    {
+                        // old key -2, new key -1
+                        lua_pushvalue(L, -2);
+                        lua_rawget(L, TableIdx);
+                        lua_pushvalue(L, -3);
+                        lua_pushnil(L);
+                        lua_rawset(L, TableIdx);
+                        lua_pushvalue(L, -2);
+                        lua_insert(L, -2);
+                        lua_rawset(L, TableIdx);
+                        Enqueue(-1);
+                        lua_pop(L, 1);
+                        ++NumPatched;
+                    }
+                }
+
+                lua_pop(L, 1);
+            }
+
+            void PatchUserdata(int32 UserdataIdx)
+            {
+                if (lua_getmetatable(L, UserdataIdx))
+                {
+                    Enqueue(-1);
+                    lua_pop(L, 1);
+                }
+
+                lua_getuservalue(L, UserdataIdx);
+                if (PushReplacement(-1))
+                {
+                    lua_pushvalue(L, -1);
+                    lua_setuservalue(L, UserdataIdx);
+                    Enqueue(-1);
+                    lua_pop(L, 1);
+                    ++NumPatched;
+                }
+                else
+                {
+                    Enqueue(-1);
+                }
+                lua_pop(L, 1);
+            }
+
+            void PatchFunction(int32 FunctionIdx)
+            {
+                // upvalue 由 HotReload.lua 在 merge_objects 里按 upvalueid 合并，这里只负责继续遍历
+                for (int32 i = 1; lua_getupvalue(L, FunctionIdx, i); ++i)
+                {
+                    if (PushReplacement(-1))
+                    {
+                        Enqueue(-1);
+                        lua_pop(L, 1);
+                    }
+                    else
+                    {
+                        Enqueue(-1);
+                    }
+                    lua_pop(L, 1);
+                }
+            }
+
+            void PatchRunningStack()
+            {
+                lua_Debug Ar;
+                for (int32 Level = 1; lua_getstack(L, Level, &Ar); ++Level)
+                {
+                    lua_getinfo(L, "f", &Ar);
+                    Enqueue(-1);
+                    lua_pop(L, 1);
+
+                    PatchLocals(Ar, 1, 1);
+                    PatchLocals(Ar, -1, -1);
+                }
+            }
+
+            void PatchLocals(lua_Debug& Ar, int32 Start, int32 Step)
+            {
+                for (int32 i = Start; lua_getlocal(L, &Ar, i); i += Step)
+                {
+                    if (PushReplacement(-1))
+                    {
+                        Enqueue(-1);
+                        lua_setlocal(L, &Ar, i);
+                        ++NumPatched;
+                    }
+                    else
+                    {
+                        Enqueue(-1);
+                    }
+                    lua_pop(L, 1);
+                }
+            }
+
+            lua_State* L;
+            int32 ValueMapIdx;
+            int32 QueueIdx = 0;
+            int32 Head = 1;
+            int32 Tail = 0;
+            int32 NumPatched = 0;
+            TSet<const void*> Replacements;
+            TSet<const void*> Visited;
+        };
+
+        static FModuleGraph& GetGraph(lua_State* L)
+        {
+            return *(FModuleGraph*)lua_touserdata(L, lua_upvalueindex(1));
+        }
+
+        static void ToStringArray(lua_State* L, int32 Index, TArray<FString>& OutArray)
+        {
+            const auto Len = lua_rawlen(L, Index);
+            OutArray.Reserve(Len);
+            for (lua_Integer i = 1; i <= (lua_Integer)Len; ++i)
+            {
+                lua_rawgeti(L, Index, i);
+                if (lua_type(L, -1) == LUA_TSTRING)
+                    OutArray.Add(UTF8_TO_TCHAR(lua_tostring(L, -1)));
+                lua_pop(L, 1);
+            }
+        }
+
+        static int AddDependency(lua_State* L)
+        {
+            const FString Module = UTF8_TO_TCHAR(luaL_checkstring(L, 1));
+            const FString Dependency = UTF8_TO_TCHAR(luaL_checkstring(L, 2));
+            if (Module != Dependency)
+                GetGraph(L).AddDependency(Module, Dependency);
+            return 0;
+        }
+
+        static int ClearDependencies(lua_State* L)
+        {
+            const FString Module = UTF8_TO_TCHAR(luaL_checkstring(L, 1));
+            GetGraph(L).ClearDependencies(Module);
+            return 0;
+        }
+
+        static int CollectDependents(lua_State* L)
+        {
+            luaL_checktype(L, 1, LUA_TTABLE);
+
+            TArray<FString> Roots;
+            ToStringArray(L, 1, Roots);
+
+            TArray<FString> Modules;
+            GetGraph(L).CollectDependents(Roots, Modules);
+
+            lua_createtable(L, Modules.Num(), 0);
+            for (int32 i = 0; i < Modules.Num(); ++i)
+            {
+                lua_pushstring(L, TCHAR_TO_UTF8(*Modules[i]));
+                lua_rawseti(L, -2, i + 1);
+            }
+            return 1;
+        }
+
+        static int Patch(lua_State* L)
+        {
+            luaL_checktype(L, 1, LUA_TTABLE);
+            lua_settop(L, 2);
+            luaL_checkstack(L, LUA_MINSTACK, "hot reload patch");
+
+            FReferencePatcher Patcher(L, 1, 2);
+            lua_pushinteger(L, Patcher.Run());
+            return 1;
+        }
+
+        static int ReleaseContext(lua_State* L)
+        {
+            const auto Graph = (FModuleGraph*)lua_touserdata(L, 1);
+            Graph->~FModuleGraph();
+            return 0;
+        }
+
+        static constexpr luaL_Reg HotReloadLib_Functions[] = {
+            {"add_dependency", AddDependency},
+            {"clear_dependencies", ClearDependencies},
+            {"collect_dependents", CollectDependents},
+            {"patch", Patch},
+            {NULL, NULL}
+        };
+
+        static int LuaOpen(lua_State* L)
+        {
+            lua_newtable(L);
+
+            new(lua_newuserdata(L, sizeof(FModuleGraph))) FModuleGraph();
+            luaL_newmetatable(L, CONTEXT_METATABLE_NAME);
+            lua_pushcfunction(L, ReleaseContext);
+            lua_setfield(L, -2, "__gc");
+            lua_setmetatable(L, -2);
+
+            luaL_setfuncs(L, HotReloadLib_Functions, 1);
+            return 1;
+        }
+
+        int Open(lua_State* L)
+        {
+            luaL_requiref(L, "UnLua.HotReloadLib", LuaOpen, 0);
+            lua_pop(L, 1);
+            return 0;
+        }
+    }
+}
@@ -0,0 +1,25 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+//
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License");
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+#include "lua.hpp"
+
+namespace UnLua
+{
+    namespace HotReloadLib
+    {
+        /* 注册 UnLua.HotReloadLib，为 HotReload.lua 提供模块依赖图与引用替换的原生实现 */
+        int Open(lua_State* L);
+    }
+}
@@ -18,6 +18,7 @@
 #include "LuaDynamicBinding.h"
 #include "UnLua.h"
 #include "LowLevel.h"
+#include "LuaDanglingCheck.h"
 #include "Containers/LuaSet.h"
 #include "Containers/LuaMap.h"
 #include "ReflectionUtils/FieldDesc.h"
@@ -88,6 +89,8 @@ void SetTableForClass(lua_State *L, const char *Name)
 #define BIT_RELEASED_TAG            (1 << 6)        // this userdata was released and should not use anywhere
 #define BIT_TWOLEVEL_PTR        (1 << 5)            // two level pointer flag
 #define BIT_SCRIPT_CONTAINER    (1 << 4)            // script container (TArray, TSet, TMap) flag
+#define BIT_POOLED_TAG          (1 << 3)            // struct userdata is in the pool, waiting for reuse
+#define BIT_GENERATION          (1 << 2)            // borrowed userdata with a dangling check generation stored before the desc
 
 #pragma  pack(push)
 #pragma  pack(1)
@@ -249,14 +252,20 @@ static FUserdataDesc* GetUserdataDesc(Udata* U)
     return UserdataDesc;
 }
 
-static void* NewUserdataWithDesc(lua_State* L, int Size, uint8 Tag, uint8 Padding)
+static void* NewUserdataWithDesc(lua_State* L, int Size, uint8 Tag, uint8 Padding, uint64 Generation = 0)
 {
+    const int32 GenerationSize = Generation ? sizeof(uint64) : 0;
 #if 504 == LUA_VERSION_NUM
-    uint8* Userdata = (uint8*)lua_newuserdatauv(L, Size + Padding + sizeof(FUserdataDesc), 0);
+    uint8* Userdata = (uint8*)lua_newuserdatauv(L, Size + Padding + GenerationSize + sizeof(FUserdataDesc), 0);
 #else
-    uint8* Userdata = (uint8*)lua_newuserdata(L, Size + Padding + sizeof(FUserdataDesc));
+    uint8* Userdata = (uint8*)lua_newuserdata(L, Size + Padding + GenerationSize + sizeof(FUserdataDesc));
 #endif
-    FUserdataDesc* UserdataDesc = (FUserdataDesc*)(Userdata + Size + Padding);
+    if (Generation)
+    {
+        FMemory::Memcpy(Userdata + Size + Padding, &Generation, sizeof(uint64));
+        Tag |= BIT_GENERATION;
+    }
+    FUserdataDesc* UserdataDesc = (FUserdataDesc*)(Userdata + Size + Padding + GenerationSize);
     UserdataDesc->magic = USERDATA_MAGIC;
     UserdataDesc->tag = Tag;
     UserdataDesc->padding = Padding;
@@ -264,16 +273,42 @@ static void* NewUserdataWithDesc(lua_State* L, int Size, uint8 Tag, uint8 Paddin
     return Userdata;
 }
 
-void* NewUserdataWithTwoLvPtrTag(lua_State* L, int Size, void* Object)
+/**
+ * Whether the userdata was borrowed by a guarded call which has returned
+ */
+static FORCEINLINE bool IsDanglingUserdata(lua_State* L, const FUserdataDesc* UserdataDesc)
+{
+    if (!(UserdataDesc->tag & BIT_GENERATION))
+        return false;
+
+    uint64 Generation;
+    FMemory::Memcpy(&Generation, (const uint8*)UserdataDesc - sizeof(uint64), sizeof(uint64));
+    return !UnLua::FDanglingCheck::IsAlive(L, Generation);
+}
+
+/**
+ * Whether the userdata at the given stack index is dangling
+ */
+static bool IsDanglingValue(lua_State* L, int32 Index)
+{
+    TValue* Value = GetTValue(L, Index);
+    if (GetTValueType(Value) != LUA_TUSERDATA)
+        return false;
+
+    const FUserdataDesc* UserdataDesc = GetUserdataDesc(GetUdata(Value));
+    return UserdataDesc && IsDanglingUserdata(L, UserdataDesc);
+}
+
+void* NewUserdataWithTwoLvPtrTag(lua_State* L, int Size, void* Object, uint64 Generation)
 {
-    void* Userdata = NewUserdataWithDesc(L, Size, (BIT_VARIANT_TAG | BIT_TWOLEVEL_PTR), 0);
+    void* Userdata = NewUserdataWithDesc(L, Size, (BIT_VARIANT_TAG | BIT_TWOLEVEL_PTR), 0, Generation);
     *(void**)Userdata = Object;
     return Userdata;
 }
 
-void* NewUserdataWithContainerTag(lua_State* L, int Size)
+void* NewUserdataWithContainerTag(lua_State* L, int Size, uint64 Generation)
 {
-    return NewUserdataWithDesc(L, Size, (BIT_VARIANT_TAG | BIT_SCRIPT_CONTAINER), 0);
+    return NewUserdataWithDesc(L, Size, (BIT_VARIANT_TAG | BIT_SCRIPT_CONTAINER), 0, Generation);
 }
 
 void* NewUserdataWithPaddingTag(lua_State* L, int Size, uint8 Padding)
@@ -287,7 +322,7 @@ void MarkUserdataTwoLvPtrTag(void* Userdata)
     FUserdataDesc* UserdataDesc = GetUserdataDesc(U);
     if (UserdataDesc)
     {
-        UserdataDesc->tag = (BIT_VARIANT_TAG | BIT_TWOLEVEL_PTR);
+        UserdataDesc->tag = (BIT_VARIANT_TAG | BIT_TWOLEVEL_PTR) | (UserdataDesc->tag & BIT_GENERATION);     // keep the generation stamp
     }
 }
 
@@ -333,7 +368,7 @@ void* GetUserdataFast(lua_State *L, int32 Index, bool *OutTwoLvlPtr)
             && (UserdataDesc->tag & BIT_VARIANT_TAG))// if the userdata has a variant tag
         {
             bTwoLvlPtr = (UserdataDesc->tag & BIT_TWOLEVEL_PTR) != 0;        // test if the userdata is a two level pointer
-            if (UserdataDesc->tag & BIT_RELEASED_TAG)
+            if ((UserdataDesc->tag & BIT_RELEASED_TAG) || IsDanglingUserdata(L, UserdataDesc))
                 Userdata = nullptr;
             else
                 Userdata = bTwoLvlPtr ? Buffer : Buffer + UserdataDesc->padding;    // add padding to userdata if it's not a two level pointer
@@ -399,6 +434,171 @@ void* NewUserdataWithPadding(lua_State *L, int32 Size, const char *MetatableName
     return (uint8*)Userdata + PaddingSize;                          // return 'valid' address (userdata memory address + padding size)
 }
 
+static const char* STRUCT_POOL_KEY = "UnLuaStructPool";
+
+int32 GLuaStructPoolCapacity = 64;
+
+/**
+ * Size of the struct in a pooled userdata, used by the StructPool memory stat
+ */
+static FORCEINLINE int32 GetPooledStructSize(Udata* U, const FUserdataDesc* UserdataDesc)
+{
+    return GetUdataMemSize(U) - UserdataDesc->padding - (int32)sizeof(FUserdataDesc);
+}
+
+/**
+ * Create a struct userdata, reuse a released one with the same metatable if possible. A reused struct is still initialized.
+ */
+void* NewStructUserdata(lua_State *L, int32 Size, const char *MetatableName, uint8 PaddingSize, bool &bOutRecycled)
+{
+    bOutRecycled = false;
+    if (GLuaStructPoolCapacity > 0 && MetatableName)
+    {
+        if (lua_getfield(L, LUA_REGISTRYINDEX, STRUCT_POOL_KEY) == LUA_TTABLE)
+        {
+            luaL_getmetatable(L, MetatableName);
+            if (lua_rawget(L, -2) == LUA_TTABLE)
+            {
+                const int32 Num = (int32)lua_rawlen(L, -1);
+                if (Num > 0)
+                {
+                    lua_rawgeti(L, -1, Num);
+                    lua_pushnil(L);
+                    lua_rawseti(L, -3, Num);
+                    lua_replace(L, -3);
+                    lua_pop(L, 1);
+
+                    Udata* U = GetUdata(GetTValue(L, -1));
+                    FUserdataDesc* UserdataDesc = GetUserdataDesc(U);
+                    if (!UserdataDesc)
+                    {
+                        lua_pop(L, 1);
+                        return NewUserdataWithPadding(L, Size, MetatableName, PaddingSize);
+                    }
+
+                    UserdataDesc->tag &= ~BIT_POOLED_TAG;
+                    UNLUA_STAT_MEMORY_DEC(StructPool, GetPooledStructSize(U, UserdataDesc));
+                    if (GetUdataMemSize(U) == Size + PaddingSize + (int32)sizeof(FUserdataDesc))
+                    {
+                        bOutRecycled = true;
+                        return (uint8*)GetUdataMem(U) + UserdataDesc->padding;
+                    }
+                    lua_pop(L, 1);          // size mismatch, discard it
+                    return NewUserdataWithPadding(L, Size, MetatableName, PaddingSize);
+                }
+            }
+            lua_pop(L, 1);
+        }
+        lua_pop(L, 1);
+    }
+    return NewUserdataWithPadding(L, Size, MetatableName, PaddingSize);
+}
+
+/**
+ * Put a struct userdata into the pool of its metatable, the struct is kept initialized and destroyed by __gc as usual
+ */
+bool ReleaseStructUserdata(lua_State *L, int32 Index)
+{
+    if (GLuaStructPoolCapacity <= 0)
+        return false;
+
+    Index = lua_absindex(L, Index);
+    TValue* Value = GetTValue(L, Index);
+    if (GetTValueType(Value) != LUA_TUSERDATA)
+        return false;
+
+    // only structs owning their memory can be reused, references and containers are skipped
+    Udata* U = GetUdata(Value);
+    FUserdataDesc* UserdataDesc = GetUserdataDesc(U);
+    if (!UserdataDesc
+        || !(UserdataDesc->tag & BIT_VARIANT_TAG)
+        || (UserdataDesc->tag & (BIT_RELEASED_TAG | BIT_TWOLEVEL_PTR | BIT_SCRIPT_CONTAINER | BIT_POOLED_TAG)))
+        return false;
+
+    if (!lua_getmetatable(L, Index))
+        return false;
+    const int32 MetatableIndex = lua_gettop(L);
+
+    lua_pushstring(L, "ClassDesc");
+    lua_rawget(L, MetatableIndex);
+    const auto ClassDesc = (FClassDesc*)lua_touserdata(L, -1);
+    lua_pop(L, 1);
+    if (!ClassDesc || !ClassDesc->IsScriptStruct())
+    {
+        lua_pop(L, 1);
+        return false;
+    }
+
+    if (lua_getfield(L, LUA_REGISTRYINDEX, STRUCT_POOL_KEY) != LUA_TTABLE)
+    {
+        lua_pop(L, 1);
+        lua_newtable(L);
+        lua_pushvalue(L, -1);
+        lua_setfield(L, LUA_REGISTRYINDEX, STRUCT_POOL_KEY);
+    }
+
+    lua_pushvalue(L, MetatableIndex);
+    if (lua_rawget(L, -2) != LUA_TTABLE)
+    {
+        lua_pop(L, 1);
+        lua_createtable(L, GLuaStructPoolCapacity, 0);
+        lua_pushvalue(L, MetatableIndex);
+        lua_pushvalue(L, -2);
+        lua_rawset(L, -4);
+    }
+
+    const int32 Num = (int32)lua_rawlen(L, -1);
+    const bool bPooled = Num < GLuaStructPoolCapacity;
+    if (bPooled)
+    {
+        lua_pushvalue(L, Index);
+        lua_rawseti(L, -2, Num + 1);
+        UserdataDesc->tag |= BIT_POOLED_TAG;
+        UNLUA_STAT_MEMORY_INC(StructPool, GetPooledStructSize(U, UserdataDesc));
+    }
+    lua_settop(L, MetatableIndex - 1);
+    return bPooled;
+}
+
+/**
+ * Drop all pooled struct userdata of the lua_State, they are destroyed by __gc as usual
+ */
+void ClearStructPools(lua_State *L)
+{
+    if (lua_getfield(L, LUA_REGISTRYINDEX, STRUCT_POOL_KEY) != LUA_TTABLE)
+    {
+        lua_pop(L, 1);
+        return;
+    }
+
+    lua_pushnil(L);
+    while (lua_next(L, -2) != 0)
+    {
+        const int32 Num = lua_type(L, -1) == LUA_TTABLE ? (int32)lua_rawlen(L, -1) : 0;
+        for (int32 i = 1; i <= Num; ++i)
+        {
+            lua_rawgeti(L, -1, i);
+            TValue* Value = GetTValue(L, -1);
+            if (GetTValueType(Value) == LUA_TUSERDATA)
+            {
+                Udata* U = GetUdata(Value);
+                FUserdataDesc* UserdataDesc = GetUserdataDesc(U);
+                if (UserdataDesc)
+                {
+                    UserdataDesc->tag &= ~BIT_POOLED_TAG;
+                    UNLUA_STAT_MEMORY_DEC(StructPool, GetPooledStructSize(U, UserdataDesc));
+                }
+            }
+            lua_pop(L, 1);
+        }
+        lua_pop(L, 1);
+    }
+    lua_pop(L, 1);
+
+    lua_pushnil(L);
+    lua_setfield(L, LUA_REGISTRYINDEX, STRUCT_POOL_KEY);
+}
+
 /**
  * Get a cpp instance's address
  */
@@ -456,16 +656,15 @@ void* CacheScriptContainer(lua_State *L, void *Key, const FScriptContainerDesc &
     lua_getfield(L, LUA_REGISTRYINDEX, "ScriptContainerMap");
     lua_pushlightuserdata(L, Key);
     int32 Type = lua_rawget(L, -2);             
-    if (Type == LUA_TNIL)
+    if (Type == LUA_TNIL || IsDanglingValue(L, -1))
     {
         lua_pop(L, 1);
 
-        Userdata = NewUserdataWithContainerTag(L, Desc.GetSize());      // create new userdata
+        Userdata = NewUserdataWithContainerTag(L, Desc.GetSize(), UnLua::FDanglingCheck::GetGeneration(L));      // create new userdata
         luaL_setmetatable(L, Desc.GetName());               // set metatable
         lua_pushlightuserdata(L, Key);
         lua_pushvalue(L, -2);
         lua_rawset(L, -4);                                  // cache it in 'ScriptContainerMap'
-        UnLua::FLuaEnv::FindEnv(L)->GetDanglingCheck()->CaptureContainer(L, Key);
     }
 #if UE_BUILD_DEBUG
     else
@@ -491,16 +690,15 @@ void* CacheScriptContainer(lua_State *L, void *Key, const FScriptContainerDesc &
     lua_getfield(L, LUA_REGISTRYINDEX, "ScriptContainerMap");
     lua_pushlightuserdata(L, Key);
     int32 Type = lua_rawget(L, -2);
-    if (Type == LUA_TNIL || !Validator(lua_touserdata(L, -1)))
+    if (Type == LUA_TNIL || IsDanglingValue(L, -1) || !Validator(lua_touserdata(L, -1)))
     {
         lua_pop(L, 1);
 
-        Userdata = NewUserdataWithContainerTag(L, Desc.GetSize());      // create new userdata
+        Userdata = NewUserdataWithContainerTag(L, Desc.GetSize(), UnLua::FDanglingCheck::GetGeneration(L));      // create new userdata
         luaL_setmetatable(L, Desc.GetName());               // set metatable
         lua_pushlightuserdata(L, Key);
         lua_pushvalue(L, -2);
         lua_rawset(L, -4);                                  // cache it in 'ScriptContainerMap'
-        UnLua::FLuaEnv::FindEnv(L)->GetDanglingCheck()->CaptureContainer(L, Key);
     }
 
     lua_remove(L, -2);
@@ -1425,8 +1623,12 @@ int32 ScriptStruct_New(lua_State *L)
     }
 
     UScriptStruct *ScriptStruct = ClassDesc->AsScriptStruct();
-    void *Userdata = NewUserdataWithPadding(L, ClassDesc->GetSize(), TCHAR_TO_UTF8(*ClassDesc->GetName()), ClassDesc->GetUserdataPadding());
-    ScriptStruct->InitializeStruct(Userdata);
+    bool bRecycled;
+    void *Userdata = NewStructUserdata(L, ClassDesc->GetSize(), TCHAR_TO_UTF8(*ClassDesc->GetName()), ClassDesc->GetUserdataPadding(), bRecycled);
+    if (bRecycled)
+        ScriptStruct->ClearScriptStruct(Userdata);
+    else
+        ScriptStruct->InitializeStruct(Userdata);
 
     return 1;
 }
@@ -1482,8 +1684,10 @@ int32 ScriptStruct_CopyFrom(lua_State *L)
 	}
 	else
 	{
-		Userdata = NewUserdataWithPadding(L, ClassDesc->GetSize(), TCHAR_TO_UTF8(*ClassDesc->GetName()), ClassDesc->GetUserdataPadding());
-		ScriptStruct->InitializeStruct(Userdata);
+		bool bRecycled;
+		Userdata = NewStructUserdata(L, ClassDesc->GetSize(), TCHAR_TO_UTF8(*ClassDesc->GetName()), ClassDesc->GetUserdataPadding(), bRecycled);
+		if (!bRecycled)
+			ScriptStruct->InitializeStruct(Userdata);
 	}
 	ScriptStruct->CopyScriptStruct(Src,Userdata);
 	return 1;
@@ -1512,8 +1716,10 @@ int32 ScriptStruct_Copy(lua_State *L)
     }
     else
     {
-        Userdata = NewUserdataWithPadding(L, ClassDesc->GetSize(), TCHAR_TO_UTF8(*ClassDesc->GetName()), ClassDesc->GetUserdataPadding());
-        ScriptStruct->InitializeStruct(Userdata);
+        bool bRecycled;
+        Userdata = NewStructUserdata(L, ClassDesc->GetSize(), TCHAR_TO_UTF8(*ClassDesc->GetName()), ClassDesc->GetUserdataPadding(), bRecycled);
+        if (!bRecycled)
+            ScriptStruct->InitializeStruct(Userdata);
     }
     ScriptStruct->CopyScriptStruct(Userdata, Src);
     return 1;
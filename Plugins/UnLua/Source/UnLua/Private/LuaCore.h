@@ -47,8 +47,8 @@ bool TryToSetMetatable(lua_State *L, const char *MetatableName, UObject* Object
 /**
  * Functions to handle Lua userdata
  */
-void* NewUserdataWithTwoLvPtrTag(lua_State* L, int Size, void* Object);
-void* NewUserdataWithContainerTag(lua_State* L, int Size);
+void* NewUserdataWithTwoLvPtrTag(lua_State* L, int Size, void* Object, uint64 Generation = 0);
+void* NewUserdataWithContainerTag(lua_State* L, int Size, uint64 Generation = 0);
 void MarkUserdataTwoLvPtrTag(void* Userdata);
 void SetUserdataFlags(void* Userdata, uint8 Flags);
 UNLUA_API uint8 CalcUserdataPadding(int32 Alignment);
@@ -57,6 +57,14 @@ UNLUA_API void* GetUserdata(lua_State *L, int32 Index, bool *OutTwoLvlPtr = null
 UNLUA_API void* GetUserdataFast(lua_State *L, int32 Index, bool *OutTwoLvlPtr = nullptr);
 UNLUA_API void* NewUserdataWithPadding(lua_State *L, int32 Size, const char *MetatableName, uint8 PaddingSize = 0);
 #define NewTypedUserdata(L, Type) NewUserdataWithPadding(L, sizeof(Type), #Type, CalcUserdataPadding<Type>())
+
+/**
+ * Functions to reuse struct userdata released by UnLua.Release, pools are per lua_State and per metatable
+ */
+UNLUA_API extern int32 GLuaStructPoolCapacity;
+UNLUA_API void* NewStructUserdata(lua_State *L, int32 Size, const char *MetatableName, uint8 PaddingSize, bool &bOutRecycled);
+UNLUA_API bool ReleaseStructUserdata(lua_State *L, int32 Index);
+UNLUA_API void ClearStructPools(lua_State *L);
 UNLUA_API void* GetCppInstance(lua_State *L, int32 Index);
 UNLUA_API void* GetCppInstanceFast(lua_State *L, int32 Index);
 
@@ -20,81 +20,24 @@
 namespace UnLua
 {
     bool FDanglingCheck::Enabled;
+    uint64 FDanglingCheck::LastGeneration = 0;
 
     FDanglingCheck::FGuard::FGuard(FDanglingCheck* Owner)
-        : Owner(Owner)
+        : Owner(Owner), Generation(++LastGeneration)
     {
-        Owner->GuardCount++;
+        Owner->ActiveGenerations.Push(Generation);
     }
 
     FDanglingCheck::FGuard::~FGuard()
     {
-        Owner->GuardCount--;
-
-        if (Owner->CapturedStructs.Num() > 0)
-        {
-            const auto L = Owner->Env->GetMainState();
-            lua_getfield(L, LUA_REGISTRYINDEX, "StructMap");
-            for (const auto& StructPtr : Owner->CapturedStructs)
-            {
-                lua_pushlightuserdata(L, StructPtr);
-                lua_rawget(L, -2);
-                if (lua_isnil(L, -1))
-                {
-                    lua_pop(L, 1);
-                    continue;
-                }
-
-                check(lua_isuserdata(L, -1))
-                bool TwoLevelPtr;
-                void* Userdata = GetUserdataFast(L, -1, &TwoLevelPtr);
-                check(TwoLevelPtr)
-                *(void**)Userdata = nullptr;
-
-                lua_pop(L, 1);
-
-                lua_pushlightuserdata(L, StructPtr);
-                lua_pushnil(L);
-                lua_rawset(L, -3);
-            }
-            lua_pop(L, 1);
-            if (Owner->GuardCount == 0)
-                Owner->CapturedStructs.Empty();
-        }
-
-        if (Owner->CapturedContainers.Num() > 0)
-        {
-            const auto L = Owner->Env->GetMainState();
-            lua_getfield(L, LUA_REGISTRYINDEX, "ScriptContainerMap");
-            for (const auto& ContainerPtr : Owner->CapturedContainers)
-            {
-                lua_pushlightuserdata(L, ContainerPtr);
-                lua_rawget(L, -2);
-                if (lua_isnil(L, -1))
-                {
-                    lua_pop(L, 1);
-                    continue;
-                }
-
-                bool TwoLevelPtr;
-                void* Userdata = GetUserdataFast(L, -1, &TwoLevelPtr);
-                SetUserdataFlags(Userdata, 1 << 6); // TODO:BIT_RELEASED_TAG
-                check(!TwoLevelPtr)
-
-                lua_pop(L, 1);
-
-                lua_pushlightuserdata(L, ContainerPtr);
-                lua_pushnil(L);
-                lua_rawset(L, -3);
-            }
-            lua_pop(L, 1);
-            if (Owner->GuardCount == 0)
-                Owner->CapturedContainers.Empty();
-        }
+        // luaL_error跳过内层调用的析构时，它们的代数还留在栈顶，这里一并移除
+        auto& ActiveGenerations = Owner->ActiveGenerations;
+        const int32 Index = ActiveGenerations.FindLast(Generation);
+        if (Index != INDEX_NONE)
+            ActiveGenerations.SetNum(Index, false);
     }
 
-    FDanglingCheck::FDanglingCheck(FLuaEnv* Env)
-        : Env(Env), GuardCount(0)
+    FDanglingCheck::FDanglingCheck()
     {
     }
 
@@ -105,17 +48,34 @@ namespace UnLua
         return MakeUnique<FGuard>(this);
     }
 
-    void FDanglingCheck::CaptureStruct(lua_State* L, void* Value)
+    uint64 FDanglingCheck::GetGeneration(lua_State* L)
     {
-        if (!GuardCount)
-            return;
-        CapturedStructs.Add(Value);
+        if (!Enabled)
+            return 0;
+        const auto Env = FLuaEnv::FindEnv(L);
+        return Env ? Env->GetDanglingCheck()->GetGeneration() : 0;
     }
 
-    void FDanglingCheck::CaptureContainer(lua_State* L, void* Value)
+    bool FDanglingCheck::IsAlive(lua_State* L, const uint64 Generation)
     {
-        if (!GuardCount)
-            return;
-        CapturedContainers.Add(Value);
+        const auto Env = FLuaEnv::FindEnv(L);
+        return !Env || Env->GetDanglingCheck()->IsAlive(Generation);
+    }
+
+    bool FDanglingCheck::IsAlive(const uint64 Generation) const
+    {
+        if (Generation == 0)
+            return true;
+
+        // 调用栈上的代数从底到顶递增
+        for (int32 Index = ActiveGenerations.Num() - 1; Index >= 0; --Index)
+        {
+            const uint64 Active = ActiveGenerations[Index];
+            if (Active == Generation)
+                return true;
+            if (Active < Generation)
+                return false;
+        }
+        return false;
     }
 }
@@ -19,13 +19,14 @@
 
 namespace UnLua
 {
-    class FLuaEnv;
-
-    class FDanglingCheck
+    class UNLUA_API FDanglingCheck
     {
     public:
         static bool Enabled;
 
+        /**
+         * 每次受保护的调用分配一个递增的代数，调用返回后这个代数失效，期间借出的userdata随之失效
+         */
         class FGuard final
         {
         public:
@@ -35,20 +36,27 @@ namespace UnLua
 
         private:
             FDanglingCheck* Owner;
+            uint64 Generation;
         };
 
-        explicit FDanglingCheck(FLuaEnv* Env);
+        FDanglingCheck();
 
         TUniquePtr<FGuard> MakeGuard();
 
-        void CaptureStruct(lua_State* L, void* Value);
+        /* 当前调用的代数，不在受保护的调用中时为0 */
+        FORCEINLINE uint64 GetGeneration() const { return ActiveGenerations.Num() > 0 ? ActiveGenerations.Last() : 0; }
+
+        /* 代数所属的调用是否还未返回，0表示不受保护 */
+        bool IsAlive(uint64 Generation) const;
+
+        /* L所属环境当前调用的代数，未开启检查时为0 */
+        static uint64 GetGeneration(lua_State* L);
 
-        void CaptureContainer(lua_State* L, void* Value);
+        static bool IsAlive(lua_State* L, uint64 Generation);
 
     private:
-        FLuaEnv* Env;
-        int32 GuardCount;
-        TSet<void*> CapturedStructs;
-        TSet<void*> CapturedContainers;
+        /* 代数全局递增，不同环境间也不会重复 */
+        static uint64 LastGeneration;
+        TArray<uint64> ActiveGenerations;
     };
 }
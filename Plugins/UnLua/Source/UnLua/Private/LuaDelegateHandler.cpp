@@ -34,14 +34,17 @@ void ULuaDelegateHandler::BindTo(FScriptDelegate* InDelegate)
     InDelegate->BindUFunction(this, NAME_Dummy);
 }
 
-void ULuaDelegateHandler::AddTo(FMulticastDelegateProperty* InProperty, void* InDelegate)
+void ULuaDelegateHandler::AddTo(FMulticastDelegateProperty* InProperty, void* InDelegate, bool bUnique)
 {
     check(InDelegate);
 
     Delegate = InDelegate;
     FScriptDelegate DynamicDelegate;
     DynamicDelegate.BindUFunction(this, NAME_Dummy);
-    TMulticastDelegateTraits<FMulticastDelegateType>::AddDelegate(InProperty, MoveTemp(DynamicDelegate), nullptr, InDelegate);
+    if (bUnique)
+        TMulticastDelegateTraits<FMulticastDelegateType>::AddDelegate(InProperty, MoveTemp(DynamicDelegate), nullptr, InDelegate);
+    else
+        TMulticastDelegateTraits<FMulticastDelegateType>::AddDelegateUnchecked(InProperty, MoveTemp(DynamicDelegate), nullptr, InDelegate);
 }
 
 UWorld* ULuaDelegateHandler::GetWorld() const
@@ -58,6 +61,12 @@ void ULuaDelegateHandler::RemoveFrom(FMulticastDelegateProperty* InProperty, voi
     TMulticastDelegateTraits<FMulticastDelegateType>::RemoveDelegate(InProperty, MoveTemp(DynamicDelegate), nullptr, InDelegate);
 }
 
+bool ULuaDelegateHandler::IsAddedTo(FMulticastDelegateProperty* InProperty, void* InDelegate) const
+{
+    const auto ScriptDelegate = TMulticastDelegateTraits<FMulticastDelegateType>::GetMulticastDelegate(InProperty, InDelegate);
+    return ScriptDelegate && ScriptDelegate->Contains(this, NAME_Dummy);
+}
+
 void ULuaDelegateHandler::BeginDestroy()
 {
     if (Registry)
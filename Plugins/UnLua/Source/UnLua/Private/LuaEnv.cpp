@@ -112,7 +112,7 @@ namespace UnLua
         EnumRegistry = new FEnumRegistry(this);
         EnumRegistry->Initialize();
 
-        DanglingCheck = new FDanglingCheck(this);
+        DanglingCheck = new FDanglingCheck();
         DeadLoopCheck = new FDeadLoopCheck(this);
 
         AutoObjectReference.SetName("UnLua_AutoReference");
@@ -160,6 +160,8 @@ namespace UnLua
 
         UnLuaLib::Open(L);
 
+        ClassRegistry->Preload(Settings->PreloadMetatables);
+
         OnCreated.Broadcast(*this);
         FUnLuaDelegates::OnLuaStateCreated.Broadcast(L);
 
@@ -174,6 +176,7 @@ namespace UnLua
     FLuaEnv::~FLuaEnv()
     {
         OnDestroyed.Broadcast(*this);
+        ClearStructPools(L);
         lua_close(L);
         AllEnvs.Remove(L);
 
@@ -351,8 +354,7 @@ namespace UnLua
             if (bImplUnluaInterface || (!bImplUnluaInterface && GLuaDynamicBinding.IsValid(Class)))
             {
                 // all bind operation should be in game thread, include dynamic bind
-                FScopeLock Lock(&CandidatesLock);
-                Candidates.AddUnique(Object);
+                EnqueueBindCandidate(Object);
                 return false;
             }
         }
@@ -372,18 +374,18 @@ namespace UnLua
         if (!ensureMsgf(ModuleLocator, TEXT("Invalid lua module locator, lua binding will not work properly. please check unlua runtime settings.")))
             return false;
 
-        const auto ModuleName = ModuleLocator->Locate(Object);
-        if (ModuleName.IsEmpty())
+        const auto ModuleName = ModuleLocator->LocateCached(Object);
+        if (!ModuleName)
             return false;
 
 #if !UE_BUILD_SHIPPING
-        if (GLuaDynamicBinding.IsValid(Class) && GLuaDynamicBinding.ModuleName != ModuleName)
+        if (GLuaDynamicBinding.IsValid(Class) && GLuaDynamicBinding.ModuleName != *ModuleName)
         {
-            UE_LOG(LogUnLua, Warning, TEXT("Dynamic binding '%s' ignored as it conflicts static binding '%s'."), *GLuaDynamicBinding.ModuleName, *ModuleName);
+            UE_LOG(LogUnLua, Warning, TEXT("Dynamic binding '%s' ignored as it conflicts static binding '%s'."), *GLuaDynamicBinding.ModuleName, **ModuleName);
         }
 #endif
 
-        return GetManager()->Bind(Object, *ModuleName, GLuaDynamicBinding.InitializerTableRef);
+        return GetManager()->Bind(Object, **ModuleName, GLuaDynamicBinding.InitializerTableRef);
     }
 
     bool FLuaEnv::DoString(const FString& Chunk, const FString& ChunkName)
@@ -447,9 +449,35 @@ namespace UnLua
 
     void FLuaEnv::HotReload()
     {
+        if (ModuleLocator)
+            ModuleLocator->InvalidateCache();
         DoString("UnLua.HotReload()");
     }
 
+    void FLuaEnv::HotReload(const TArray<FString>& ModuleNames)
+    {
+        if (ModuleNames.Num() == 0)
+            return;
+
+        if (ModuleLocator)
+            ModuleLocator->InvalidateCache();
+
+        const auto Guard = GetDeadLoopCheck()->MakeGuard();
+        const auto Top = lua_gettop(L);
+        lua_pushcfunction(L, ReportLuaCallError);
+        lua_getglobal(L, "UnLua");
+        lua_getfield(L, -1, "HotReload");
+        lua_remove(L, -2);
+        lua_createtable(L, ModuleNames.Num(), 0);
+        for (int32 i = 0; i < ModuleNames.Num(); ++i)
+        {
+            lua_pushstring(L, TCHAR_TO_UTF8(*ModuleNames[i]));
+            lua_rawseti(L, -2, i + 1);
+        }
+        lua_pcall(L, 1, 0, -3);
+        lua_settop(L, Top);
+    }
+
     int32 FLuaEnv::FindThread(const lua_State* Thread)
     {
         int32* ThreadRefPtr = ThreadToRef.Find(Thread);
@@ -666,68 +694,133 @@ namespace UnLua
         lua_pop(L, 1);
     }
 
-    void FLuaEnv::OnAsyncLoadingFlushUpdate()
+    void FLuaEnv::EnqueueBindCandidate(UObject* Object)
     {
-        TArray<FWeakObjectPtr> CandidatesTemp;
-        TArray<int> CandidatesRemovedIndexes;
+        CandidateQueue.Enqueue(FWeakObjectPtr(Object));
+    }
 
-        TArray<UObject*> LocalCandidates;
+    bool FLuaEnv::IsReadyToBind(const UObject* Object) const
+    {
+        return !Object->HasAnyFlags(RF_NeedPostLoad)
+            && !Object->HasAnyInternalFlags(AsyncObjectFlags)
+            && !Object->GetClass()->HasAnyInternalFlags(AsyncObjectFlags);
+    }
+
+    void FLuaEnv::DequeueBindCandidates(TArray<UObject*>& OutReady)
+    {
+        // 新的候选对象只在出队时检查一次，未就绪的按Package暂存
+        FWeakObjectPtr ObjectPtr;
+        while (CandidateQueue.Dequeue(ObjectPtr))
         {
-            {
-                FScopeLock Lock(&CandidatesLock);
-                CandidatesTemp.Append(Candidates);
-            }
+            UObject* Object = ObjectPtr.Get();
+            if (!Object)
+                continue;
 
+            bool bAlreadyQueued;
+            PendingCandidateSet.Add(ObjectPtr, &bAlreadyQueued);
+            if (bAlreadyQueued)
+                continue;
 
-            for (int32 i = CandidatesTemp.Num() - 1; i >= 0; --i)
-            {
-                FWeakObjectPtr ObjectPtr = CandidatesTemp[i];
-                if (!ObjectPtr.IsValid())
-                {
-                    // discard invalid objects
-                    CandidatesRemovedIndexes.Add(i);
-                    continue;
-                }
-
-                UObject* Object = ObjectPtr.Get();
-                if (Object->HasAnyFlags(RF_NeedPostLoad)
-                    || Object->HasAnyInternalFlags(AsyncObjectFlags)
-                    || Object->GetClass()->HasAnyInternalFlags(AsyncObjectFlags))
-                {
-                    // delay bind on next update 
-                    continue;
-                }
-
-                LocalCandidates.Add(Object);
-                CandidatesRemovedIndexes.Add(i);
-            }
+            if (IsReadyToBind(Object))
+                OutReady.Add(Object);
+            else
+                PendingCandidates.FindOrAdd(Object->GetOutermost()).Add(ObjectPtr);
         }
+    }
 
+    bool FLuaEnv::CollectReadyCandidates(TArray<FWeakObjectPtr>& Objects, TArray<UObject*>& OutReady)
+    {
+        // 入队顺序不等于PostLoad的完成顺序，未就绪的对象继续暂存，不阻塞同一个Package中的其他对象
+        Objects.RemoveAll([&](const FWeakObjectPtr& ObjectPtr)
         {
-            FScopeLock Lock(&CandidatesLock);
-            for (int32 j = 0; j < CandidatesRemovedIndexes.Num(); ++j)
+            UObject* Object = ObjectPtr.Get();
+            if (!Object)
             {
-                Candidates.RemoveAt(CandidatesRemovedIndexes[j]);
+                // discard invalid objects
+                PendingCandidateSet.Remove(ObjectPtr);
+                return true;
             }
-        }
 
-        for (int32 i = 0; i < LocalCandidates.Num(); ++i)
+            if (!IsReadyToBind(Object))
+                return false;
+
+            OutReady.Add(Object);
+            return true;
+        });
+        return Objects.Num() == 0;
+    }
+
+    void FLuaEnv::BindCandidates(const TArray<UObject*>& Candidates)
+    {
+        for (UObject* Object : Candidates)
         {
-            UObject* Object = LocalCandidates[i];
+            PendingCandidateSet.Remove(FWeakObjectPtr(Object));
             TryBind(Object);
         }
     }
 
+    void FLuaEnv::OnAsyncLoadingFlushUpdate()
+    {
+        TArray<UObject*> LocalCandidates;
+
+#if !UNLUA_WITH_END_LOAD_PACKAGE
+        // 没有Package加载完成的通知，只能每次都重新检查暂存的对象
+        for (auto It = PendingCandidates.CreateIterator(); It; ++It)
+        {
+            if (CollectReadyCandidates(It.Value(), LocalCandidates))
+                It.RemoveCurrent();
+        }
+#endif
+
+        DequeueBindCandidates(LocalCandidates);
+        BindCandidates(LocalCandidates);
+    }
+
+#if UNLUA_WITH_END_LOAD_PACKAGE
+    void FLuaEnv::OnEndLoadPackage(const FEndLoadPackageContext& Context)
+    {
+        TArray<UObject*> LocalCandidates;
+
+        // 先收下还在队列里的对象，再只检查加载完成的Package中暂存的对象
+        DequeueBindCandidates(LocalCandidates);
+        for (const UPackage* Package : Context.LoadedPackages)
+        {
+            TArray<FWeakObjectPtr>* Objects = PendingCandidates.Find(Package);
+            if (Objects && CollectReadyCandidates(*Objects, LocalCandidates))
+                PendingCandidates.Remove(Package);
+        }
+
+        BindCandidates(LocalCandidates);
+    }
+#endif
+
     FORCEINLINE void FLuaEnv::RegisterDelegates()
     {
         OnAsyncLoadingFlushUpdateHandle = FCoreDelegates::OnAsyncLoadingFlushUpdate.AddRaw(this, &FLuaEnv::OnAsyncLoadingFlushUpdate);
+#if UNLUA_WITH_END_LOAD_PACKAGE
+        OnEndLoadPackageHandle = FCoreUObjectDelegates::OnEndLoadPackage.AddRaw(this, &FLuaEnv::OnEndLoadPackage);
+#endif
         GUObjectArray.AddUObjectDeleteListener(this);
         bObjectArrayListenerRegistered = true;
+#if WITH_EDITOR
+        // 蓝图重新编译后类会被重新实例化，GetModuleName的结果可能变化
+        OnObjectsReplacedHandle = FCoreUObjectDelegates::OnObjectsReplaced.AddLambda([this](const TMap<UObject*, UObject*>&)
+        {
+            if (ModuleLocator)
+                ModuleLocator->InvalidateCache();
+        });
+#endif
     }
 
     FORCEINLINE void FLuaEnv::UnRegisterDelegates()
     {
         FCoreDelegates::OnAsyncLoadingFlushUpdate.Remove(OnAsyncLoadingFlushUpdateHandle);
+#if UNLUA_WITH_END_LOAD_PACKAGE
+        FCoreUObjectDelegates::OnEndLoadPackage.Remove(OnEndLoadPackageHandle);
+#endif
+#if WITH_EDITOR
+        FCoreUObjectDelegates::OnObjectsReplaced.Remove(OnObjectsReplacedHandle);
+#endif
         if (!bObjectArrayListenerRegistered)
             return;
         GUObjectArray.RemoveUObjectDeleteListener(this);
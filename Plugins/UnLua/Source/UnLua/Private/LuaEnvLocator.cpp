@@ -32,6 +32,13 @@ void ULuaEnvLocator::HotReload()
     Env->HotReload();
 }
 
+void ULuaEnvLocator::HotReload(const TArray<FString>& ModuleNames)
+{
+    if (!Env)
+        return;
+    Env->HotReload(ModuleNames);
+}
+
 void ULuaEnvLocator::Reset()
 {
     Env.Reset();
@@ -81,6 +88,14 @@ void ULuaEnvLocator_ByGameInstance::HotReload()
         Pair.Value->HotReload();
 }
 
+void ULuaEnvLocator_ByGameInstance::HotReload(const TArray<FString>& ModuleNames)
+{
+    if (Env)
+        Env->HotReload(ModuleNames);
+    for (const auto& Pair : Envs)
+        Pair.Value->HotReload(ModuleNames);
+}
+
 void ULuaEnvLocator_ByGameInstance::Reset()
 {
     Env.Reset();
@@ -136,6 +136,28 @@ void ULuaFunction::Initialize()
     Desc = MakeShared<FFunctionDesc>(this, nullptr);
 }
 
+void ULuaFunction::ShareLayout(UFunction* Function)
+{
+    FunctionFlags = Function->FunctionFlags;
+    NumParms = Function->NumParms;
+    ParmsSize = Function->ParmsSize;
+    ReturnValueOffset = Function->ReturnValueOffset;
+    RPCId = Function->RPCId;
+    RPCResponseId = Function->RPCResponseId;
+    FirstPropertyToInit = Function->FirstPropertyToInit;
+
+    PropertiesSize = Function->PropertiesSize;
+    MinAlignment = Function->MinAlignment;
+    Children = Function->Children;
+    ChildProperties = Function->ChildProperties;
+    PropertyLink = Function->PropertyLink;
+    RefLink = Function->RefLink;
+    DestructorLink = Function->DestructorLink;
+    PostConstructLink = Function->PostConstructLink;
+
+    bSharedLayout = true;
+}
+
 void ULuaFunction::Override(UFunction* Function, UClass* Class, bool bAddNew)
 {
     check(Function && Class && !From.IsValid());
@@ -154,16 +176,15 @@ void ULuaFunction::Override(UFunction* Function, UClass* Class, bool bAddNew)
         const auto LuaFunction = Get(Function);
         Overridden = LuaFunction->GetOverridden();
         check(Overridden);
+        OverriddenNativeFunc = Overridden->GetNativeFunc();
+        OverriddenFunctionFlags = Overridden->FunctionFlags;
     }
     else
     {
-        const auto DestName = FString::Printf(TEXT("%s__Overridden"), *Function->GetName());
-        if (Function->HasAnyFunctionFlags(FUNC_Native))
-            GetOuterUClass()->AddNativeFunction(*DestName, *Function->GetNativeFunc());
-        Overridden = static_cast<UFunction*>(StaticDuplicateObject(Function, GetOuter(), *DestName));
-        Overridden->ClearInternalFlags(EInternalObjectFlags::Native);
-        Overridden->StaticLink(true);
-        Overridden->SetNativeFunc(Function->GetNativeFunc());
+        // 只记下原函数的入口，副本等到需要调用原函数时再创建
+        Overridden = nullptr;
+        OverriddenNativeFunc = Function->GetNativeFunc();
+        OverriddenFunctionFlags = Function->FunctionFlags;
     }
 
     SetActive(true);
@@ -182,9 +203,9 @@ void ULuaFunction::Restore()
         if (!Old)
             return;
         Old->Script = Script;
-        Old->SetNativeFunc(Overridden->GetNativeFunc());
-        Old->GetOuterUClass()->AddNativeFunction(*Old->GetName(), Overridden->GetNativeFunc());
-        Old->FunctionFlags = Overridden->FunctionFlags;
+        Old->SetNativeFunc(OverriddenNativeFunc);
+        Old->GetOuterUClass()->AddNativeFunction(*Old->GetName(), OverriddenNativeFunc);
+        Old->FunctionFlags = OverriddenFunctionFlags;
     }
 }
 
@@ -251,9 +272,9 @@ void ULuaFunction::SetActive(const bool bActive)
             ChildProperties = nullptr;
 
             Function->Script = Script;
-            Function->SetNativeFunc(Overridden->GetNativeFunc());
-            Function->GetOuterUClass()->AddNativeFunction(*Function->GetName(), Overridden->GetNativeFunc());
-            Function->FunctionFlags = Overridden->FunctionFlags;
+            Function->SetNativeFunc(OverriddenNativeFunc);
+            Function->GetOuterUClass()->AddNativeFunction(*Function->GetName(), OverriddenNativeFunc);
+            Function->FunctionFlags = OverriddenFunctionFlags;
         }
     }
     
@@ -262,16 +283,48 @@ void ULuaFunction::SetActive(const bool bActive)
 
 void ULuaFunction::FinishDestroy()
 {
-    if (bActivated && !bAdded)
+    if (bSharedLayout || (bActivated && !bAdded))
     {
+        // 属性链属于原函数，不能随ULuaFunction一起销毁
         Children = nullptr;
         ChildProperties = nullptr;
+        PropertyLink = nullptr;
+        RefLink = nullptr;
+        DestructorLink = nullptr;
+        PostConstructLink = nullptr;
     }
     UFunction::FinishDestroy();
 }
 
-UFunction* ULuaFunction::GetOverridden() const
+UFunction* ULuaFunction::GetOverridden()
 {
+    if (Overridden)
+        return Overridden;
+
+    const auto Function = From.Get();
+    if (!Function)
+        return nullptr;
+
+    // 就地覆写后原函数的标记和字节码已经被替换，复制时先换回原来的
+    const auto DestName = FString::Printf(TEXT("%s__Overridden"), *Function->GetName());
+    if (OverriddenFunctionFlags & FUNC_Native)
+        GetOuterUClass()->AddNativeFunction(*DestName, OverriddenNativeFunc);
+    const auto CurrentFunctionFlags = Function->FunctionFlags;
+    Function->FunctionFlags = OverriddenFunctionFlags;
+    Overridden = static_cast<UFunction*>(StaticDuplicateObject(Function, GetOuter(), *DestName));
+    Function->FunctionFlags = CurrentFunctionFlags;
+
+    Overridden->ClearInternalFlags(EInternalObjectFlags::Native);
+    Overridden->StaticLink(true);
+    Overridden->FunctionFlags = OverriddenFunctionFlags;
+    Overridden->SetNativeFunc(OverriddenNativeFunc);
+    if (!bAdded)
+        Overridden->Script = Script;
+
+    if (IsRooted())
+        Overridden->AddToRoot();
+    else if (const auto Class = GetOverriddenUClass())
+        Overridden->AddToCluster(Class);
     return Overridden;
 }
 
@@ -282,7 +335,7 @@ void ULuaFunction::Bind()
         if (bAdded)
             SetNativeFunc(execCallLua);
         else
-            SetNativeFunc(Overridden->GetNativeFunc());
+            SetNativeFunc(OverriddenNativeFunc);
     }
     else
     {
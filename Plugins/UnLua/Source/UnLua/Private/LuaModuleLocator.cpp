@@ -42,14 +42,57 @@ FString ULuaModuleLocator::Locate(const UObject* Object)
     return IUnLuaInterface::Execute_GetModuleName(CDO);
 }
 
-FString ULuaModuleLocator_ByPackage::Locate(const UObject* Object)
+TSharedPtr<const FString> ULuaModuleLocator::LocateCached(const UObject* Object)
 {
+    if (!IsCacheableByClass())
+    {
+        const auto ModuleName = Locate(Object);
+        return ModuleName.IsEmpty() ? nullptr : MakeShared<const FString>(ModuleName);
+    }
+
     const auto Class = Object->IsA<UClass>() ? static_cast<const UClass*>(Object) : Object->GetClass();
-    const auto Key = Class->GetFName();
-    const auto Cached = Cache.Find(Key);
-    if (Cached)
-        return *Cached;
+    const auto Cached = ModuleNameCache.Find(Class);
+    if (Cached && Cached->Class.Get() == Class)
+        return Cached->ModuleName;
+
+    const auto CDO = Class->GetDefaultObject(false);
+    const auto ModuleName = Locate(Object);
+    if (!CDO || CDO->HasAnyFlags(RF_NeedInitialization))
+    {
+        // CDO还没有初始化完成，结果不可靠，不缓存
+        return ModuleName.IsEmpty() ? nullptr : MakeShared<const FString>(ModuleName);
+    }
+
+    return AddToCache(Class, ModuleName);
+}
+
+void ULuaModuleLocator::InvalidateCache()
+{
+    ModuleNameCache.Empty();
+}
 
+bool ULuaModuleLocator::CanLocateConcurrently() const
+{
+    return GetClass() == ULuaModuleLocator_ByPackage::StaticClass();
+}
+
+TSharedPtr<const FString> ULuaModuleLocator::AddToCache(const UClass* Class, const FString& ModuleName)
+{
+    auto& Entry = ModuleNameCache.FindOrAdd(Class);
+    Entry.Class = Class;
+    Entry.ModuleName = ModuleName.IsEmpty() ? nullptr : MakeShared<const FString>(ModuleName);
+    return Entry.ModuleName;
+}
+
+bool ULuaModuleLocator::IsCacheableByClass() const
+{
+    const auto Class = GetClass();
+    return Class == ULuaModuleLocator::StaticClass() || Class == ULuaModuleLocator_ByPackage::StaticClass();
+}
+
+FString ULuaModuleLocator_ByPackage::Locate(const UObject* Object)
+{
+    const auto Class = Object->IsA<UClass>() ? static_cast<const UClass*>(Object) : Object->GetClass();
     FString ModuleName;
     if (Class->IsNative())
     {
@@ -61,6 +104,5 @@ FString ULuaModuleLocator_ByPackage::Locate(const UObject* Object)
         const auto ChopCount = ModuleName.Find(TEXT("/"), ESearchCase::IgnoreCase, ESearchDir::FromStart, 1) + 1;
         ModuleName = ModuleName.Replace(TEXT("/"), TEXT(".")).RightChop(ChopCount);
     }
-    Cache.Add(Key, ModuleName);
     return ModuleName;
 }
@@ -53,24 +53,46 @@ namespace UnLua
                 LuaFunction->Initialize();
                 return;
             }
+
+            // 同一个UClass被重复绑定时（例如新的Lua环境或热重载）复用已经创建的ULuaFunction
+            LuaFunction = ULuaFunction::Get(Function);
+            if (LuaFunction && LuaFunction->GetOuter() == OverridesClass)
+            {
+                LuaFunction->Initialize();
+                return;
+            }
+        }
+
+        if (Function->IsNative())
+        {
+            // 原生函数与所在的类一样常驻，无论就地覆写还是添加到子类上，都只共享原函数的属性链和参数布局
+            LuaFunction = NewObject<ULuaFunction>(OverridesClass, NewName, RF_Public | RF_Transient);
+            LuaFunction->ShareLayout(Function);
+
+            LuaFunction->Next = OverridesClass->Children;
+            OverridesClass->Children = LuaFunction;
         }
+        else
+        {
+            // 蓝图函数可能被重新编译或销毁，需要持有自己的属性链
+            const auto OriginalFunctionFlags = Function->FunctionFlags;
+            Function->FunctionFlags &= (~EFunctionFlags::FUNC_Native);
 
-        const auto OriginalFunctionFlags = Function->FunctionFlags;
-        Function->FunctionFlags &= (~EFunctionFlags::FUNC_Native);
+            FObjectDuplicationParameters DuplicationParams(Function, OverridesClass);
+            DuplicationParams.InternalFlagMask &= ~EInternalObjectFlags::Native;
+            DuplicationParams.DestName = NewName;
+            DuplicationParams.DestClass = ULuaFunction::StaticClass();
+            LuaFunction = static_cast<ULuaFunction*>(StaticDuplicateObjectEx(DuplicationParams));
 
-        FObjectDuplicationParameters DuplicationParams(Function, OverridesClass);
-        DuplicationParams.InternalFlagMask &= ~EInternalObjectFlags::Native;
-        DuplicationParams.DestName = NewName;
-        DuplicationParams.DestClass = ULuaFunction::StaticClass();
-        LuaFunction = static_cast<ULuaFunction*>(StaticDuplicateObjectEx(DuplicationParams));
+            Function->FunctionFlags = OriginalFunctionFlags;
+            LuaFunction->FunctionFlags = OriginalFunctionFlags;
 
-        Function->FunctionFlags = OriginalFunctionFlags;
-        LuaFunction->FunctionFlags = OriginalFunctionFlags;
+            LuaFunction->Next = OverridesClass->Children;
+            OverridesClass->Children = LuaFunction;
 
-        LuaFunction->Next = OverridesClass->Children;
-        OverridesClass->Children = LuaFunction;
+            LuaFunction->StaticLink(true);
+        }
 
-        LuaFunction->StaticLink(true);
         LuaFunction->Initialize();
         LuaFunction->Override(Function, Class, bAddNew);
         LuaFunction->Bind();
@@ -307,7 +307,8 @@ namespace UnLua
     {
         static T* GetResult(lua_State* L, T* A)
         {
-            void* Userdata = NewUserdataWithPadding(L, sizeof(T), UnLua::TType<T>::GetName(), CalcUserdataPadding<T>());
+            bool bRecycled;
+            void* Userdata = NewStructUserdata(L, sizeof(T), UnLua::TType<T>::GetName(), CalcUserdataPadding<T>(), bRecycled);
             T* V = new(Userdata) T;
             return V;
         }
@@ -27,7 +27,7 @@
  * Class descriptor constructor
  */
 FClassDesc::FClassDesc(UnLua::FLuaEnv* Env, UStruct* InStruct, const FString& InName)
-    : Struct(InStruct), ClassName(InName), UserdataPadding(0), Size(0), Env(Env), FunctionCollection(nullptr)
+    : Struct(InStruct), ClassName(InName), UserdataPadding(0), Size(0), Env(Env)
 {
     RawStructPtr = InStruct;
     bIsScriptStruct = InStruct->IsA(UScriptStruct::StaticClass());
@@ -38,7 +38,6 @@ FClassDesc::FClassDesc(UnLua::FLuaEnv* Env, UStruct* InStruct, const FString& In
     if (bIsClass)
     {
         Size = Struct->GetStructureSize();
-        FunctionCollection = GDefaultParamCollection.Find(*ClassName);
     }
     else if (bIsScriptStruct)
     {
@@ -135,7 +134,7 @@ TSharedPtr<FFieldDesc> FClassDesc::RegisterField(FName FieldName, FClassDesc* Qu
     else
     {
         check(Function);
-        FParameterCollection* DefaultParams = FunctionCollection ? FunctionCollection->Functions.Find(FieldName) : nullptr;
+        FParameterCollection* DefaultParams = bIsClass ? FindDefaultParamCollection(ClassName, FieldName) : nullptr;
         FieldDesc->FieldIndex = Functions.Add(MakeShared<FFunctionDesc>(Function, DefaultParams)); // index of function descriptor
         ++FieldDesc->FieldIndex;
         FieldDesc->FieldIndex = -FieldDesc->FieldIndex;
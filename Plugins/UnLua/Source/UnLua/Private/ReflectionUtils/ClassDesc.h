@@ -104,6 +104,4 @@ private:
     TArray<TSharedPtr<FFunctionDesc>> Functions;
     TArray<FClassDesc*> SuperClasses;
     UnLua::FLuaEnv* Env;
-
-    struct FFunctionCollection *FunctionCollection;
 };
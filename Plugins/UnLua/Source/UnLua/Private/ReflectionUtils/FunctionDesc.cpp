@@ -80,6 +80,7 @@ void FFunctionDesc::CallLua(lua_State* L, lua_Integer FunctionRef, lua_Integer S
 #if ENABLE_UNREAL_INSIGHTS && CPUPROFILERTRACE_ENABLED
     TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*FuncName);
 #endif
+    const uint64 StartCycles = UnLua::FCallStats::IsEnabled() ? FPlatformTime::Cycles64() : 0;
     
     lua_pushcfunction(L, UnLua::ReportLuaCallError);
     check(Function.IsValid());
@@ -143,13 +144,17 @@ void FFunctionDesc::CallLua(lua_State* L, lua_Integer FunctionRef, lua_Integer S
         InParms = Stack.Locals;
     }
 
-    CallLuaInternal(L, InParms , OutParms, RESULT_PARAM);
+    uint64 LuaCycles = 0;
+    CallLuaInternal(L, InParms , OutParms, RESULT_PARAM, StartCycles ? &LuaCycles : nullptr);
 
     if (bUnpackParams && InParms)
         Buffer->Pop(InParms);
+
+    if (StartCycles)
+        RecordStats(CallLuaStats, TEXT("Lua"), StartCycles, LuaCycles);
 }
 
-bool FFunctionDesc::CallLua(lua_State* L, int32 LuaRef, void* Params, UObject* Self)
+bool FFunctionDesc::CallLua(lua_State* L, int32 LuaRef, void* Params, UObject* Self, uint64* OutLuaCycles)
 {
 #if ENABLE_UNREAL_INSIGHTS && CPUPROFILERTRACE_ENABLED
     TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*FuncName);
@@ -161,7 +166,7 @@ bool FFunctionDesc::CallLua(lua_State* L, int32 LuaRef, void* Params, UObject* S
 
     const bool bHasReturnParam = Function->ReturnValueOffset != MAX_uint16;
     uint8* ReturnValueAddress = bHasReturnParam ? ((uint8*)Params + Function->ReturnValueOffset) : nullptr;
-    bOk = CallLuaInternal(L, Params, nullptr, ReturnValueAddress);
+    bOk = CallLuaInternal(L, Params, nullptr, ReturnValueAddress, OutLuaCycles);
     return bOk;
 }
 
@@ -175,6 +180,7 @@ int32 FFunctionDesc::CallUE(lua_State *L, int32 NumParams, void *Userdata)
 #endif
 
     check(Function.IsValid());
+    const uint64 StartCycles = UnLua::FCallStats::IsEnabled() ? FPlatformTime::Cycles64() : 0;
 
     UObject* Object;
     int32 FirstParamIndex;
@@ -222,6 +228,7 @@ int32 FFunctionDesc::CallUE(lua_State *L, int32 NumParams, void *Userdata)
     // call the UFuncton...
     // Func_NetMuticast both remote and local
     // local automatic checked remote and local,so local first
+    const uint64 CalleeStartCycles = StartCycles ? FPlatformTime::Cycles64() : 0;
     if (bLocal)
     {   
         Object->UObject::ProcessEvent(FinalFunction, Params);
@@ -230,9 +237,13 @@ int32 FFunctionDesc::CallUE(lua_State *L, int32 NumParams, void *Userdata)
     {
         Object->CallRemoteFunction(FinalFunction, Params, nullptr, nullptr);
     }
+    const uint64 CalleeCycles = StartCycles ? FPlatformTime::Cycles64() - CalleeStartCycles : 0;
 
     int32 NumReturnValues = PostCall(L, NumParams, FirstParamIndex, Params, CleanupFlags);      // push 'out' properties to Lua stack
     Buffer->Pop(Params);
+
+    if (StartCycles)
+        RecordStats(CallUEStats, TEXT("UE"), StartCycles, CalleeCycles);
     return NumReturnValues;
 }
 
@@ -309,7 +320,7 @@ void FFunctionDesc::PreCall(lua_State* L, int32 NumParams, int32 FirstParamIndex
         if (ParamIndex < NumParams)
         {   
 #if ENABLE_TYPE_CHECK == 1
-            FString ErrorMsg = "";
+            FString ErrorMsg;
             if (Property->CheckPropertyType(L, FirstParamIndex + ParamIndex, ErrorMsg))
                 CleanupFlags[i] = Property->WriteValue_InContainer(L, Params, FirstParamIndex + ParamIndex, false);
             else
@@ -334,7 +345,7 @@ void FFunctionDesc::PreCall(lua_State* L, int32 NumParams, int32 FirstParamIndex
             else
             {
 #if ENABLE_TYPE_CHECK == 1
-                FString ErrorMsg = "";
+                FString ErrorMsg;
                 if (!Property->CheckPropertyType(L, FirstParamIndex + ParamIndex, ErrorMsg))
                 {
                     UNLUA_LOGERROR(L, LogUnLua, Warning, TEXT("Invalid parameter type calling ufunction : %s,parameter : %d, error msg : %s"), *FuncName, ParamIndex, *ErrorMsg);
@@ -428,7 +439,7 @@ static FOutParmRec* FindOutParmRec(FOutParmRec *OutParam, FProperty *OutProperty
 /**
  * Call Lua function that overrides this UFunction. 
  */
-bool FFunctionDesc::CallLuaInternal(lua_State *L, void *InParams, FOutParmRec *OutParams, void *RetValueAddress) const
+bool FFunctionDesc::CallLuaInternal(lua_State *L, void *InParams, FOutParmRec *OutParams, void *RetValueAddress, uint64* OutLuaCycles) const
 {
     // -1 = [table/userdata] UObject for self
     // -2 = [function] to call
@@ -456,7 +467,11 @@ bool FFunctionDesc::CallLuaInternal(lua_State *L, void *InParams, FOutParmRec *O
         NumParams++;
 
     const auto Guard = Env.GetDeadLoopCheck()->MakeGuard();
-    if (lua_pcall(L, NumParams, LUA_MULTRET, -(NumParams + 2)) != LUA_OK)
+    const uint64 LuaStartCycles = OutLuaCycles ? FPlatformTime::Cycles64() : 0;
+    const int32 Status = lua_pcall(L, NumParams, LUA_MULTRET, -(NumParams + 2));
+    if (OutLuaCycles)
+        *OutLuaCycles = FPlatformTime::Cycles64() - LuaStartCycles;
+    if (Status != LUA_OK)
     {
         lua_settop(L, ErrorHandlerIndex - 1);
         return false;
@@ -527,6 +542,16 @@ bool FFunctionDesc::CallLuaInternal(lua_State *L, void *InParams, FOutParmRec *O
     return true;
 }
 
+void FFunctionDesc::RecordStats(UnLua::FCallStats& Stats, const TCHAR* Kind, uint64 StartCycles, uint64 CalleeCycles)
+{
+    if (!Stats.IsRegistered())
+    {
+        const UObject* Outer = Function.IsValid() ? Function->GetOuter() : nullptr;
+        Stats.Register(Kind, Outer ? FString::Printf(TEXT("%s.%s"), *Outer->GetName(), *FuncName) : FuncName);
+    }
+    Stats.Record(FPlatformTime::Cycles64() - StartCycles, CalleeCycles);
+}
+
 bool FFunctionDesc::CheckObject(UObject* Object, FString& Error) const
 {
     if (Object == UnLua::LowLevel::ReleasedPtr)
@@ -554,24 +579,23 @@ bool FFunctionDesc::CheckObject(UObject* Object, FString& Error) const
     }
 
 #if ENABLE_TYPE_CHECK && WITH_EDITOR
+    UClass* Class = Object->GetClass();
+    if (Class == CheckedClass.Get())
+        return true;
+
     const auto LuaFunction = ULuaFunction::Get(Function.Get());
     const auto TargetClass = LuaFunction && LuaFunction->GetOverridden()
                            ? LuaFunction->GetOverriddenUClass()
                            : Function->GetOwnerClass();
 
-    if (bInterfaceFunc)
-    {
-        if (Object->GetClass()->ImplementsInterface(TargetClass))
-            return true;
-    }
-    else
+    if (bInterfaceFunc ? Class->ImplementsInterface(TargetClass) : Class->IsChildOf(TargetClass))
     {
-        if (Object->IsA(TargetClass))
-            return true;
+        CheckedClass = Class;
+        return true;
     }
 
     Error = FString::Printf(TEXT("attempt to call UFunction '%s' on invalid self type. '%s' required but got '%s'."),
-                            *FuncName, *TargetClass->GetName(), *Object->GetClass()->GetName());
+                            *FuncName, *TargetClass->GetName(), *Class->GetName());
     return false;
 #else
     return true;
@@ -16,6 +16,7 @@
 
 #include "Containers/StaticBitArray.h"
 #include "lua.hpp"
+#include "CallStats.h"
 #include "ParamBufferAllocator.h"
 #include "Registries/FunctionRegistry.h"
 #include "ReflectionUtils/PropertyDesc.h"
@@ -76,7 +77,7 @@ public:
  
     void CallLua(lua_State* L, lua_Integer FunctionRef, lua_Integer SelfRef, FFrame& Stack, RESULT_DECL);
  
-    bool CallLua(lua_State* L, int32 LuaRef, void* Params, UObject* Self);
+    bool CallLua(lua_State* L, int32 LuaRef, void* Params, UObject* Self, uint64* OutLuaCycles = nullptr);
  
     /**
      * Call this UFunction
@@ -111,7 +112,9 @@ private:
     void PreCall(lua_State* L, int32 NumParams, int32 FirstParamIndex, FFlagArray& CleanupFlags, void* Params, void* Userdata = nullptr);
     int32 PostCall(lua_State* L, int32 NumParams, int32 FirstParamIndex, void* Params, const FFlagArray& CleanupFlags);
 
-    bool CallLuaInternal(lua_State *L, void *InParams, FOutParmRec *OutParams, void *RetValueAddress) const;
+    bool CallLuaInternal(lua_State *L, void *InParams, FOutParmRec *OutParams, void *RetValueAddress, uint64* OutLuaCycles = nullptr) const;
+
+    void RecordStats(UnLua::FCallStats& Stats, const TCHAR* Kind, uint64 StartCycles, uint64 CalleeCycles);
 
     FORCEINLINE bool CheckObject(UObject* Object, FString& Error) const;
 
@@ -127,4 +130,9 @@ private:
     uint8 bInterfaceFunc : 1;
     int32 ParmsSize;
     TUniquePtr<FTCHARToUTF8> LuaFunctionName;
+    UnLua::FCallStats CallLuaStats;     // 覆写的函数被调用
+    UnLua::FCallStats CallUEStats;      // Lua调用UFunction
+#if ENABLE_TYPE_CHECK && WITH_EDITOR
+    mutable TWeakObjectPtr<UClass> CheckedClass;    // 上次通过self类型检查的类
+#endif
 };
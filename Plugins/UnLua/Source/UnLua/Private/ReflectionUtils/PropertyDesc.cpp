@@ -21,6 +21,34 @@
 #include "Containers/LuaMap.h"
 #include "ObjectReferencer.h"
 
+#if ENABLE_TYPE_CHECK == 1
+/**
+ * 比较Index处userdata元表上缓存的类型ID，只在检查失败时构造错误信息
+ */
+static bool CheckUserdataTypeId(lua_State* L, int32 Index, int32 ExpectedTypeId, FString& ErrorMsg)
+{
+    const int32 TypeId = UnLua::LowLevel::GetTypeId(L, Index);
+    if (LIKELY(TypeId == ExpectedTypeId))
+        return true;
+
+    if (TypeId == 0)
+    {
+        if (lua_getmetatable(L, Index))
+        {
+            lua_pop(L, 1);
+            ErrorMsg = TEXT("metatable name of userdata needed but got nil");
+        }
+        else
+        {
+            ErrorMsg = TEXT("metatable of userdata needed but got nil");
+        }
+    }
+    else
+        ErrorMsg = FString::Printf(TEXT("metatable name of userdata %s needed but got %s"), *UnLua::LowLevel::GetTypeName(ExpectedTypeId), *UnLua::LowLevel::GetTypeName(TypeId));
+    return false;
+}
+#endif
+
 FPropertyDesc::FPropertyDesc(FProperty *InProperty) : Property(InProperty) 
 {
     PropertyType = CPT_None;
@@ -500,26 +528,9 @@ public:
                 return false;
             }
 
-            if (1 != lua_getmetatable(L, IndexInStack))
-            {
-                ErrorMsg = FString::Printf(TEXT("metatable of userdata is needed but got nil"));
-                return false;
-            }
-
-            lua_pushstring(L, "__name");
-            lua_rawget(L, -2);
-            FString MetatableName = lua_tostring(L, -1);
-            if (MetatableName.IsEmpty())
-            {
-                ErrorMsg = FString::Printf(TEXT("metatable name of userdata needed but got nil"));
-                return false;
-            }
-
-            if (!MetatableName.Equals("FSoftObjectPtr"))
-            {
-                ErrorMsg = FString::Printf(TEXT("metatable name of userdata FSoftObjectPtr needed but got %s"), *MetatableName);
+            static const int32 SoftObjectPtrTypeId = UnLua::LowLevel::GetTypeId("FSoftObjectPtr");
+            if (!CheckUserdataTypeId(L, IndexInStack, SoftObjectPtrTypeId, ErrorMsg))
                 return false;
-            }
         }
 
         return true;
@@ -841,21 +852,9 @@ public:
 
             if (Type == LUA_TUSERDATA)
             {
-                int32 RetValue = lua_getmetatable(L, IndexInStack);
-                if (RetValue != 1)
-                {
-                    ErrorMsg = FString::Printf(TEXT("metatable of userdata needed but got nil"));
-                    return false;
-                }
-
-                lua_pushstring(L, "__name");
-                lua_rawget(L, -2);
-                FString MetatableName = lua_tostring(L, -1);
-                if (MetatableName.IsEmpty() || !MetatableName.Equals("TArray"))
-                {
-                    ErrorMsg = FString::Printf(TEXT("metatable name of userdata TArray needed but got %s"), *MetatableName);
+                static const int32 ArrayTypeId = UnLua::LowLevel::GetTypeId("TArray");
+                if (!CheckUserdataTypeId(L, IndexInStack, ArrayTypeId, ErrorMsg))
                     return false;
-                }
             }
         }
 
@@ -976,21 +975,9 @@ public:
 
             if (Type == LUA_TUSERDATA)
             {
-                int32 RetValue = lua_getmetatable(L, IndexInStack);
-                if (RetValue != 1)
-                {
-                    ErrorMsg = FString::Printf(TEXT("metatable of userdata needed but got nil"));
-                    return false;
-                }
-
-                lua_pushstring(L, "__name");
-                lua_rawget(L, -2);
-                FString MetatableName = lua_tostring(L, -1);
-                if (MetatableName.IsEmpty() || !MetatableName.Equals("TMap"))
-                {
-                    ErrorMsg = FString::Printf(TEXT("metatable name of userdata TMap needed but got %s"), *MetatableName);
+                static const int32 MapTypeId = UnLua::LowLevel::GetTypeId("TMap");
+                if (!CheckUserdataTypeId(L, IndexInStack, MapTypeId, ErrorMsg))
                     return false;
-                }
             }
         }
 
@@ -1114,21 +1101,9 @@ public:
 
             if (Type == LUA_TUSERDATA)
             {
-                int32 RetValue = lua_getmetatable(L, IndexInStack);
-                if (RetValue != 1)
-                {
-                    ErrorMsg = FString::Printf(TEXT("metatable of userdata needed but got nil"));
+                static const int32 SetTypeId = UnLua::LowLevel::GetTypeId("TSet");
+                if (!CheckUserdataTypeId(L, IndexInStack, SetTypeId, ErrorMsg))
                     return false;
-                }
-
-                lua_pushstring(L, "__name");
-                lua_rawget(L, -2);
-                FString MetatableName = lua_tostring(L, -1);
-                if (MetatableName.IsEmpty() || !MetatableName.Equals("TSet"))
-                {
-                    ErrorMsg = FString::Printf(TEXT("metatable name of userdata TSet needed but got %s"), *MetatableName);
-                    return false;
-                }
             }
         }
 
@@ -1187,6 +1162,9 @@ public:
         const auto CppStructOps = ScriptStruct->GetCppStructOps();
         StructSize = CppStructOps ? CppStructOps->GetSize() : ScriptStruct->GetStructureSize();
         UserdataPadding = UnLua::LowLevel::CalculateUserdataPadding(StructProperty->Struct);
+#if ENABLE_TYPE_CHECK == 1
+        AcceptedTypeIds.Add(UnLua::LowLevel::GetTypeId(StructName.Get()));
+#endif
     }
 
     virtual int32 GetSize() const override
@@ -1220,8 +1198,10 @@ public:
     {
         if (bCreateCopy)
         {
-            void *Userdata = NewUserdataWithPadding(L, StructSize, StructName.Get(), UserdataPadding);
-            StructProperty->InitializeValue(Userdata);
+            bool bRecycled;
+            void *Userdata = NewStructUserdata(L, StructSize, StructName.Get(), UserdataPadding, bRecycled);
+            if (!bRecycled)
+                StructProperty->InitializeValue(Userdata);
             StructProperty->CopySingleValue(Userdata, ValuePtr);
         }
         else
@@ -1267,6 +1247,11 @@ public:
                 ErrorMsg = FString::Printf(TEXT("userdata needed but got %s"), UTF8_TO_TCHAR(lua_typename(L, Type)));
                 return false;
             }
+            // 已接受过的类型（含子类）直接比较类型ID
+            const int32 TypeId = UnLua::LowLevel::GetTypeId(L, IndexInStack);
+            if (TypeId && AcceptedTypeIds.Contains(TypeId))
+                return true;
+
             int32 RetValue = lua_getmetatable(L, IndexInStack);
             if (RetValue != 1)
             {
@@ -1296,6 +1281,9 @@ public:
                 ErrorMsg = FString::Printf(TEXT("struct %s needed but got %s"), *StructProperty->Struct->GetName(), ScriptStruct? *ScriptStruct->GetName(): TEXT("nil"));
                 return false;
             }
+
+            if (TypeId)
+                AcceptedTypeIds.Add(TypeId);
         }
 
         return true;
@@ -1306,6 +1294,9 @@ private:
     FTCHARToUTF8 StructName;
     int32 StructSize;
     uint8 UserdataPadding;
+#if ENABLE_TYPE_CHECK == 1
+    TArray<int32> AcceptedTypeIds;
+#endif
 };
 
 /**
@@ -20,6 +20,7 @@
 #include "LuaCore.h"
 #include "UELib.h"
 #include "ReflectionUtils/ClassDesc.h"
+#include "Registries/MetatableTemplate.h"
 
 extern int32 UObject_Identical(lua_State* L);
 extern int32 UObject_Delete(lua_State* L);
@@ -130,6 +131,29 @@ namespace UnLua
         if (!ClassDesc)
             return false;
 
+        if (const auto Template = FMetatableTemplate::Find(MetatableName, ClassDesc->AsStruct()))
+        {
+            RegisterSuperChain(ClassDesc);
+            Template->Instantiate(L, MetatableName, ClassDesc);
+            UELib::SetTableForClass(L, MetatableName);
+            return true;
+        }
+
+        const TArray<FClassDesc*> ClassDescChain = RegisterSuperChain(ClassDesc);
+        TArray<IExportedClass*> ExportedClasses;
+        for (int32 i = ClassDescChain.Num() - 1; i > -1; --i)
+        {
+            auto ExportedClass = FindExportedReflectedClass(*ClassDescChain[i]->GetName());
+            if (ExportedClass)
+                ExportedClasses.Add(ExportedClass);
+        }
+
+        // 第一次构建时生成共享的描述，构建过程只能新增这个元表。没有静态导出的类型只会新增这个元表，不用检查；
+        // 静态导出的注册可能创建其他元表或引用，这类类型数量有限，构建前后各数一次注册表
+        const bool bCapture = FMetatableTemplate::ShouldCapture(MetatableName);
+        const bool bCheckRegistry = bCapture && ExportedClasses.Num() > 0;
+        const int32 NumRegistryEntries = bCheckRegistry ? CountRegistryEntries(L) : 0;
+
         luaL_newmetatable(L, MetatableName);
         lua_pushstring(L, "__index");
         lua_pushcfunction(L, Class_Index);
@@ -212,6 +236,22 @@ namespace UnLua
         lua_pushvalue(L, -1); // set metatable to self
         lua_setmetatable(L, -2);
 
+        for (const auto ExportedClass : ExportedClasses)
+            ExportedClass->Register(L);
+
+        if (bCapture)
+        {
+            const bool bStandalone = !bCheckRegistry || CountRegistryEntries(L) == NumRegistryEntries + 1;
+            FMetatableTemplate::Capture(L, MetatableName, ClassDesc, bStandalone);
+        }
+
+        UELib::SetTableForClass(L, MetatableName);
+
+        return true;
+    }
+
+    TArray<FClassDesc*> FClassRegistry::RegisterSuperChain(FClassDesc* ClassDesc)
+    {
         TArray<FClassDesc*> ClassDescChain;
         ClassDescChain.Add(ClassDesc);
 
@@ -221,18 +261,28 @@ namespace UnLua
             ClassDescChain.Add(RegisterReflectedType(SuperStruct));
             SuperStruct = SuperStruct->GetInheritanceSuper();
         }
+        return ClassDescChain;
+    }
 
-        TArray<IExportedClass*> ExportedClasses;
-        for (int32 i = ClassDescChain.Num() - 1; i > -1; --i)
+    int32 FClassRegistry::CountRegistryEntries(lua_State* L)
+    {
+        int32 Num = 0;
+        lua_pushnil(L);
+        while (lua_next(L, LUA_REGISTRYINDEX) != 0)
         {
-            auto ExportedClass = FindExportedReflectedClass(*ClassDescChain[i]->GetName());
-            if (ExportedClass)
-                ExportedClass->Register(L);
+            lua_pop(L, 1);
+            ++Num;
         }
+        return Num;
+    }
 
-        UELib::SetTableForClass(L, MetatableName);
-
-        return true;
+    void FClassRegistry::Preload(const TArray<FString>& MetatableNames)
+    {
+        for (const auto& Name : MetatableNames)
+        {
+            if (!Register(TCHAR_TO_UTF8(*Name)))
+                UE_LOG(LogUnLua, Warning, TEXT("failed to preload metatable %s."), *Name);
+        }
     }
 
     bool FClassRegistry::TrySetMetatable(lua_State* L, const char* MetatableName)
@@ -52,11 +52,20 @@ namespace UnLua
 
         void Unregister(const UStruct* Class);
 
+        /**
+         * 预先构建一组类型的元表，名字与UE表中的名字一致，如AActor、FVector
+         */
+        void Preload(const TArray<FString>& MetatableNames);
+
     private:
         FClassDesc* RegisterInternal(UStruct* Type, const FString& Name);
 
         void Unregister(const FClassDesc* ClassDesc, const bool bForce);
 
+        TArray<FClassDesc*> RegisterSuperChain(FClassDesc* ClassDesc);
+
+        static int32 CountRegistryEntries(lua_State* L);
+
         TMap<UStruct*, FClassDesc*> Classes;
         TMap<FName, FClassDesc*> Name2Classes;
 
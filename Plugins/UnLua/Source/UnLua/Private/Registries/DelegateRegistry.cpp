@@ -15,6 +15,7 @@
 #include "Registries/DelegateRegistry.h"
 #include "LuaDelegateHandler.h"
 #include "ObjectReferencer.h"
+#include "LuaCore.h"
 #include "LuaEnv.h"
 
 namespace UnLua
@@ -36,6 +37,7 @@ namespace UnLua
             Env->AutoObjectReference.Remove(ToRelease);
         }
         Delegates.Empty();
+        HandlerStats.Empty();
         FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
     }
 
@@ -77,6 +79,7 @@ namespace UnLua
             {
                 const auto L = Env->GetMainState();
                 luaL_unref(L, LUA_REGISTRYINDEX, Handler->LuaRef);
+                HandlerStats.Remove(Handler.Get());
                 Handler->Reset();
             }
         }
@@ -101,6 +104,7 @@ namespace UnLua
     {
         const auto L = Env->GetMainState();
         luaL_unref(L, LUA_REGISTRYINDEX, Handler->LuaRef);
+        HandlerStats.Remove(Handler);
         Handler->Reset();
     }
 
@@ -217,7 +221,41 @@ namespace UnLua
             return;
 
         const auto L = Env->GetMainState();
-        SignatureDesc->CallLua(L, Handler->LuaRef, Params, Handler->SelfObject.Get());
+        if (!FCallStats::IsEnabled())
+        {
+            SignatureDesc->CallLua(L, Handler->LuaRef, Params, Handler->SelfObject.Get());
+            return;
+        }
+
+        FCallStats& Stats = GetHandlerStats(L, Handler, SignatureDesc.Get());
+        const uint64 StartCycles = FPlatformTime::Cycles64();
+        uint64 LuaCycles = 0;
+        SignatureDesc->CallLua(L, Handler->LuaRef, Params, Handler->SelfObject.Get(), &LuaCycles);
+        Stats.Record(FPlatformTime::Cycles64() - StartCycles, LuaCycles);
+    }
+
+    FCallStats& FDelegateRegistry::GetHandlerStats(lua_State* L, const ULuaDelegateHandler* Handler, const FFunctionDesc* SignatureDesc)
+    {
+        TUniquePtr<FCallStats>& Stats = HandlerStats.FindOrAdd(Handler);
+        if (Stats)
+            return *Stats;
+
+        // 以签名函数名加Lua函数定义位置命名，只在首次调用时取一次
+        Stats = MakeUnique<FCallStats>();
+        FString Name = SignatureDesc->GetFunction() ? SignatureDesc->GetFunction()->GetName() : TEXT("Delegate");
+        lua_rawgeti(L, LUA_REGISTRYINDEX, Handler->LuaRef);
+        if (lua_isfunction(L, -1))
+        {
+            lua_Debug Info;
+            lua_getinfo(L, ">S", &Info);
+            Name += FString::Printf(TEXT(" -> %s:%d"), UTF8_TO_TCHAR(Info.short_src), Info.linedefined);
+        }
+        else
+        {
+            lua_pop(L, 1);
+        }
+        Stats->Register(TEXT("Delegate"), Name);
+        return *Stats;
     }
 
     int32 FDelegateRegistry::Execute(lua_State* L, FScriptDelegate* Delegate, int32 NumParams, int32 FirstParamIndex)
@@ -234,34 +272,46 @@ namespace UnLua
 
 #pragma region FMulticastScriptDelegate
 
-    void FDelegateRegistry::Add(lua_State* L, int32 Index, void* Delegate, UObject* SelfObject)
+    bool FDelegateRegistry::Add(lua_State* L, int32 Index, void* Delegate, UObject* SelfObject)
     {
         check(lua_type(L, Index) == LUA_TFUNCTION);
         auto& Info = Delegates.FindChecked(Delegate);
         if (!Info.Owner.IsValid())
             Info.Owner = SelfObject;
 
+        // C++中Clear过的委托上已经没有我们的Handler了
+        if (Info.Handlers.Num() > 0)
+        {
+            const auto ScriptDelegate = TMulticastDelegateTraits<FMulticastDelegateType>::GetMulticastDelegate(Info.MulticastProperty, Delegate);
+            if (!ScriptDelegate || !ScriptDelegate->IsBound())
+                Info.Handlers.Empty();
+        }
+
         const auto LuaFunction = lua_topointer(L, Index);
         const auto DelegatePair = FLuaDelegatePair(SelfObject, LuaFunction);
         const auto Cached = CachedHandlers.Find(DelegatePair);
         if (Cached && Cached->IsValid())
         {
+            // 记录中已添加时再确认调用列表，C++中可能单独移除了我们的Handler
+            if (Info.Handlers.Contains(*Cached) && (*Cached)->IsAddedTo(Info.MulticastProperty, Delegate))
+                return false;
             CheckSignatureCompatible(L, Cached->Get(), Delegate);
             (*Cached)->AddTo(Info.MulticastProperty, Delegate);
             Info.Handlers.Add(*Cached);
-            return;
+            return true;
         }
 
         lua_pushvalue(L, Index);
         const auto Ref = luaL_ref(L, LUA_REGISTRYINDEX);
         const auto Handler = CreateHandler(Ref, Info.Owner.Get(), SelfObject);
         Env->AutoObjectReference.Add(Handler);
-        Handler->AddTo(Info.MulticastProperty, Delegate);
+        Handler->AddTo(Info.MulticastProperty, Delegate, false);
         CachedHandlers.Add(DelegatePair, Handler);
         Info.Handlers.Add(Handler);
+        return true;
     }
 
-    void FDelegateRegistry::Remove(lua_State* L, UObject* SelfObject, void* Delegate, int Index)
+    bool FDelegateRegistry::Remove(lua_State* L, UObject* SelfObject, void* Delegate, int Index)
     {
         check(lua_type(L, Index) == LUA_TFUNCTION);
         const auto LuaFunction = lua_topointer(L, Index);
@@ -270,10 +320,76 @@ namespace UnLua
         const auto DelegatePair = FLuaDelegatePair(SelfObject, LuaFunction);
         const auto Cached = CachedHandlers.Find(DelegatePair);
         if (!Cached || !Cached->IsValid())
-            return;
+            return false;
+
+        // 没有添加到这个委托上时不用遍历调用列表
+        if (Info.Handlers.Remove(*Cached) == 0)
+            return false;
 
         (*Cached)->RemoveFrom(Info.MulticastProperty, Delegate);
-        Info.Handlers.Remove(*Cached);
+        return true;
+    }
+
+    int32 FDelegateRegistry::AddListeners(lua_State* L, UObject* SelfObject, int32 Index)
+    {
+        Index = lua_absindex(L, Index);
+        const int32 Num = GetListenersNum(L, Index);
+        int32 Count = 0;
+        for (int32 i = 1; i < Num; i += 2)
+        {
+            const auto Delegate = GetListenerDelegate(L, Index, i);
+            if (Add(L, -1, Delegate, SelfObject))
+                ++Count;
+            lua_pop(L, 1);
+        }
+        return Count;
+    }
+
+    int32 FDelegateRegistry::RemoveListeners(lua_State* L, UObject* SelfObject, int32 Index)
+    {
+        Index = lua_absindex(L, Index);
+        const int32 Num = GetListenersNum(L, Index);
+        int32 Count = 0;
+        for (int32 i = 1; i < Num; i += 2)
+        {
+            const auto Delegate = GetListenerDelegate(L, Index, i);
+            if (Remove(L, SelfObject, Delegate, -1))
+                ++Count;
+            lua_pop(L, 1);
+        }
+        return Count;
+    }
+
+    int32 FDelegateRegistry::GetListenersNum(lua_State* L, int32 Index)
+    {
+        // 委托和函数必须成对出现，落单的一项多半是脚本写错了，不能悄悄忽略
+        const int32 Num = (int32)lua_rawlen(L, Index);
+        if (Num % 2 != 0)
+        {
+            luaL_error(L, "listeners should be pairs of {Delegate, Function}, but got %d entries", Num);
+            return 0;
+        }
+        return Num;
+    }
+
+    void* FDelegateRegistry::GetListenerDelegate(lua_State* L, int32 Index, int32 i)
+    {
+        lua_rawgeti(L, Index, i);
+        const auto Delegate = GetCppInstanceFast(L, -1);
+        lua_pop(L, 1);
+        const auto Info = Delegates.Find(Delegate);
+        if (!Delegate || !Info || !Info->bIsMulticast)
+        {
+            luaL_error(L, "invalid multicast delegate at index %d", i);
+            return nullptr;
+        }
+
+        if (lua_rawgeti(L, Index, i + 1) != LUA_TFUNCTION)
+        {
+            luaL_error(L, "function expected at index %d", i + 1);
+            return nullptr;
+        }
+        return Delegate;
     }
 
     void FDelegateRegistry::Broadcast(lua_State* L, void* Delegate, int32 NumParams, int32 FirstParamIndex)
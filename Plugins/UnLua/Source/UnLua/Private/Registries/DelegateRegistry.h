@@ -71,9 +71,16 @@ namespace UnLua
 
         void Unbind(void* Delegate);
 
-        void Add(lua_State* L, int32 Index, void* Delegate, UObject* SelfObject);
+        bool Add(lua_State* L, int32 Index, void* Delegate, UObject* SelfObject);
 
-        void Remove(lua_State* L, UObject* SelfObject, void* Delegate, int Index);
+        bool Remove(lua_State* L, UObject* SelfObject, void* Delegate, int Index);
+
+        /**
+         * 批量绑定/解绑，Index处为{Delegate1, Function1, Delegate2, Function2, ...}，返回实际绑定/解绑的数量
+         */
+        int32 AddListeners(lua_State* L, UObject* SelfObject, int32 Index);
+
+        int32 RemoveListeners(lua_State* L, UObject* SelfObject, int32 Index);
 
         void Broadcast(lua_State* L, void* Delegate, int32 NumParams, int32 FirstParamIndex);
 
@@ -88,8 +95,14 @@ namespace UnLua
 
         TSharedPtr<FFunctionDesc> GetSignatureDesc(const void* Delegate);
 
+        int32 GetListenersNum(lua_State* L, int32 Index);
+
+        void* GetListenerDelegate(lua_State* L, int32 Index, int32 i);
+
         ULuaDelegateHandler* CreateHandler(int LuaRef, UObject* Owner, UObject* SelfObject);
 
+        FCallStats& GetHandlerStats(lua_State* L, const ULuaDelegateHandler* Handler, const FFunctionDesc* SignatureDesc);
+
         struct FDelegateInfo
         {
             union
@@ -102,13 +115,14 @@ namespace UnLua
             UFunction* SignatureFunction;
             TSharedPtr<FFunctionDesc> Desc;
             TWeakObjectPtr<UObject> Owner;
-            TSet<TWeakObjectPtr<ULuaDelegateHandler>> Handlers;
+            TSet<TWeakObjectPtr<ULuaDelegateHandler>> Handlers;     // 多播委托上已添加的Handler，用于O(1)查重
             bool bIsMulticast;
             bool bDeleteOnRemove;
         };
 
         TMap<void*, FDelegateInfo> Delegates;
         TMap<FLuaDelegatePair, TWeakObjectPtr<ULuaDelegateHandler>> CachedHandlers;
+        TMap<const ULuaDelegateHandler*, TUniquePtr<FCallStats>> HandlerStats;     // 只在开启调用统计时记录
         FLuaEnv* Env;
         FDelegateHandle PostGarbageCollectHandle;
     };
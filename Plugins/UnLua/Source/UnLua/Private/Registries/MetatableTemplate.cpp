@@ -0,0 +1,217 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "Registries/MetatableTemplate.h"
+#include "UnLuaBase.h"
+#include "ReflectionUtils/ClassDesc.h"
+
+namespace UnLua
+{
+    static TMap<FName, TUniquePtr<FMetatableTemplate>>& GetTemplates()
+    {
+        static TMap<FName, TUniquePtr<FMetatableTemplate>> Templates;
+        return Templates;
+    }
+
+    static TSet<FName>& GetCapturedNames()
+    {
+        static TSet<FName> CapturedNames;
+        return CapturedNames;
+    }
+
+    const FMetatableTemplate* FMetatableTemplate::Find(const char* MetatableName, const UStruct* Struct)
+    {
+        const FName Key = MetatableName;
+        const auto Template = GetTemplates().Find(Key);
+        if (!Template)
+            return nullptr;
+
+        if ((*Template)->Struct.Get() == Struct)
+            return Template->Get();
+
+        // 类型被重新加载或编译过，重新生成描述
+        GetTemplates().Remove(Key);
+        GetCapturedNames().Remove(Key);
+        return nullptr;
+    }
+
+    bool FMetatableTemplate::ShouldCapture(const char* MetatableName)
+    {
+        return !GetCapturedNames().Contains(FName(MetatableName));
+    }
+
+    void FMetatableTemplate::Capture(lua_State* L, const char* MetatableName, const FClassDesc* ClassDesc, bool bStandalone)
+    {
+        const FName Key = MetatableName;
+        GetCapturedNames().Add(Key);
+        if (!bStandalone)
+            return;
+
+        const int32 TableIndex = lua_gettop(L);
+        auto Template = MakeUnique<FMetatableTemplate>();
+        Template->Struct = ClassDesc->AsStruct();
+
+        if (lua_getmetatable(L, TableIndex))
+        {
+            Template->bSelfMetatable = lua_rawequal(L, -1, TableIndex) != 0;
+            lua_pop(L, 1);
+            if (!Template->bSelfMetatable)
+                return;
+        }
+
+        lua_pushnil(L);
+        while (lua_next(L, TableIndex) != 0)
+        {
+            FEntry& Entry = Template->Entries.AddDefaulted_GetRef();
+            if (!Template->CaptureValue(L, -2, TableIndex, ClassDesc, Entry.Key) || !Template->CaptureValue(L, -1, TableIndex, ClassDesc, Entry.Value))
+            {
+                lua_pop(L, 2);
+                return;
+            }
+            lua_pop(L, 1);
+        }
+
+        GetTemplates().Add(Key, MoveTemp(Template));
+    }
+
+    bool FMetatableTemplate::CaptureValue(lua_State* L, int32 Index, int32 TableIndex, const FClassDesc* ClassDesc, FValue& Out) const
+    {
+        Index = lua_absindex(L, Index);
+        switch (lua_type(L, Index))
+        {
+        case LUA_TBOOLEAN:
+            Out.Kind = EKind::Boolean;
+            Out.Boolean = lua_toboolean(L, Index) != 0;
+            return true;
+        case LUA_TNUMBER:
+            if (lua_isinteger(L, Index))
+            {
+                Out.Kind = EKind::Integer;
+                Out.Integer = lua_tointeger(L, Index);
+            }
+            else
+            {
+                Out.Kind = EKind::Number;
+                Out.Number = lua_tonumber(L, Index);
+            }
+            return true;
+        case LUA_TSTRING:
+            {
+                size_t Len;
+                const char* Str = lua_tolstring(L, Index, &Len);
+                Out.Kind = EKind::String;
+                Out.String.Append(Str, (int32)Len);
+                return true;
+            }
+        case LUA_TLIGHTUSERDATA:
+            Out.Pointer = lua_touserdata(L, Index);
+            Out.Kind = Out.Pointer == ClassDesc ? EKind::ClassDesc : EKind::LightUserdata;
+            return true;
+        case LUA_TTABLE:
+            Out.Kind = EKind::Self;
+            return lua_rawequal(L, Index, TableIndex) != 0;
+        case LUA_TFUNCTION:
+            {
+                Out.Kind = EKind::Function;
+                Out.Function = lua_tocfunction(L, Index);
+                if (!Out.Function)
+                    return false;
+                for (int32 i = 1; lua_getupvalue(L, Index, i); i++)
+                {
+                    const bool bOk = CaptureValue(L, -1, TableIndex, ClassDesc, Out.Upvalues.AddDefaulted_GetRef());
+                    lua_pop(L, 1);
+                    if (!bOk)
+                        return false;
+                }
+                return true;
+            }
+        case LUA_TUSERDATA:
+            {
+                // 只支持导出属性使用的TSharedPtr
+                bool bSharedPtr = false;
+                if (lua_getmetatable(L, Index))
+                {
+                    luaL_getmetatable(L, "TSharedPtr");
+                    bSharedPtr = lua_rawequal(L, -1, -2) != 0;
+                    lua_pop(L, 2);
+                }
+                if (!bSharedPtr)
+                    return false;
+                Out.Kind = EKind::SharedPtr;
+                Out.SharedPtr = *(TSharedPtr<void>*)lua_touserdata(L, Index);
+                return true;
+            }
+        default:
+            return false;
+        }
+    }
+
+    void FMetatableTemplate::Instantiate(lua_State* L, const char* MetatableName, FClassDesc* ClassDesc) const
+    {
+        lua_createtable(L, 0, Entries.Num());
+        const int32 TableIndex = lua_gettop(L);
+        for (const auto& Entry : Entries)
+        {
+            PushValue(L, Entry.Key, TableIndex, ClassDesc);
+            PushValue(L, Entry.Value, TableIndex, ClassDesc);
+            lua_rawset(L, TableIndex);
+        }
+
+        if (bSelfMetatable)
+        {
+            lua_pushvalue(L, TableIndex);
+            lua_setmetatable(L, TableIndex);
+        }
+
+        lua_pushvalue(L, TableIndex);
+        lua_setfield(L, LUA_REGISTRYINDEX, MetatableName);
+    }
+
+    void FMetatableTemplate::PushValue(lua_State* L, const FValue& Value, int32 TableIndex, FClassDesc* ClassDesc) const
+    {
+        switch (Value.Kind)
+        {
+        case EKind::Boolean:
+            lua_pushboolean(L, Value.Boolean);
+            break;
+        case EKind::Number:
+            lua_pushnumber(L, Value.Number);
+            break;
+        case EKind::Integer:
+            lua_pushinteger(L, Value.Integer);
+            break;
+        case EKind::String:
+            lua_pushlstring(L, Value.String.GetData(), Value.String.Num());
+            break;
+        case EKind::LightUserdata:
+            lua_pushlightuserdata(L, (void*)Value.Pointer);
+            break;
+        case EKind::ClassDesc:
+            lua_pushlightuserdata(L, ClassDesc);
+            break;
+        case EKind::Self:
+            lua_pushvalue(L, TableIndex);
+            break;
+        case EKind::Function:
+            for (const auto& Upvalue : Value.Upvalues)
+                PushValue(L, Upvalue, TableIndex, ClassDesc);
+            lua_pushcclosure(L, Value.Function, Value.Upvalues.Num());
+            break;
+        case EKind::SharedPtr:
+            new(NewSmartPointer(L, sizeof(TSharedPtr<void>), "TSharedPtr")) TSharedPtr<void>(Value.SharedPtr);
+            break;
+        }
+    }
+}
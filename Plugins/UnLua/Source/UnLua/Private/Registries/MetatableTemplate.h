@@ -0,0 +1,91 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+#include "lua.hpp"
+
+class FClassDesc;
+
+namespace UnLua
+{
+    /**
+     * UE类型元表的不可变描述，第一个Lua环境构建元表后生成，按名字在进程内共享，之后的环境直接按描述批量填充元表
+     *
+     * 只记录C函数、数字、字符串、布尔、静态指针和TSharedPtr等与环境无关的值，FClassDesc与元表自身用占位符记录。
+     * 遇到无法描述的值（Lua函数、其他table等）或静态导出的注册修改了注册表的其他位置时不生成描述，这个类型继续逐项构建。
+     */
+    class FMetatableTemplate
+    {
+    public:
+        /* 找到与Struct对应的描述，类型重新加载或编译后旧的描述失效 */
+        static const FMetatableTemplate* Find(const char* MetatableName, const UStruct* Struct);
+
+        /* 是否还需要尝试生成描述，每个类型在进程内只尝试一次 */
+        static bool ShouldCapture(const char* MetatableName);
+
+        /* 栈顶为刚构建好的元表，ClassDesc为当前环境中对应的FClassDesc，bStandalone表示构建过程没有其他副作用 */
+        static void Capture(lua_State* L, const char* MetatableName, const FClassDesc* ClassDesc, bool bStandalone);
+
+        /* 按描述创建元表，注册到注册表并压栈 */
+        void Instantiate(lua_State* L, const char* MetatableName, FClassDesc* ClassDesc) const;
+
+    private:
+        enum class EKind : uint8
+        {
+            Boolean,
+            Number,
+            Integer,
+            String,
+            LightUserdata,
+            ClassDesc,
+            Self,
+            Function,
+            SharedPtr,
+        };
+
+        struct FValue
+        {
+            EKind Kind;
+            union
+            {
+                bool Boolean;
+                lua_Number Number;
+                lua_Integer Integer;
+                const void* Pointer;
+                lua_CFunction Function;
+            };
+            TArray<ANSICHAR> String;
+            TArray<FValue> Upvalues;
+            TSharedPtr<void> SharedPtr;
+        };
+
+        struct FEntry
+        {
+            FValue Key;
+            FValue Value;
+        };
+
+        bool CaptureValue(lua_State* L, int32 Index, int32 TableIndex, const FClassDesc* ClassDesc, FValue& Out) const;
+
+        void PushValue(lua_State* L, const FValue& Value, int32 TableIndex, FClassDesc* ClassDesc) const;
+
+        TWeakObjectPtr<const UStruct> Struct;
+        TArray<FEntry> Entries;
+        bool bSelfMetatable = false;
+    };
+}
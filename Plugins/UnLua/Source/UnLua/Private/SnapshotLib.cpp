@@ -0,0 +1,253 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+//
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License");
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+
+#include "SnapshotLib.h"
+#include "LowLevel.h"
+#include "LuaCore.h"
+#include "LuaEnv.h"
+#include "ReflectionUtils/FieldDesc.h"
+#include "ReflectionUtils/PropertyDesc.h"
+
+namespace UnLua
+{
+    namespace SnapshotLib
+    {
+        static const char* FIELD_SETS_KEY = "UnLuaSnapshotFieldSets";
+        static const char* FIELD_SET_METATABLE_NAME = "UnLuaSnapshotFieldSet";
+
+        /**
+         * 某个类型上字段表的解析结果，与字段表一一对应，不存在的字段为nullptr
+         */
+        struct FFieldPlan
+        {
+            TWeakObjectPtr<UStruct> Struct;
+            TArray<TSharedPtr<FPropertyDesc>> Properties;
+        };
+
+        /**
+         * 一张字段名表，按类型缓存解析结果，随字段表一起被Lua GC
+         */
+        struct FFieldSet
+        {
+            TArray<FName> Names;
+            TMap<const UStruct*, FFieldPlan> Plans;
+
+            const FFieldPlan& GetPlan(FClassDesc* ClassDesc)
+            {
+                UStruct* Struct = ClassDesc->AsStruct();
+                FFieldPlan* Plan = Plans.Find(Struct);
+                if (Plan && Plan->Struct.IsValid())
+                    return *Plan;
+
+                if (!Plan)
+                    Plan = &Plans.Add(Struct);
+                Plan->Struct = Struct;
+                Plan->Properties.Reset(Names.Num());
+                for (const FName& Name : Names)
+                {
+                    const TSharedPtr<FFieldDesc> Field = ClassDesc->RegisterField(Name, ClassDesc);
+                    Plan->Properties.Add(Field && Field->IsProperty() ? Field->AsProperty() : nullptr);
+                }
+                return *Plan;
+            }
+        };
+
+        static int FieldSet_GC(lua_State* L)
+        {
+            const auto FieldSet = (FFieldSet*)lua_touserdata(L, 1);
+            FieldSet->~FFieldSet();
+            return 0;
+        }
+
+        /**
+         * 取得字段表对应的FFieldSet，以字段表本身为弱键缓存，字段表在首次使用后应视为只读
+         */
+        static FFieldSet* GetFieldSet(lua_State* L, int32 Index)
+        {
+            Index = lua_absindex(L, Index);
+            luaL_checktype(L, Index, LUA_TTABLE);
+            const int32 Num = (int32)lua_rawlen(L, Index);
+
+            if (lua_getfield(L, LUA_REGISTRYINDEX, FIELD_SETS_KEY) != LUA_TTABLE)
+            {
+                lua_pop(L, 1);
+                lua_newtable(L);
+                lua_newtable(L);
+                lua_pushstring(L, "k");
+                lua_setfield(L, -2, "__mode");
+                lua_setmetatable(L, -2);
+                lua_pushvalue(L, -1);
+                lua_setfield(L, LUA_REGISTRYINDEX, FIELD_SETS_KEY);
+            }
+
+            lua_pushvalue(L, Index);
+            lua_rawget(L, -2);
+            auto FieldSet = (FFieldSet*)lua_touserdata(L, -1);
+            if (FieldSet && FieldSet->Names.Num() == Num)
+            {
+                lua_pop(L, 2);
+                return FieldSet;
+            }
+            lua_pop(L, 1);
+
+            FieldSet = new(lua_newuserdata(L, sizeof(FFieldSet))) FFieldSet();
+            if (luaL_newmetatable(L, FIELD_SET_METATABLE_NAME))
+            {
+                lua_pushcfunction(L, FieldSet_GC);
+                lua_setfield(L, -2, "__gc");
+            }
+            lua_setmetatable(L, -2);
+
+            FieldSet->Names.Reserve(Num);
+            for (int32 i = 1; i <= Num; ++i)
+            {
+                if (lua_rawgeti(L, Index, i) != LUA_TSTRING)
+                {
+                    luaL_error(L, "field name expected at index %d", i);
+                    return nullptr;
+                }
+                FieldSet->Names.Add(FName(UTF8_TO_TCHAR(lua_tostring(L, -1))));
+                lua_pop(L, 1);
+            }
+
+            lua_pushvalue(L, Index);
+            lua_pushvalue(L, -2);
+            lua_rawset(L, -4);
+            lua_pop(L, 2);
+            return FieldSet;
+        }
+
+        /**
+         * 取得目标的类型描述与容器地址，UObject按实际类型解析
+         */
+        static FClassDesc* GetTarget(lua_State* L, int32 Index, void*& OutSelf)
+        {
+            OutSelf = GetCppInstance(L, Index);
+            if (!OutSelf || LowLevel::IsReleasedPtr(OutSelf))
+                return nullptr;
+
+            const auto Registry = FLuaEnv::FindEnvChecked(L).GetClassRegistry();
+            if (lua_type(L, Index) == LUA_TTABLE)
+            {
+                UObject* Object = GetUObject(L, Index);
+                return Object ? Registry->Register(Object->GetClass()) : nullptr;
+            }
+
+            if (!lua_getmetatable(L, Index))
+                return nullptr;
+            lua_pushstring(L, "ClassDesc");
+            lua_rawget(L, -2);
+            const auto ClassDesc = (FClassDesc*)lua_touserdata(L, -1);
+            lua_pop(L, 2);
+
+            if (ClassDesc && ClassDesc->IsClass())
+                return Registry->Register(((UObject*)OutSelf)->GetClass());
+            return ClassDesc;
+        }
+
+        static FPropertyDesc* FindProperty(FClassDesc* ClassDesc, const char* FieldName)
+        {
+            const TSharedPtr<FFieldDesc> Field = ClassDesc->RegisterField(FName(UTF8_TO_TCHAR(FieldName)), ClassDesc);
+            return Field && Field->IsProperty() ? Field->AsProperty().Get() : nullptr;
+        }
+
+        int Snapshot(lua_State* L)
+        {
+            void* Self;
+            FClassDesc* ClassDesc = GetTarget(L, 1, Self);
+            if (!ClassDesc)
+                return luaL_error(L, "invalid snapshot target");
+
+            FFieldSet* FieldSet = GetFieldSet(L, 2);
+            const FFieldPlan& Plan = FieldSet->GetPlan(ClassDesc);
+            const int32 Num = Plan.Properties.Num();
+
+            if (lua_istable(L, 3))
+            {
+                lua_settop(L, 3);
+            }
+            else
+            {
+                lua_settop(L, 2);
+                lua_createtable(L, 0, Num);
+            }
+
+            for (int32 i = 0; i < Num; ++i)
+            {
+                lua_rawgeti(L, 2, i + 1);
+                const FPropertyDesc* Property = Plan.Properties[i].Get();
+                if (Property)
+                    Property->ReadValue_InContainer(L, Self, true);
+                else
+                    lua_pushnil(L);
+                lua_rawset(L, 3);
+            }
+            return 1;
+        }
+
+        int32 ApplyValues(lua_State* L, FClassDesc* ClassDesc, void* Self, int32 ValuesIndex, int32 FieldsIndex)
+        {
+            ValuesIndex = lua_absindex(L, ValuesIndex);
+            int32 Count = 0;
+            if (FieldsIndex != 0)
+            {
+                FieldsIndex = lua_absindex(L, FieldsIndex);
+                FFieldSet* FieldSet = GetFieldSet(L, FieldsIndex);
+                const FFieldPlan& Plan = FieldSet->GetPlan(ClassDesc);
+                for (int32 i = 0; i < Plan.Properties.Num(); ++i)
+                {
+                    const FPropertyDesc* Property = Plan.Properties[i].Get();
+                    if (!Property || !Property->IsValid())
+                        continue;
+
+                    lua_rawgeti(L, FieldsIndex, i + 1);
+                    if (lua_rawget(L, ValuesIndex) != LUA_TNIL)
+                    {
+                        Property->WriteValue_InContainer(L, Self, lua_gettop(L));
+                        ++Count;
+                    }
+                    lua_pop(L, 1);
+                }
+            }
+            else
+            {
+                lua_pushnil(L);
+                while (lua_next(L, ValuesIndex) != 0)
+                {
+                    const FPropertyDesc* Property = lua_type(L, -2) == LUA_TSTRING ? FindProperty(ClassDesc, lua_tostring(L, -2)) : nullptr;
+                    if (Property && Property->IsValid())
+                    {
+                        Property->WriteValue_InContainer(L, Self, lua_gettop(L));
+                        ++Count;
+                    }
+                    lua_pop(L, 1);
+                }
+            }
+            return Count;
+        }
+
+        int Apply(lua_State* L)
+        {
+            void* Self;
+            FClassDesc* ClassDesc = GetTarget(L, 1, Self);
+            if (!ClassDesc)
+                return luaL_error(L, "invalid apply target");
+            luaL_checktype(L, 2, LUA_TTABLE);
+
+            const int32 Count = ApplyValues(L, ClassDesc, Self, 2, lua_isnoneornil(L, 3) ? 0 : 3);
+            lua_pushinteger(L, Count);
+            return 1;
+        }
+    }
+}
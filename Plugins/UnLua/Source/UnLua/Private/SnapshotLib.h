@@ -0,0 +1,44 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+//
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License");
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+#include "lua.hpp"
+
+class FClassDesc;
+
+namespace UnLua
+{
+    namespace SnapshotLib
+    {
+        /**
+         * UnLua.Snapshot(Target, Fields [, Out])
+         *
+         * 一次原生调用读取UObject/结构体的多个属性，Fields为属性名数组，按类型与字段表缓存解析结果。
+         * 结构体等值类型属性返回拷贝。传入Out时复用这张表，否则新建。
+         */
+        int Snapshot(lua_State* L);
+
+        /**
+         * UnLua.Apply(Target, Values [, Fields])
+         *
+         * 一次原生调用把Values中的属性写回Target，指定Fields时只写这些字段（使用缓存的解析结果），返回写入的字段数。
+         */
+        int Apply(lua_State* L);
+
+        /**
+         * 把ValuesIndex处的表中的属性写入Self，FieldsIndex不为0时只写字段表中的字段，返回写入的字段数
+         */
+        int32 ApplyValues(lua_State* L, FClassDesc* ClassDesc, void* Self, int32 ValuesIndex, int32 FieldsIndex = 0);
+    }
+}
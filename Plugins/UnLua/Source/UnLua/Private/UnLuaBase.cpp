@@ -199,6 +199,8 @@ namespace UnLua
             lua_getfield(L, LUA_REGISTRYINDEX, "StructMap");
             lua_pushlightuserdata(L, Value);
             int32 Type = lua_rawget(L, -2);
+            if (Type == LUA_TUSERDATA && !::GetUserdataFast(L, -1))
+                Type = LUA_TNIL; // 缓存的userdata所属的调用已经返回，重新创建
             if (Type == LUA_TUSERDATA)
             {
                 lua_remove(L, -2);
@@ -251,7 +253,7 @@ namespace UnLua
 
         if (bCreateUserdata)
         {
-            NewUserdataWithTwoLvPtrTag(L, sizeof(void*), Value);
+            NewUserdataWithTwoLvPtrTag(L, sizeof(void*), Value, bAlwaysCreate ? 0 : FDanglingCheck::GetGeneration(L));
             if (MetatableName)
             {
                 bool bSuccess = TryToSetMetatable(L, MetatableName);        // set metatable
@@ -266,7 +268,6 @@ namespace UnLua
             if (!bAlwaysCreate)
             {
                 // cache the new userdata in 'StructMap
-                FLuaEnv::FindEnv(L)->GetDanglingCheck()->CaptureStruct(L, Value);
                 lua_pushlightuserdata(L, Value);
                 lua_pushvalue(L, -2);
                 lua_rawset(L, -4);
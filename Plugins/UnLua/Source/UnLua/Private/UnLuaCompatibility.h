@@ -101,6 +101,17 @@ struct TMulticastDelegateTraits
 #endif
     }
 
+    // 调用方已保证不重复时使用，内联的多播委托不再线性查重
+    static void AddDelegateUnchecked(FMulticastDelegateProperty* Property, FScriptDelegate Delegate, UObject* Parent, void* PropertyValue)
+    {
+#if ENGINE_MAJOR_VERSION > 4 || (ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION > 22)
+        if (Property->IsA<FMulticastInlineDelegateProperty>())
+            ((FMulticastScriptDelegate*)Property->GetMulticastDelegate(PropertyValue))->Add(Delegate);
+        else
+            Property->AddDelegate(Delegate, Parent, PropertyValue);
+#endif
+    }
+
     static void RemoveDelegate(FMulticastDelegateProperty* Property, FScriptDelegate Delegate, UObject* Parent, void* PropertyValue)
     {
 #if ENGINE_MAJOR_VERSION > 4 || (ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION > 22)
@@ -137,6 +148,11 @@ struct TMulticastDelegateTraits<FMulticastScriptDelegate>
     {
         ((FMulticastScriptDelegate*)PropertyValue)->AddUnique(Delegate);
     }
+
+    static void AddDelegateUnchecked(FMulticastDelegateProperty* Property, FScriptDelegate Delegate, UObject* Parent, void* PropertyValue)
+    {
+        ((FMulticastScriptDelegate*)PropertyValue)->Add(Delegate);
+    }
     
     static void RemoveDelegate(FMulticastDelegateProperty* Property, FScriptDelegate Delegate, UObject* Parent, void* PropertyValue)
     {
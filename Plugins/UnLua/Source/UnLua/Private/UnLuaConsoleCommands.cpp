@@ -1,4 +1,7 @@
 ﻿#include "UnLuaConsoleCommands.h"
+#include "CallStats.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
 
 #define LOCTEXT_NAMESPACE "UnLuaConsoleCommands"
 
@@ -20,6 +23,26 @@ namespace UnLua
               *LOCTEXT("CommandText_CollectGarbage", "Force collect garbage in lua env.").ToString(),
               FConsoleCommandWithArgsDelegate::CreateRaw(this, &FUnLuaConsoleCommands::CollectGarbage)
           ),
+          StatsStartCommand(
+              TEXT("lua.stats.start"),
+              *LOCTEXT("CommandText_StatsStart", "Clear and start recording call stats of lua bindings.").ToString(),
+              FConsoleCommandWithArgsDelegate::CreateRaw(this, &FUnLuaConsoleCommands::StatsStart)
+          ),
+          StatsStopCommand(
+              TEXT("lua.stats.stop"),
+              *LOCTEXT("CommandText_StatsStop", "Stop recording call stats of lua bindings.").ToString(),
+              FConsoleCommandWithArgsDelegate::CreateRaw(this, &FUnLuaConsoleCommands::StatsStop)
+          ),
+          StatsDumpCommand(
+              TEXT("lua.stats.dump"),
+              *LOCTEXT("CommandText_StatsDump", "Dump the most expensive lua bindings sorted by total time. Usage: lua.stats.dump [Count]").ToString(),
+              FConsoleCommandWithArgsDelegate::CreateRaw(this, &FUnLuaConsoleCommands::StatsDump)
+          ),
+          HeapSnapshotCommand(
+              TEXT("lua.heap.snapshot"),
+              *LOCTEXT("CommandText_HeapSnapshot", "Take a snapshot of lua heap grouped by module, bound object class and userdata type, and diff with the previous one. Usage: lua.heap.snapshot [FilePath]").ToString(),
+              FConsoleCommandWithArgsDelegate::CreateRaw(this, &FUnLuaConsoleCommands::HeapSnapshot)
+          ),
           Module(InModule)
     {
     }
@@ -79,6 +102,62 @@ namespace UnLua
 
         Env->GC();
     }
+
+    void FUnLuaConsoleCommands::StatsStart(const TArray<FString>& Args) const
+    {
+        FCallStats::Start();
+        UE_LOG(LogUnLua, Log, TEXT("lua call stats started."));
+    }
+
+    void FUnLuaConsoleCommands::StatsStop(const TArray<FString>& Args) const
+    {
+        FCallStats::Stop();
+        UE_LOG(LogUnLua, Log, TEXT("lua call stats stopped."));
+    }
+
+    void FUnLuaConsoleCommands::StatsDump(const TArray<FString>& Args) const
+    {
+        int32 Count = 50;
+        if (Args.Num() > 0)
+            LexFromString(Count, *Args[0]);
+        FCallStats::Dump(Count);
+    }
+
+    void FUnLuaConsoleCommands::HeapSnapshot(const TArray<FString>& Args)
+    {
+        auto Env = Module->GetEnv();
+        if (!Env)
+        {
+            UE_LOG(LogUnLua, Warning, TEXT("no available lua env found to take heap snapshot."));
+            return;
+        }
+
+        Env->GC();
+        TUniquePtr<FHeapSnapshot> Snapshot = MakeUnique<FHeapSnapshot>(FHeapSnapshot::Capture(Env->GetMainState()));
+
+        FString Content;
+        if (LastHeapSnapshot)
+        {
+            Content += TEXT("==== Diff since last snapshot ====\n");
+            Content += FHeapSnapshot::Diff(*LastHeapSnapshot, *Snapshot).ToString();
+        }
+        Content += TEXT("==== Snapshot ====\n");
+        Content += Snapshot->ToString();
+
+        const FString FilePath = Args.Num() > 0
+                                     ? Args[0]
+                                     : FPaths::ProjectSavedDir() / TEXT("UnLua") / FString::Printf(TEXT("HeapSnapshot-%s.txt"), *FDateTime::Now().ToString());
+        if (FFileHelper::SaveStringToFile(Content, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+        {
+            UE_LOG(LogUnLua, Log, TEXT("lua heap snapshot (%lld bytes) saved to %s"), Snapshot->TotalBytes, *FilePath);
+        }
+        else
+        {
+            UE_LOG(LogUnLua, Warning, TEXT("failed to save lua heap snapshot to %s"), *FilePath);
+        }
+
+        LastHeapSnapshot = MoveTemp(Snapshot);
+    }
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -15,6 +15,7 @@
 #pragma once
 
 #include "UnLuaModule.h"
+#include "HeapSnapshot.h"
 
 namespace UnLua
 {
@@ -27,6 +28,14 @@ namespace UnLua
 
         FAutoConsoleCommand CollectGarbageCommand;
 
+        FAutoConsoleCommand StatsStartCommand;
+
+        FAutoConsoleCommand StatsStopCommand;
+
+        FAutoConsoleCommand StatsDumpCommand;
+
+        FAutoConsoleCommand HeapSnapshotCommand;
+
         explicit FUnLuaConsoleCommands(IUnLuaModule* InModule);
 
         void Do(const TArray<FString>& Args) const;
@@ -35,7 +44,16 @@ namespace UnLua
 
         void CollectGarbage(const TArray<FString>& Args) const;
 
+        void StatsStart(const TArray<FString>& Args) const;
+
+        void StatsStop(const TArray<FString>& Args) const;
+
+        void StatsDump(const TArray<FString>& Args) const;
+
+        void HeapSnapshot(const TArray<FString>& Args);
+
     private:
         IUnLuaModule* Module;
+        TUniquePtr<FHeapSnapshot> LastHeapSnapshot;
     };
 }
@@ -32,3 +32,24 @@ void UUnLuaFunctionLibrary::HotReload()
 {
     IUnLuaModule::Get().HotReload();
 }
+
+void UUnLuaFunctionLibrary::HotReloadModules(const TArray<FString>& ModuleNames)
+{
+    IUnLuaModule::Get().HotReload(ModuleNames);
+}
+
+FString UUnLuaFunctionLibrary::GetModuleNameFromFilePath(const FString& FilePath)
+{
+    if (FPaths::GetExtension(FilePath) != TEXT("lua"))
+        return FString();
+
+    FString FullPath = FPaths::ConvertRelativePathToFull(FilePath);
+    FPaths::NormalizeFilename(FullPath);
+    const FString ScriptRootPath = GetScriptRootPath();
+    if (!FullPath.StartsWith(ScriptRootPath))
+        return FString();
+
+    FString ModuleName = FPaths::ChangeExtension(FullPath.RightChop(ScriptRootPath.Len()), TEXT(""));
+    ModuleName.ReplaceInline(TEXT("/"), TEXT("."));
+    return ModuleName;
+}
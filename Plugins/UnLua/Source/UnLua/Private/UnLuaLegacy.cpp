@@ -19,6 +19,7 @@ UNLUA_DEFINE_STAT(Lua_Memory);
 UNLUA_DEFINE_STAT(PersistentParamBuffer_Memory);
 UNLUA_DEFINE_STAT(OutParmRec_Memory);
 UNLUA_DEFINE_STAT(ContainerElementCache_Memory);
+UNLUA_DEFINE_STAT(StructPool_Memory);
 
 namespace UnLua
 {
@@ -1,6 +1,8 @@
 #include "UnLuaLib.h"
+#include "HotReloadLib.h"
 #include "LowLevel.h"
 #include "LuaEnv.h"
+#include "SnapshotLib.h"
 #include "UnLuaBase.h"
 
 namespace UnLua
@@ -51,10 +53,20 @@ namespace UnLua
         static int HotReload(lua_State* L)
         {
 #if UNLUA_WITH_HOT_RELOAD
-            if (luaL_dostring(L, "require('UnLua.HotReload').reload()") != 0)
-            {
-                LogError(L);
-            }
+            // UnLua.HotReload([ModuleNames]) 指定模块名时只重载这些模块及依赖它们的模块
+            const bool bWithModuleNames = lua_istable(L, 1);
+            lua_settop(L, bWithModuleNames ? 1 : 0);
+            lua_pushcfunction(L, ReportLuaCallError);
+            lua_getglobal(L, "require");
+            lua_pushstring(L, "UnLua.HotReload");
+            if (lua_pcall(L, 1, 1, -3) != LUA_OK)
+                return 0;
+            lua_getfield(L, -1, "reload");
+            if (bWithModuleNames)
+                lua_pushvalue(L, 1);
+            else
+                lua_pushnil(L);
+            lua_pcall(L, 1, 0, bWithModuleNames ? 2 : 1);
 #endif
             return 0;
         }
@@ -81,6 +93,47 @@ namespace UnLua
             return 0;
         }
 
+        /**
+         * 把不再使用的结构体放回池中，之后创建同类型的临时结构体时复用，返回是否放入了池中
+         */
+        static int Release(lua_State* L)
+        {
+            lua_pushboolean(L, ReleaseStructUserdata(L, 1));
+            return 1;
+        }
+
+        /**
+         * UnLua.AddListeners(Object, {Delegate1, Function1, Delegate2, Function2, ...})
+         *
+         * 一次调用把多个Lua函数添加到多播委托上，已添加的会被跳过，返回实际添加的数量
+         */
+        static int AddListeners(lua_State* L)
+        {
+            const auto Object = GetUObject(L, 1);
+            if (!Object)
+                return luaL_error(L, "invalid UObject");
+            luaL_checktype(L, 2, LUA_TTABLE);
+
+            const auto Registry = FLuaEnv::FindEnvChecked(L).GetDelegateRegistry();
+            lua_pushinteger(L, Registry->AddListeners(L, Object, 2));
+            return 1;
+        }
+
+        /**
+         * UnLua.RemoveListeners(Object, {Delegate1, Function1, Delegate2, Function2, ...})
+         */
+        static int RemoveListeners(lua_State* L)
+        {
+            const auto Object = GetUObject(L, 1);
+            if (!Object)
+                return luaL_error(L, "invalid UObject");
+            luaL_checktype(L, 2, LUA_TTABLE);
+
+            const auto Registry = FLuaEnv::FindEnvChecked(L).GetDelegateRegistry();
+            lua_pushinteger(L, Registry->RemoveListeners(L, Object, 2));
+            return 1;
+        }
+
         static constexpr luaL_Reg UnLua_Functions[] = {
             {"Log", LogInfo},
             {"LogWarn", LogWarn},
@@ -88,6 +141,11 @@ namespace UnLua
             {"HotReload", HotReload},
             {"Ref", Ref},
             {"Unref", Unref},
+            {"Snapshot", SnapshotLib::Snapshot},
+            {"Apply", SnapshotLib::Apply},
+            {"Release", Release},
+            {"AddListeners", AddListeners},
+            {"RemoveListeners", RemoveListeners},
             {"FTextEnabled", nullptr},
             {NULL, NULL}
         };
@@ -139,63 +197,102 @@ namespace UnLua
             return 0;
         }
 
+        /**
+         * UnLua.Class()创建的类的__index，upvalue 1为表示字段不存在的哨兵表
+         */
+        static int32 LegacyIndex(lua_State* L)
+        {
+            if (!lua_getmetatable(L, 1))
+                return luaL_error(L, "attempt to index a value without metatable");
+            const int32 MetatableIndex = lua_gettop(L);
+
+            // 沿Super链查找模块中定义的字段，找到后缓存到实例上
+            lua_pushvalue(L, MetatableIndex);
+            while (lua_istable(L, -1))
+            {
+                lua_pushvalue(L, 2);
+                lua_rawget(L, -2);
+                if (!lua_isnil(L, -1) && !lua_rawequal(L, -1, lua_upvalueindex(1)))
+                {
+                    lua_pushvalue(L, 2);
+                    lua_pushvalue(L, -2);
+                    lua_rawset(L, 1);
+                    return 1;
+                }
+                lua_pop(L, 1);
+                lua_pushstring(L, "Super");
+                lua_rawget(L, -2);
+                lua_remove(L, -2);
+            }
+            lua_pop(L, 1);
+
+            lua_pushvalue(L, 2);
+            switch (lua_gettable(L, MetatableIndex))
+            {
+            case LUA_TNIL:
+                lua_pushvalue(L, 2);
+                lua_pushvalue(L, lua_upvalueindex(1));
+                lua_rawset(L, MetatableIndex);
+                return 1;
+            case LUA_TUSERDATA:
+                lua_replace(L, 2);
+                lua_settop(L, 2);
+                return GetUProperty(L);
+            case LUA_TFUNCTION:
+                lua_pushvalue(L, 2);
+                lua_pushvalue(L, -2);
+                lua_rawset(L, 1);
+                return 1;
+            default:
+                if (lua_rawequal(L, -1, lua_upvalueindex(1)))
+                    lua_pushnil(L);
+                return 1;
+            }
+        }
+
+        /**
+         * UnLua.Class()创建的类的__newindex，反射属性直接写入，其余字段写到实例上
+         */
+        static int32 LegacyNewIndex(lua_State* L)
+        {
+            lua_settop(L, 3);
+            if (!lua_getmetatable(L, 1))
+                return luaL_error(L, "attempt to index a value without metatable");
+
+            lua_pushvalue(L, 2);
+            if (lua_gettable(L, -2) == LUA_TUSERDATA)
+            {
+                lua_replace(L, 2);
+                lua_settop(L, 3);
+                return SetUProperty(L);
+            }
+
+            lua_settop(L, 3);
+            lua_rawset(L, 1);
+            return 0;
+        }
+
         static constexpr luaL_Reg UnLua_LegacyFunctions[] = {
             {"GetUProperty", GetUProperty},
             {"SetUProperty", SetUProperty},
             {NULL, NULL}
         };
 
+        static constexpr luaL_Reg UnLua_LegacyMetamethods[] = {
+            {"Index", LegacyIndex},
+            {"NewIndex", LegacyNewIndex},
+            {NULL, NULL}
+        };
+
         static void LegacySupport(lua_State* L)
         {
             static const char* Chunk = R"(
-            local rawget = _G.rawget
-            local rawset = _G.rawset
-            local rawequal = _G.rawequal
-            local type = _G.type
-            local getmetatable = _G.getmetatable
             local require = _G.require
 
             local GetUProperty = GetUProperty
             local SetUProperty = SetUProperty
-
-            local NotExist = {}
-
-            local function Index(t, k)
-                local mt = getmetatable(t)
-                local super = mt
-                while super do
-                    local v = rawget(super, k)
-                    if v ~= nil and not rawequal(v, NotExist) then
-                        rawset(t, k, v)
-                        return v
-                    end
-                    super = rawget(super, "Super")
-                end
-
-                local p = mt[k]
-                if p ~= nil then
-                    if type(p) == "userdata" then
-                        return GetUProperty(t, p)
-                    elseif type(p) == "function" then
-                        rawset(t, k, p)
-                    elseif rawequal(p, NotExist) then
-                        return nil
-                    end
-                else
-                    rawset(mt, k, NotExist)
-                end
-
-                return p
-            end
-
-            local function NewIndex(t, k, v)
-                local mt = getmetatable(t)
-                local p = mt[k]
-                if type(p) == "userdata" then
-                    return SetUProperty(t, p, v)
-                end
-                rawset(t, k, v)
-            end
+            local Index = Index
+            local NewIndex = NewIndex
 
             local function Class(super_name)
                 local super_class = nil
@@ -222,6 +319,8 @@ namespace UnLua
             lua_getglobal(L, LUA_GNAME);
             lua_setfield(L, -2, LUA_GNAME);
             luaL_setfuncs(L, UnLua_LegacyFunctions, 0);
+            lua_newtable(L);
+            luaL_setfuncs(L, UnLua_LegacyMetamethods, 1);
             lua_setupvalue(L, -2, 1);
             lua_pcall(L, 0, LUA_MULTRET, 0);
             lua_getglobal(L, "Class");
@@ -264,6 +363,7 @@ namespace UnLua
 #endif
 
 #if UNLUA_WITH_HOT_RELOAD
+            HotReloadLib::Open(L);
             luaL_dostring(L, R"(
                 pcall(function() _G.require = require('UnLua.HotReload').require end)
             )");
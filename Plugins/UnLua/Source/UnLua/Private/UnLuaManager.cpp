@@ -29,8 +29,138 @@
 
 static const TCHAR* SReadableInputEvent[] = { TEXT("Pressed"), TEXT("Released"), TEXT("Repeat"), TEXT("DoubleClick"), TEXT("Axis"), TEXT("Max") };
 
+namespace
+{
+    /**
+     * 输入事件直接调用Lua实例上的同名函数，不再为每个输入生成ULuaFunction，参数以Lua值传递
+     */
+    struct FLuaInputDispatcher
+    {
+        TWeakObjectPtr<UUnLuaManager> Manager;
+        TArray<ANSICHAR> FunctionName;
+
+        FLuaInputDispatcher(UUnLuaManager* InManager, FName InFunctionName)
+            : Manager(InManager)
+        {
+            const FTCHARToUTF8 Name(*InFunctionName.ToString());
+            FunctionName.Append(Name.Get(), Name.Length() + 1);
+        }
+
+        template <typename... ArgTypes>
+        void Call(AActor* Actor, const ArgTypes&... Args) const
+        {
+            const UUnLuaManager* LocalManager = Manager.Get();
+            if (!LocalManager || !LocalManager->Env)
+                return;
+
+            const auto Env = LocalManager->Env;
+            const auto SelfRef = Env->GetObjectRegistry()->GetBoundRef(Actor);
+            if (SelfRef == LUA_NOREF)
+                return;
+
+            const auto L = Env->GetMainState();
+            const int32 Top = lua_gettop(L);
+            lua_pushcfunction(L, UnLua::ReportLuaCallError);
+            if (!PushLuaFunction(L, SelfRef))
+            {
+                lua_settop(L, Top);
+                return;
+            }
+
+            int32 NumArgs = 1;
+            const int32 Dummy[] = { 0, (NumArgs += PushArg(L, Args))... };
+            (void)Dummy;
+
+            const auto Guard = Env->GetDeadLoopCheck()->MakeGuard();
+            lua_pcall(L, NumArgs, 0, Top + 1);
+            lua_settop(L, Top);
+        }
+
+    private:
+        /* 沿模块的Super链查找函数，成功时栈上依次为函数和self */
+        bool PushLuaFunction(lua_State* L, int32 SelfRef) const
+        {
+            if (lua_rawgeti(L, LUA_REGISTRYINDEX, SelfRef) != LUA_TTABLE || !lua_getmetatable(L, -1))
+                return false;
+
+            do
+            {
+                lua_pushstring(L, FunctionName.GetData());
+                if (lua_rawget(L, -2) == LUA_TFUNCTION)
+                {
+                    lua_replace(L, -2);
+                    lua_insert(L, -2);
+                    return true;
+                }
+                lua_pop(L, 1);
+                lua_pushstring(L, "Super");
+                lua_rawget(L, -2);
+                lua_remove(L, -2);
+            } while (lua_istable(L, -1));
+            return false;
+        }
+
+        static int32 PushArg(lua_State* L, float Value)
+        {
+            lua_pushnumber(L, Value);
+            return 1;
+        }
+
+        static int32 PushArg(lua_State* L, ETouchIndex::Type Value)
+        {
+            lua_pushinteger(L, Value);
+            return 1;
+        }
+
+        static int32 PushArg(lua_State* L, const FVector& Value)
+        {
+            void* Userdata = NewTypedUserdata(L, FVector);
+            new(Userdata) FVector(Value);
+            return 1;
+        }
+
+        static int32 PushArg(lua_State* L, const FKey& Key)
+        {
+            // 传给Lua的是拷贝，Lua侧修改不会影响EKeys中注册的FKey
+            void* Userdata = NewTypedUserdata(L, FKey);
+            new(Userdata) FKey(Key);
+            return 1;
+        }
+    };
+
+    void BindLuaInput(FInputActionUnifiedDelegate& Delegate, UUnLuaManager* Manager, AActor* Actor, FName FuncName)
+    {
+        const FLuaInputDispatcher Dispatcher(Manager, FuncName);
+        Delegate.GetDelegateWithKeyForManualSet().BindWeakLambda(Actor, [Dispatcher, Actor](const FKey Key) { Dispatcher.Call(Actor, Key); });
+    }
+
+    void BindLuaInput(FInputAxisUnifiedDelegate& Delegate, UUnLuaManager* Manager, AActor* Actor, FName FuncName)
+    {
+        const FLuaInputDispatcher Dispatcher(Manager, FuncName);
+        Delegate.GetDelegateForManualSet().BindWeakLambda(Actor, [Dispatcher, Actor](const float AxisValue) { Dispatcher.Call(Actor, AxisValue); });
+    }
+
+    void BindLuaInput(FInputTouchUnifiedDelegate& Delegate, UUnLuaManager* Manager, AActor* Actor, FName FuncName)
+    {
+        const FLuaInputDispatcher Dispatcher(Manager, FuncName);
+        Delegate.GetDelegateForManualSet().BindWeakLambda(Actor, [Dispatcher, Actor](const ETouchIndex::Type FingerIndex, const FVector Location) { Dispatcher.Call(Actor, FingerIndex, Location); });
+    }
+
+    void BindLuaInput(FInputVectorAxisUnifiedDelegate& Delegate, UUnLuaManager* Manager, AActor* Actor, FName FuncName)
+    {
+        const FLuaInputDispatcher Dispatcher(Manager, FuncName);
+        Delegate.GetDelegateForManualSet().BindWeakLambda(Actor, [Dispatcher, Actor](const FVector AxisValue) { Dispatcher.Call(Actor, AxisValue); });
+    }
+
+    void BindLuaInput(FInputGestureUnifiedDelegate& Delegate, UUnLuaManager* Manager, AActor* Actor, FName FuncName)
+    {
+        const FLuaInputDispatcher Dispatcher(Manager, FuncName);
+        Delegate.GetDelegateForManualSet().BindWeakLambda(Actor, [Dispatcher, Actor](const float Value) { Dispatcher.Call(Actor, Value); });
+    }
+}
+
 UUnLuaManager::UUnLuaManager()
-    : InputActionFunc(nullptr), InputAxisFunc(nullptr), InputTouchFunc(nullptr), InputVectorAxisFunc(nullptr), InputGestureFunc(nullptr), AnimNotifyFunc(nullptr)
+    : AnimNotifyFunc(nullptr)
 {
     if (HasAnyFlags(RF_ClassDefaultObject))
     {
@@ -40,14 +170,8 @@ UUnLuaManager::UUnLuaManager()
     GetDefaultInputs();             // get all Axis/Action inputs
     EKeys::GetAllKeys(AllKeys);     // get all key inputs
 
-    // get template input UFunctions for InputAction/InputAxis/InputTouch/InputVectorAxis/InputGesture/AnimNotify
-    UClass *Class = GetClass();
-    InputActionFunc = Class->FindFunctionByName(FName("InputAction"));
-    InputAxisFunc = Class->FindFunctionByName(FName("InputAxis"));
-    InputTouchFunc = Class->FindFunctionByName(FName("InputTouch"));
-    InputVectorAxisFunc = Class->FindFunctionByName(FName("InputVectorAxis"));
-    InputGestureFunc = Class->FindFunctionByName(FName("InputGesture"));
-    AnimNotifyFunc = Class->FindFunctionByName(FName("TriggerAnimNotify"));
+    // get template UFunction for AnimNotify, inputs are dispatched to Lua natively
+    AnimNotifyFunc = GetClass()->FindFunctionByName(FName("TriggerAnimNotify"));
 }
 
 /**
@@ -366,8 +490,6 @@ bool UUnLuaManager::BindClass(UClass* Class, const FString& InModuleName, FStrin
  */
 void UUnLuaManager::ReplaceActionInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions)
 {
-    UClass *Class = Actor->GetClass();
-
     TSet<FName> ActionNames;
     int32 NumActionBindings = InputComponent->GetNumActionBindings();
     for (int32 i = 0; i < NumActionBindings; ++i)
@@ -380,8 +502,7 @@ void UUnLuaManager::ReplaceActionInputs(AActor *Actor, UInputComponent *InputCom
         FName FuncName = FName(*FString::Printf(TEXT("%s_%s"), *ActionName, SReadableInputEvent[IAB.KeyEvent]));
         if (LuaFunctions.Find(FuncName))
         {
-            ULuaFunction::Override(InputActionFunc, Class, FuncName);
-            IAB.ActionDelegate.BindDelegate(Actor, FuncName);
+            BindLuaInput(IAB.ActionDelegate, this, Actor, FuncName);
         }
 
         if (!IS_INPUT_ACTION_PAIRED(IAB))
@@ -390,9 +511,8 @@ void UUnLuaManager::ReplaceActionInputs(AActor *Actor, UInputComponent *InputCom
             FuncName = FName(*FString::Printf(TEXT("%s_%s"), *ActionName, SReadableInputEvent[IE]));
             if (LuaFunctions.Find(FuncName))
             {
-                ULuaFunction::Override(InputActionFunc, Class, FuncName);
                 FInputActionBinding AB(Name, IE);
-                AB.ActionDelegate.BindDelegate(Actor, FuncName);
+                BindLuaInput(AB.ActionDelegate, this, Actor, FuncName);
                 InputComponent->AddActionBinding(AB);
             }
         }
@@ -408,9 +528,8 @@ void UUnLuaManager::ReplaceActionInputs(AActor *Actor, UInputComponent *InputCom
             FName FuncName = FName(*FString::Printf(TEXT("%s_%s"), *ActionName.ToString(), SReadableInputEvent[IEs[i]]));
             if (LuaFunctions.Find(FuncName))
             {
-                ULuaFunction::Override(InputActionFunc, Class, FuncName);
                 FInputActionBinding AB(ActionName, IEs[i]);
-                AB.ActionDelegate.BindDelegate(Actor, FuncName);
+                BindLuaInput(AB.ActionDelegate, this, Actor, FuncName);
                 InputComponent->AddActionBinding(AB);
             }
         }
@@ -422,8 +541,6 @@ void UUnLuaManager::ReplaceActionInputs(AActor *Actor, UInputComponent *InputCom
  */
 void UUnLuaManager::ReplaceKeyInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions)
 {
-    UClass *Class = Actor->GetClass();
-
     TArray<FKey> Keys;
     TArray<bool> PairedKeys;
     TArray<EInputEvent> InputEvents;
@@ -444,8 +561,7 @@ void UUnLuaManager::ReplaceKeyInputs(AActor *Actor, UInputComponent *InputCompon
         FName FuncName = FName(*FString::Printf(TEXT("%s_%s"), *IKB.Chord.Key.ToString(), SReadableInputEvent[IKB.KeyEvent]));
         if (LuaFunctions.Find(FuncName))
         {
-            ULuaFunction::Override(InputActionFunc, Class, FuncName);
-            IKB.KeyDelegate.BindDelegate(Actor, FuncName);
+            BindLuaInput(IKB.KeyDelegate, this, Actor, FuncName);
         }
     }
 
@@ -457,9 +573,8 @@ void UUnLuaManager::ReplaceKeyInputs(AActor *Actor, UInputComponent *InputCompon
             FName FuncName = FName(*FString::Printf(TEXT("%s_%s"), *Keys[i].ToString(), SReadableInputEvent[IE]));
             if (LuaFunctions.Find(FuncName))
             {
-                ULuaFunction::Override(InputActionFunc, Class, FuncName);
                 FInputKeyBinding IKB(FInputChord(Keys[i]), IE);
-                IKB.KeyDelegate.BindDelegate(Actor, FuncName);
+                BindLuaInput(IKB.KeyDelegate, this, Actor, FuncName);
                 InputComponent->KeyBindings.Add(IKB);
             }
         }
@@ -477,9 +592,8 @@ void UUnLuaManager::ReplaceKeyInputs(AActor *Actor, UInputComponent *InputCompon
             FName FuncName = FName(*FString::Printf(TEXT("%s_%s"), *Key.ToString(), SReadableInputEvent[IEs[i]]));
             if (LuaFunctions.Find(FuncName))
             {
-                ULuaFunction::Override(InputActionFunc, Class, FuncName);
                 FInputKeyBinding IKB(FInputChord(Key), IEs[i]);
-                IKB.KeyDelegate.BindDelegate(Actor, FuncName);
+                BindLuaInput(IKB.KeyDelegate, this, Actor, FuncName);
                 InputComponent->KeyBindings.Add(IKB);
             }
         }
@@ -491,16 +605,13 @@ void UUnLuaManager::ReplaceKeyInputs(AActor *Actor, UInputComponent *InputCompon
  */
 void UUnLuaManager::ReplaceAxisInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions)
 {
-    UClass *Class = Actor->GetClass();
-
     TSet<FName> AxisNames;
     for (FInputAxisBinding &IAB : InputComponent->AxisBindings)
     {
         AxisNames.Add(IAB.AxisName);
         if (LuaFunctions.Find(IAB.AxisName))
         {
-            ULuaFunction::Override(InputAxisFunc, Class, IAB.AxisName);
-            IAB.AxisDelegate.BindDelegate(Actor, IAB.AxisName);
+            BindLuaInput(IAB.AxisDelegate, this, Actor, IAB.AxisName);
         }
     }
 
@@ -509,9 +620,8 @@ void UUnLuaManager::ReplaceAxisInputs(AActor *Actor, UInputComponent *InputCompo
     {
         if (LuaFunctions.Find(*It))
         {
-            ULuaFunction::Override(InputAxisFunc, Class, *It);
             FInputAxisBinding &IAB = InputComponent->BindAxis(*It);
-            IAB.AxisDelegate.BindDelegate(Actor, *It);
+            BindLuaInput(IAB.AxisDelegate, this, Actor, *It);
         }
     }
 }
@@ -521,8 +631,6 @@ void UUnLuaManager::ReplaceAxisInputs(AActor *Actor, UInputComponent *InputCompo
  */
 void UUnLuaManager::ReplaceTouchInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions)
 {
-    UClass *Class = Actor->GetClass();
-
     TArray<EInputEvent> InputEvents = { IE_Pressed, IE_Released, IE_Repeat };        // IE_DoubleClick?
     for (FInputTouchBinding &ITB : InputComponent->TouchBindings)
     {
@@ -530,8 +638,7 @@ void UUnLuaManager::ReplaceTouchInputs(AActor *Actor, UInputComponent *InputComp
         FName FuncName = FName(*FString::Printf(TEXT("Touch_%s"), SReadableInputEvent[ITB.KeyEvent]));
         if (LuaFunctions.Find(FuncName))
         {
-            ULuaFunction::Override(InputTouchFunc, Class, FuncName);
-            ITB.TouchDelegate.BindDelegate(Actor, FuncName);
+            BindLuaInput(ITB.TouchDelegate, this, Actor, FuncName);
         }
     }
 
@@ -540,9 +647,8 @@ void UUnLuaManager::ReplaceTouchInputs(AActor *Actor, UInputComponent *InputComp
         FName FuncName = FName(*FString::Printf(TEXT("Touch_%s"), SReadableInputEvent[IE]));
         if (LuaFunctions.Find(FuncName))
         {
-            ULuaFunction::Override(InputTouchFunc, Class, FuncName);
             FInputTouchBinding ITB(IE);
-            ITB.TouchDelegate.BindDelegate(Actor, FuncName);
+            BindLuaInput(ITB.TouchDelegate, this, Actor, FuncName);
             InputComponent->TouchBindings.Add(ITB);
         }
     }
@@ -553,14 +659,12 @@ void UUnLuaManager::ReplaceTouchInputs(AActor *Actor, UInputComponent *InputComp
  */
 void UUnLuaManager::ReplaceAxisKeyInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions)
 {
-    UClass *Class = Actor->GetClass();
     for (FInputAxisKeyBinding &IAKB : InputComponent->AxisKeyBindings)
     {
         FName FuncName = IAKB.AxisKey.GetFName();
         if (LuaFunctions.Find(FuncName))
         {
-            ULuaFunction::Override(InputAxisFunc, Class, FuncName);
-            IAKB.AxisDelegate.BindDelegate(Actor, FuncName);
+            BindLuaInput(IAKB.AxisDelegate, this, Actor, FuncName);
         }
     }
 }
@@ -570,14 +674,12 @@ void UUnLuaManager::ReplaceAxisKeyInputs(AActor *Actor, UInputComponent *InputCo
  */
 void UUnLuaManager::ReplaceVectorAxisInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions)
 {
-    UClass *Class = Actor->GetClass();
     for (FInputVectorAxisBinding &IVAB : InputComponent->VectorAxisBindings)
     {
         FName FuncName = IVAB.AxisKey.GetFName();
         if (LuaFunctions.Find(FuncName))
         {
-            ULuaFunction::Override(InputVectorAxisFunc, Class, FuncName);
-            IVAB.AxisDelegate.BindDelegate(Actor, FuncName);
+            BindLuaInput(IVAB.AxisDelegate, this, Actor, FuncName);
         }
     }
 }
@@ -587,14 +689,12 @@ void UUnLuaManager::ReplaceVectorAxisInputs(AActor *Actor, UInputComponent *Inpu
  */
 void UUnLuaManager::ReplaceGestureInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions)
 {
-    UClass *Class = Actor->GetClass();
     for (FInputGestureBinding &IGB : InputComponent->GestureBindings)
     {
         FName FuncName = IGB.GestureKey.GetFName();
         if (LuaFunctions.Find(FuncName))
         {
-            ULuaFunction::Override(InputGestureFunc, Class, FuncName);
-            IGB.GestureDelegate.BindDelegate(Actor, FuncName);
+            BindLuaInput(IGB.GestureDelegate, this, Actor, FuncName);
         }
     }
 }
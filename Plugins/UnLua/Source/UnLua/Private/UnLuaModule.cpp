@@ -23,10 +23,11 @@
 #include "UnLuaConsoleCommands.h"
 #endif
 
+#include "Async/ParallelFor.h"
 #include "Engine/World.h"
 #include "UnLuaModule.h"
-#include "DefaultParamCollection.h"
 #include "GameDelegates.h"
+#include "LuaCore.h"
 #include "LuaEnvLocator.h"
 #include "LuaOverrides.h"
 #include "UnLuaDebugBase.h"
@@ -59,8 +60,6 @@ namespace UnLua
 
             FCoreUObjectDelegates::PostLoadMapWithWorld.AddRaw(this, &FUnLuaModule::PostLoadMapWithWorld);
 
-            CreateDefaultParamCollection();
-
 #if AUTO_UNLUA_STARTUP
 #if WITH_EDITOR
             if (!IsRunningGame())
@@ -106,26 +105,9 @@ namespace UnLua
                 EnvLocator->AddToRoot();
                 FDeadLoopCheck::Timeout = Settings.DeadLoopCheck;
                 FDanglingCheck::Enabled = Settings.DanglingCheck;
+                GLuaStructPoolCapacity = Settings.StructPoolCapacity;
 
-                for (const auto Class : TObjectRange<UClass>())
-                {
-                    for (const auto& ClassPath : Settings.PreBindClasses)
-                    {
-                        if (!ClassPath.IsValid())
-                            continue;
-
-                        const auto TargetClass = ClassPath.ResolveClass();
-                        if (!TargetClass)
-                            continue;
-
-                        if (Class->IsChildOf(TargetClass))
-                        {
-                            const auto Env = EnvLocator->Locate(Class);
-                            Env->TryBind(Class);
-                            break;
-                        }
-                    }
-                }
+                PreBindClasses(Settings);
             }
             else
             {
@@ -156,7 +138,80 @@ namespace UnLua
             EnvLocator->HotReload();
         }
 
+        virtual void HotReload(const TArray<FString>& ModuleNames) override
+        {
+            if (!bIsActive)
+                return;
+            EnvLocator->HotReload(ModuleNames);
+        }
+
     private:
+        void PreBindClasses(const UUnLuaSettings& Settings) const
+        {
+            TArray<UClass*> TargetClasses;
+            for (const auto& ClassPath : Settings.PreBindClasses)
+            {
+                if (!ClassPath.IsValid())
+                    continue;
+
+                if (const auto TargetClass = ClassPath.ResolveClass())
+                    TargetClasses.AddUnique(TargetClass);
+            }
+
+            if (TargetClasses.Num() == 0)
+                return;
+
+            TArray<UClass*> AllClasses;
+            for (const auto Class : TObjectRange<UClass>())
+                AllClasses.Add(Class);
+
+            // 能在工作线程中调用的Locator顺便解析模块名，游戏线程上直接命中缓存
+            const auto Locator = Settings.ModuleLocatorClass.GetDefaultObject();
+            const bool bLocateConcurrently = Locator && Locator->CanLocateConcurrently();
+
+            // 类层级、UnLuaInterface和类名的检查只读反射数据，放到工作线程并行进行，游戏线程只处理真正需要绑定的类
+            struct FCandidate
+            {
+                bool bMatched = false;
+                FString ModuleName;
+            };
+            TArray<FCandidate> Candidates;
+            Candidates.SetNum(AllClasses.Num());
+            const UClass* InterfaceClass = UUnLuaInterface::StaticClass();
+            ParallelFor(AllClasses.Num(), [&](const int32 Index)
+            {
+                UClass* Class = AllClasses[Index];
+                if (Class->HasAnyClassFlags(CLASS_NewerVersionExists))
+                    return;
+
+                const bool bIsTarget = TargetClasses.ContainsByPredicate([Class](const UClass* TargetClass) { return Class->IsChildOf(TargetClass); });
+                if (!bIsTarget || !Class->ImplementsInterface(InterfaceClass))
+                    return;
+
+                const FString ClassName = Class->GetName();
+                if (ClassName.Contains(TEXT("SKEL_")) || ClassName.StartsWith(TEXT("REINST_")))
+                    return;
+
+                auto& Candidate = Candidates[Index];
+                Candidate.bMatched = true;
+                if (bLocateConcurrently)
+                    Candidate.ModuleName = Locator->Locate(Class);
+            });
+
+            for (int32 Index = 0; Index < AllClasses.Num(); ++Index)
+            {
+                const auto& Candidate = Candidates[Index];
+                if (!Candidate.bMatched)
+                    continue;
+
+                const auto Class = AllClasses[Index];
+                if (bLocateConcurrently)
+                    Locator->AddToCache(Class, Candidate.ModuleName);
+                const auto Env = EnvLocator->Locate(Class);
+                Env->TryBind(Class);
+            }
+        }
+
         virtual void NotifyUObjectCreated(const UObjectBase* ObjectBase, int32 Index) override
         {
             // UE_LOG(LogTemp, Log, TEXT("NotifyUObjectCreated : %p"), ObjectBase);
@@ -47,6 +47,7 @@ DECLARE_MEMORY_STAT_EXTERN(TEXT("Lua Memory"), STAT_UnLua_Lua_Memory, STATGROUP_
 DECLARE_MEMORY_STAT_EXTERN(TEXT("Persistent Parameter Buffer Memory"), STAT_UnLua_PersistentParamBuffer_Memory, STATGROUP_UnLua, /*UNLUA_API*/);
 DECLARE_MEMORY_STAT_EXTERN(TEXT("OutParmRec Memory"), STAT_UnLua_OutParmRec_Memory, STATGROUP_UnLua, /*UNLUA_API*/);
 DECLARE_MEMORY_STAT_EXTERN(TEXT("Container Element Cache Memory"), STAT_UnLua_ContainerElementCache_Memory, STATGROUP_UnLua, /*UNLUA_API*/);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Struct Pool Memory"), STAT_UnLua_StructPool_Memory, STATGROUP_UnLua, /*UNLUA_API*/);
 
 #define UNLUA_DEFINE_STAT(Name) \
     DEFINE_STAT(STAT_UnLua_##Name);
@@ -59,6 +60,12 @@ DECLARE_MEMORY_STAT_EXTERN(TEXT("Container Element Cache Memory"), STAT_UnLua_Co
     const auto _FreedSize = FMemory::GetAllocSize(PointerName); \
     DEC_MEMORY_STAT_BY(STAT_UnLua_##CounterName##_Memory, _FreedSize);
 
+#define UNLUA_STAT_MEMORY_INC(CounterName, Size) \
+    INC_MEMORY_STAT_BY(STAT_UnLua_##CounterName##_Memory, Size);
+
+#define UNLUA_STAT_MEMORY_DEC(CounterName, Size) \
+    DEC_MEMORY_STAT_BY(STAT_UnLua_##CounterName##_Memory, Size);
+
 #define UNLUA_STAT_MEMORY_REALLOC(Pointer, NewPointer, CounterName) \
     struct FReallocGuard { \
         uint32 OldSize; \
@@ -88,6 +95,8 @@ DECLARE_MEMORY_STAT_EXTERN(TEXT("Container Element Cache Memory"), STAT_UnLua_Co
 
 #define UNLUA_STAT_MEMORY_ALLOC(Pointer, CounterName)
 #define UNLUA_STAT_MEMORY_FREE(PointerName, CounterName)
+#define UNLUA_STAT_MEMORY_INC(CounterName, Size)
+#define UNLUA_STAT_MEMORY_DEC(CounterName, Size)
 #define UNLUA_STAT_MEMORY_REALLOC(Pointer, NewPointer, CounterName)
 
 #define UNLUA_DECLARE_CYCLE_STAT(FriendlyName, StatName)
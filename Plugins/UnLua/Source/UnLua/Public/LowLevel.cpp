@@ -217,5 +217,67 @@ namespace UnLua
             const auto Alignment = CppStructOps ? CppStructOps->GetAlignment() : ScriptStruct->GetMinAlignment();
             return CalcUserdataPadding(Alignment);
         }
+
+        static char TypeIdKey;
+
+        static TMap<FName, int32>& GetTypeIds()
+        {
+            static TMap<FName, int32> TypeIds;
+            return TypeIds;
+        }
+
+        static TArray<FName>& GetTypeNames()
+        {
+            static TArray<FName> TypeNames = {NAME_None};
+            return TypeNames;
+        }
+
+        int32 GetTypeId(const char* MetatableName)
+        {
+            if (!MetatableName || !*MetatableName)
+                return 0;
+
+            const FName Name(UTF8_TO_TCHAR(MetatableName));
+            if (const int32* TypeId = GetTypeIds().Find(Name))
+                return *TypeId;
+
+            const int32 TypeId = GetTypeNames().Add(Name);
+            GetTypeIds().Add(Name, TypeId);
+            return TypeId;
+        }
+
+        int32 GetTypeId(lua_State* L, int32 Index)
+        {
+            if (!lua_getmetatable(L, Index))
+                return 0;
+
+            int32 TypeId;
+            if (lua_rawgetp(L, -1, &TypeIdKey) == LUA_TNUMBER)
+            {
+                TypeId = (int32)lua_tointeger(L, -1);
+                lua_pop(L, 2);
+                return TypeId;
+            }
+            lua_pop(L, 1);
+
+            lua_pushstring(L, "__name");
+            lua_rawget(L, -2);
+            TypeId = GetTypeId(lua_tostring(L, -1));
+            lua_pop(L, 1);
+
+            if (TypeId)
+            {
+                lua_pushinteger(L, TypeId);
+                lua_rawsetp(L, -2, &TypeIdKey);
+            }
+            lua_pop(L, 1);
+            return TypeId;
+        }
+
+        FString GetTypeName(int32 TypeId)
+        {
+            const TArray<FName>& TypeNames = GetTypeNames();
+            return TypeNames.IsValidIndex(TypeId) && TypeId > 0 ? TypeNames[TypeId].ToString() : TEXT("nil");
+        }
     }
 }
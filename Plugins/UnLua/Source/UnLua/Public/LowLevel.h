@@ -69,5 +69,14 @@ namespace UnLua
         void* GetUserdata(lua_State* L, int32 Index, bool* OutTwoLvlPtr = nullptr, bool *OutClassMetatable = nullptr);
 
         uint8 CalculateUserdataPadding(UStruct* Struct);
+
+        /* 元表名对应的类型ID，进程内唯一且不会回收，有效ID从1开始 */
+        UNLUA_API int32 GetTypeId(const char* MetatableName);
+
+        /* Index处userdata元表的类型ID，首次查询后缓存在元表上；没有元表或__name时返回0 */
+        UNLUA_API int32 GetTypeId(lua_State* L, int32 Index);
+
+        /* 类型ID对应的元表名，只用于构建错误信息 */
+        UNLUA_API FString GetTypeName(int32 TypeId);
     }
 }
@@ -38,7 +38,7 @@ public:
 
     void BindTo(FScriptDelegate* InDelegate);
 
-    void AddTo(FMulticastDelegateProperty* InProperty, void* InDelegate);
+    void AddTo(FMulticastDelegateProperty* InProperty, void* InDelegate, bool bUnique = true);
 
     virtual UWorld* GetWorld() const override;
 
@@ -46,6 +46,9 @@ public:
 
     void RemoveFrom(FMulticastDelegateProperty* InProperty, void* InDelegate);
 
+    /* 是否在多播委托的调用列表中 */
+    bool IsAddedTo(FMulticastDelegateProperty* InProperty, void* InDelegate) const;
+
     virtual void BeginDestroy() override;
 
     void Reset();
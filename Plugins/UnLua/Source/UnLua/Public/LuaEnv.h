@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include "Runtime/Launch/Resources/Version.h"
 #include "Engine/EngineBaseTypes.h"
 #include "Registries/ObjectRegistry.h"
 #include "Registries/ClassRegistry.h"
@@ -26,10 +27,14 @@
 #include "lua.hpp"
 #include "ObjectReferencer.h"
 #include "HAL/Platform.h"
+#include "Containers/Queue.h"
 #include "LuaDanglingCheck.h"
 #include "LuaDeadLoopCheck.h"
 #include "LuaModuleLocator.h"
 
+// UE5.1起Package加载完成时有通知，暂存的绑定候选对象只在所在Package加载完成后重新检查
+#define UNLUA_WITH_END_LOAD_PACKAGE (ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1))
+
 namespace UnLua
 {
     class UNLUA_API FLuaEnv
@@ -82,6 +87,9 @@ namespace UnLua
 
         virtual void HotReload();
 
+        /* 只重载指定的模块以及依赖它们的模块 */
+        virtual void HotReload(const TArray<FString>& ModuleNames);
+
         FORCEINLINE lua_State* GetMainState() const { return L; }
 
         void AddThread(lua_State* Thread, int32 ThreadRef);
@@ -133,6 +141,12 @@ namespace UnLua
 
         virtual lua_Alloc GetLuaAllocator() const;
 
+        /* 在异步加载线程中记下绑定候选对象，就绪后在游戏线程绑定 */
+        void EnqueueBindCandidate(UObject* Object);
+
+        /* 候选对象是否已经完成PostLoad，可以绑定 */
+        virtual bool IsReadyToBind(const UObject* Object) const;
+
         bool LoadString(lua_State* InL, const TArray<uint8>& Chunk, const FString& ChunkName = "chunk")
         {
             const char* Bytes = (char*)Chunk.GetData();
@@ -152,6 +166,16 @@ namespace UnLua
 
         void OnAsyncLoadingFlushUpdate();
 
+#if UNLUA_WITH_END_LOAD_PACKAGE
+        void OnEndLoadPackage(const FEndLoadPackageContext& Context);
+#endif
+
+        void DequeueBindCandidates(TArray<UObject*>& OutReady);
+
+        bool CollectReadyCandidates(TArray<FWeakObjectPtr>& Objects, TArray<UObject*>& OutReady);
+
+        void BindCandidates(const TArray<UObject*>& Candidates);
+
         void OnWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaTime);
 
         void RegisterDelegates();
@@ -161,9 +185,10 @@ namespace UnLua
         static TMap<lua_State*, FLuaEnv*> AllEnvs;
         TMap<FString, lua_CFunction> BuiltinLoaders;
         TArray<FLuaFileLoader> CustomLoaders;
-        TArray<FWeakObjectPtr> Candidates; // binding candidates during async loading
+        TQueue<FWeakObjectPtr, EQueueMode::Mpsc> CandidateQueue; // binding candidates during async loading
+        TMap<const UPackage*, TArray<FWeakObjectPtr>> PendingCandidates; // 尚未就绪的候选对象，按所在Package分组，只在游戏线程访问
+        TSet<FWeakObjectPtr> PendingCandidateSet;
         ULuaModuleLocator* ModuleLocator;
-        FCriticalSection CandidatesLock;
         FObjectReferencer AutoObjectReference;
         FObjectReferencer ManualObjectReference;
         UUnLuaManager* Manager = nullptr;
@@ -179,6 +204,12 @@ namespace UnLua
         TMap<lua_State*, int32> ThreadToRef;
         TMap<int32, lua_State*> RefToThread;
         FDelegateHandle OnAsyncLoadingFlushUpdateHandle;
+#if UNLUA_WITH_END_LOAD_PACKAGE
+        FDelegateHandle OnEndLoadPackageHandle;
+#endif
+#if WITH_EDITOR
+        FDelegateHandle OnObjectsReplacedHandle;
+#endif
         TArray<UInputComponent*> CandidateInputComponents;
         FDelegateHandle OnWorldTickStartHandle;
         FString Name = TEXT("Env_0");
@@ -28,6 +28,8 @@ public:
 
     virtual void HotReload();
 
+    virtual void HotReload(const TArray<FString>& ModuleNames);
+
     virtual void Reset();
 
     TSharedPtr<UnLua::FLuaEnv, ESPMode::ThreadSafe> Env;
@@ -42,6 +44,8 @@ public:
 
     virtual void HotReload() override;
 
+    virtual void HotReload(const TArray<FString>& ModuleNames) override;
+
     virtual void Reset() override;
 
     UnLua::FLuaEnv* GetDefault();
@@ -72,13 +72,21 @@ public:
 
     void Initialize();
 
+    /**
+     * 共享原函数的属性链与参数布局，代替整个复制UFunction，只用于原生类上常驻的函数
+     */
+    void ShareLayout(UFunction* Function);
+
     void Override(UFunction* Function, UClass* Class, bool bAddNew);
 
     void Restore();
 
     UClass* GetOverriddenUClass() const;
 
-    UFunction* GetOverridden() const;
+    /**
+     * 获取原函数的副本，第一次调用时才创建
+     */
+    UFunction* GetOverridden();
 
     virtual void Bind() override;
 
@@ -92,7 +100,11 @@ private:
     UPROPERTY()
     UFunction* Overridden;
 
+    FNativeFuncPtr OverriddenNativeFunc;
+    EFunctionFlags OverriddenFunctionFlags;
+
     uint8 bAdded : 1;
     uint8 bActivated : 1;
+    uint8 bSharedLayout : 1;
     TSharedPtr<FFunctionDesc> Desc;
 };
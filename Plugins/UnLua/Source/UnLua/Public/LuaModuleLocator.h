@@ -23,6 +23,40 @@ class UNLUA_API ULuaModuleLocator : public UObject
     GENERATED_BODY()
 public:
     virtual FString Locate(const UObject* Object);
+
+    /**
+     * 按类缓存Locate的结果（包括没有绑定的情况），命中时不再调用蓝图的GetModuleName，也不分配字符串。
+     * 返回nullptr表示这个类没有绑定Lua模块。
+     */
+    TSharedPtr<const FString> LocateCached(const UObject* Object);
+
+    /** 清空按类缓存的模块名，类被重新实例化或热重载后调用 */
+    void InvalidateCache();
+
+    /**
+     * Locate是否只读取类的反射数据，为true时可以在工作线程中调用，例如启动时并行解析预绑定类型的模块名。
+     * 内置的ULuaModuleLocator_ByPackage开启，其他Locator可能调用蓝图的GetModuleName，默认关闭。
+     */
+    virtual bool CanLocateConcurrently() const;
+
+    /** 写入按类缓存的模块名，ModuleName为空表示这个类没有绑定Lua模块 */
+    TSharedPtr<const FString> AddToCache(const UClass* Class, const FString& ModuleName);
+
+protected:
+    /**
+     * Locate的结果是否只由类决定，为true时LocateCached才按类缓存。
+     * 内置的Locator默认开启，派生类需要自行重写后才会缓存。
+     */
+    virtual bool IsCacheableByClass() const;
+
+private:
+    struct FCacheEntry
+    {
+        TWeakObjectPtr<const UClass> Class;
+        TSharedPtr<const FString> ModuleName;
+    };
+
+    TMap<const UClass*, FCacheEntry> ModuleNameCache;
 };
 
 UCLASS()
@@ -31,8 +65,5 @@ class UNLUA_API ULuaModuleLocator_ByPackage : public ULuaModuleLocator
     GENERATED_BODY()
 public:
     virtual FString Locate(const UObject* Object) override;
-
-private:
-    TMap<FName, FString> Cache;
 };
 
@@ -36,9 +36,13 @@ namespace UnLua
         virtual void GenerateIntelliSense(FString &Buffer) const override {}
 #endif
 
+        static int32 StaticInvoke(lua_State *L);
+
     private:
+        static int32 Call(lua_State *L, const char *ClassName);
+
         template <uint32... N>
-        void Construct(lua_State *L, TTuple<typename TArgTypeTraits<ArgType>::Type...> &Args, TIndices<N...>);
+        static void Construct(lua_State *L, const char *ClassName, TTuple<typename TArgTypeTraits<ArgType>::Type...> &Args, TIndices<N...>);
 
         FString ClassName;
     };
@@ -59,11 +63,12 @@ namespace UnLua
         virtual void GenerateIntelliSense(FString &Buffer) const override {}
 #endif
 
+        static int32 StaticInvoke(lua_State *L);
         static int32 GarbageCollect(lua_State *L);
 
     protected:
         template <uint32... N>
-        void Construct(lua_State *L, TTuple<typename TArgTypeTraits<ArgType>::Type...> &Args, TIndices<N...>);
+        static void Construct(lua_State *L, TTuple<typename TArgTypeTraits<ArgType>::Type...> &Args, TIndices<N...>);
 
         FString FuncName;
     };
@@ -91,12 +96,14 @@ namespace UnLua
     struct TDestructor : public IExportedFunction
     {
         virtual void Register(lua_State *L) override;
-        virtual int32 Invoke(lua_State *L) override;
+        virtual int32 Invoke(lua_State *L) override { return StaticInvoke(L); }
 
 #if WITH_EDITOR
         virtual FString GetName() const override { return TEXT(""); }
         virtual void GenerateIntelliSense(FString &Buffer) const override {}
 #endif
+
+        static int32 StaticInvoke(lua_State *L);
     };
 
     /**
@@ -135,6 +142,7 @@ namespace UnLua
     struct TExportedFunction : public IExportedFunction
     {
         TExportedFunction(const FString &InName, RetType(*InFunc)(ArgType...));
+        TExportedFunction(const FString &InName, lua_CFunction InInvoker);
 
         virtual void Register(lua_State *L) override;
         virtual int32 Invoke(lua_State *L) override;
@@ -147,6 +155,7 @@ namespace UnLua
     protected:
         FString Name;
         TFunction<RetType(ArgType...)> Func;
+        lua_CFunction Invoker;      // 导出宏生成的入口，被调函数在编译期绑定
     };
 
     /**
@@ -157,6 +166,7 @@ namespace UnLua
     {
         TExportedMemberFunction(const FString &InName, RetType(ClassType::*InFunc)(ArgType...), const FString &InClassName);
         TExportedMemberFunction(const FString &InName, RetType(ClassType::*InFunc)(ArgType...) const, const FString &InClassName);
+        TExportedMemberFunction(const FString &InName, lua_CFunction InInvoker, const FString &InClassName);
 
         virtual void Register(lua_State *L) override;
         virtual int32 Invoke(lua_State *L) override;
@@ -169,6 +179,7 @@ namespace UnLua
     private:
         FString Name;
         TFunction<RetType(ClassType*, ArgType...)> Func;
+        lua_CFunction Invoker;
         FString ClassName;
     };
 
@@ -181,6 +192,7 @@ namespace UnLua
         typedef TExportedFunction<RetType, ArgType...> Super;
 
         TExportedStaticMemberFunction(const FString &InName, RetType(*InFunc)(ArgType...), const FString &InClassName);
+        TExportedStaticMemberFunction(const FString &InName, lua_CFunction InInvoker, const FString &InClassName);
 
         virtual void Register(lua_State *L) override;
 
@@ -376,6 +388,11 @@ namespace UnLua
         template <typename RetType, typename... ArgType> void AddFunction(const FString &InName, RetType(ClassType::*InFunc)(ArgType...) const);
         template <typename RetType, typename... ArgType> void AddStaticFunction(const FString &InName, RetType(*InFunc)(ArgType...));
 
+        // 由导出宏调用，CalleeType::Get()返回直接调用目标函数的lambda，函数指针参数只用于推导签名
+        template <typename CalleeType, typename OwnerType, typename RetType, typename... ArgType> void AddBoundFunction(const FString &InName, RetType(OwnerType::*)(ArgType...));
+        template <typename CalleeType, typename OwnerType, typename RetType, typename... ArgType> void AddBoundFunction(const FString &InName, RetType(OwnerType::*)(ArgType...) const);
+        template <typename CalleeType, typename RetType, typename... ArgType> void AddBoundStaticFunction(const FString &InName, RetType(*)(ArgType...));
+
         template <ESPMode Mode, typename... ArgType> void AddSharedPtrConstructor();
         template <ESPMode Mode, typename... ArgType> void AddSharedRefConstructor();
 
@@ -514,29 +531,62 @@ UnLua::AddType(#Name, UnLua::GetTypeInterface<Type>()); \
                 check(bSuccess); \
             }
 
+/**
+ * Callee of an exported function, the target is bound at compile time and called directly
+ */
+#define UNLUA_MEMBER_CALLEE(Function) \
+    struct FCallee \
+    { \
+        static auto Get() { return [](ClassType *Obj, auto&&... Params) -> decltype(auto) { return Obj->Function(Forward<decltype(Params)>(Params)...); }; } \
+    };
+
+#define UNLUA_STATIC_CALLEE(Function) \
+    struct FCallee \
+    { \
+        static auto Get() { return [](auto&&... Params) -> decltype(auto) { return Function(Forward<decltype(Params)>(Params)...); }; } \
+    };
+
 #define ADD_FUNCTION(Function) \
-            Class->AddFunction(#Function, &ClassType::Function);
+            ADD_NAMED_FUNCTION(#Function, Function)
 
 #define ADD_NAMED_FUNCTION(Name, Function) \
-            Class->AddFunction(Name, &ClassType::Function);
+            { \
+                UNLUA_MEMBER_CALLEE(Function) \
+                Class->AddBoundFunction<FCallee>(Name, &ClassType::Function); \
+            }
 
 #define ADD_FUNCTION_EX(Name, RetType, Function, ...) \
-            Class->AddFunction<RetType, ##__VA_ARGS__>(Name, (RetType(ClassType::*)(__VA_ARGS__))(&ClassType::Function));
+            { \
+                UNLUA_MEMBER_CALLEE(Function) \
+                Class->AddBoundFunction<FCallee>(Name, (RetType(ClassType::*)(__VA_ARGS__))nullptr); \
+            }
 
 #define ADD_CONST_FUNCTION_EX(Name, RetType, Function, ...) \
-            Class->AddFunction<RetType, ##__VA_ARGS__>(Name, (RetType(ClassType::*)(__VA_ARGS__) const)(&ClassType::Function));
+            { \
+                UNLUA_MEMBER_CALLEE(Function) \
+                Class->AddBoundFunction<FCallee>(Name, (RetType(ClassType::*)(__VA_ARGS__) const)nullptr); \
+            }
 
 #define ADD_STATIC_FUNCTION(Function) \
-            Class->AddStaticFunction(#Function, &ClassType::Function);
+            { \
+                UNLUA_STATIC_CALLEE(ClassType::Function) \
+                Class->AddBoundStaticFunction<FCallee>(#Function, &ClassType::Function); \
+            }
 
 #define ADD_STATIC_FUNCTION_EX(Name, RetType, Function, ...) \
-            Class->AddStaticFunction<RetType, ##__VA_ARGS__>(Name, &ClassType::Function);
+            { \
+                UNLUA_STATIC_CALLEE(ClassType::Function) \
+                Class->AddBoundStaticFunction<FCallee>(Name, (RetType(*)(__VA_ARGS__))nullptr); \
+            }
 
 #define ADD_EXTERNAL_FUNCTION(RetType, Function, ...) \
-            Class->AddStaticFunction<RetType, ##__VA_ARGS__>(#Function, Function);
+            ADD_EXTERNAL_FUNCTION_EX(#Function, RetType, Function, ##__VA_ARGS__)
 
 #define ADD_EXTERNAL_FUNCTION_EX(Name, RetType, Function, ...) \
-            Class->AddStaticFunction<RetType, ##__VA_ARGS__>(Name, Function);
+            { \
+                UNLUA_STATIC_CALLEE(Function) \
+                Class->AddBoundStaticFunction<FCallee>(Name, (RetType(*)(__VA_ARGS__))nullptr); \
+            }
 
 #define ADD_STATIC_CFUNTION(Function) \
             Class->AddStaticCFunction(#Function, &ClassType::Function);
@@ -567,24 +617,21 @@ UnLua::AddType(#Name, UnLua::GetTypeInterface<Type>()); \
  * Export a global function
  */
 #define EXPORT_FUNCTION(RetType, Function, ...) \
-    static struct FExportedFunc##Function : public UnLua::TExportedFunction<RetType, ##__VA_ARGS__> \
-    { \
-        FExportedFunc##Function(const FString &InName, RetType(*InFunc)(__VA_ARGS__)) \
-            : UnLua::TExportedFunction<RetType, ##__VA_ARGS__>(InName, InFunc) \
-        { \
-            UnLua::ExportFunction(this); \
-        } \
-    } Exported##Function(#Function, Function);
+    EXPORT_FUNCTION_EX(Function, RetType, Function, ##__VA_ARGS__)
 
 #define EXPORT_FUNCTION_EX(Name, RetType, Function, ...) \
+    struct FExportedFunc##Name##Callee \
+    { \
+        static auto Get() { return [](auto&&... Params) -> decltype(auto) { return Function(Forward<decltype(Params)>(Params)...); }; } \
+    }; \
     static struct FExportedFunc##Name : public UnLua::TExportedFunction<RetType, ##__VA_ARGS__> \
     { \
-        FExportedFunc##Name(const FString &InName, RetType(*InFunc)(__VA_ARGS__)) \
-            : UnLua::TExportedFunction<RetType, ##__VA_ARGS__>(InName, InFunc) \
+        FExportedFunc##Name(const FString &InName) \
+            : UnLua::TExportedFunction<RetType, ##__VA_ARGS__>(InName, &UnLua::TStaticFunctionInvoker<FExportedFunc##Name##Callee, RetType, ##__VA_ARGS__>::Invoke) \
         { \
             UnLua::ExportFunction(this); \
         } \
-    } Exported##Name(#Name, Function);
+    } Exported##Name(#Name);
 
 /**
  * Export an enum
@@ -176,20 +176,22 @@ namespace UnLua
 
     /**
      * Invoke function...
+     *
+     * Func可以是TFunction，也可以是导出宏生成的直接调用目标函数的lambda
      */
-    template <typename RetType, typename... ArgType, uint32... N>
-    FORCEINLINE_DEBUGGABLE RetType Invoke(const TFunction<RetType(ArgType...)> &Func, TTuple<typename TArgTypeTraits<ArgType>::Type...> &Args, TIndices<N...>)
+    template <typename RetType, typename... ArgType, typename FuncType, uint32... N>
+    FORCEINLINE_DEBUGGABLE RetType Invoke(const FuncType &Func, TTuple<typename TArgTypeTraits<ArgType>::Type...> &Args, TIndices<N...>)
     {
-        return Func(Forward<ArgType>(Args.template Get<N>())...);
+        return static_cast<RetType>(Func(Forward<ArgType>(Args.template Get<N>())...));
     }
 
     template <typename RetType, bool IsClass = TIsClass<RetType>::Value>
     struct TInvokingHelper
     {
-        template <typename... ArgType, uint32... N>
-        static int32 Invoke(lua_State *L, const TFunction<RetType(ArgType...)> &Func, TTuple<typename TArgTypeTraits<ArgType>::Type...> &Args, TIndices<N...> ParamIndices)
+        template <typename... ArgType, typename FuncType, uint32... N>
+        static int32 Invoke(lua_State *L, const FuncType &Func, TTuple<typename TArgTypeTraits<ArgType>::Type...> &Args, TIndices<N...> ParamIndices)
         {
-            RetType RetVal = UnLua::Invoke(Func, Args, typename TZeroBasedIndices<sizeof...(ArgType)>::Type());
+            RetType RetVal = UnLua::Invoke<RetType, ArgType...>(Func, Args, typename TZeroBasedIndices<sizeof...(ArgType)>::Type());
 #if UNLUA_LEGACY_RETURN_ORDER
             int32 Num = PushNonConstRefParam<ArgType...>(L, Args, ParamIndices);
 #endif
@@ -204,20 +206,20 @@ namespace UnLua
     template <typename RetType>
     struct TInvokingHelper<RetType, true>
     {
-        template <typename... ArgType, uint32... N>
-        static int32 Invoke(lua_State *L, const TFunction<RetType(ArgType...)> &Func, TTuple<typename TArgTypeTraits<ArgType>::Type...> &Args, TIndices<N...> ParamIndices)
+        template <typename... ArgType, typename FuncType, uint32... N>
+        static int32 Invoke(lua_State *L, const FuncType &Func, TTuple<typename TArgTypeTraits<ArgType>::Type...> &Args, TIndices<N...> ParamIndices)
         {
             int32 Num = 0;
             std::remove_cv_t<RetType> *RetValPtr = lua_gettop(L) > sizeof...(ArgType) ? UnLua::Get(L, sizeof...(ArgType) + 1, TType<std::remove_cv_t<RetType>*>()) : nullptr;
             if (RetValPtr)
             {
-                *RetValPtr = UnLua::Invoke(Func, Args, typename TZeroBasedIndices<sizeof...(ArgType)>::Type());
+                *RetValPtr = UnLua::Invoke<RetType, ArgType...>(Func, Args, typename TZeroBasedIndices<sizeof...(ArgType)>::Type());
                 Num = PushNonConstRefParam<ArgType...>(L, Args, ParamIndices);
                 lua_pushvalue(L, sizeof...(ArgType) + 1);
             }
             else
             {
-                RetType RetVal = UnLua::Invoke(Func, Args, typename TZeroBasedIndices<sizeof...(ArgType)>::Type());
+                RetType RetVal = UnLua::Invoke<RetType, ArgType...>(Func, Args, typename TZeroBasedIndices<sizeof...(ArgType)>::Type());
 #if UNLUA_LEGACY_RETURN_ORDER
                 Num = PushNonConstRefParam<ArgType...>(L, Args, ParamIndices);
 #endif
@@ -232,10 +234,10 @@ namespace UnLua
 
     template <> struct TInvokingHelper<void, false>
     {
-        template <typename... ArgType, uint32... N>
-        static int32 Invoke(lua_State *L, const TFunction<void(ArgType...)> &Func, TTuple<typename TArgTypeTraits<ArgType>::Type...> &Args, TIndices<N...> ParamIndices)
+        template <typename... ArgType, typename FuncType, uint32... N>
+        static int32 Invoke(lua_State *L, const FuncType &Func, TTuple<typename TArgTypeTraits<ArgType>::Type...> &Args, TIndices<N...> ParamIndices)
         {
-            UnLua::Invoke(Func, Args, typename TZeroBasedIndices<sizeof...(ArgType)>::Type());
+            UnLua::Invoke<void, ArgType...>(Func, Args, typename TZeroBasedIndices<sizeof...(ArgType)>::Type());
             return PushNonConstRefParam<ArgType...>(L, Args, ParamIndices);
         }
     };
@@ -260,6 +262,74 @@ namespace UnLua
         return Func ? Func->Invoke(L) : 0;
     }
 
+    /**
+     * Push entry of an exported function. Functions bound at compile time are pushed as C closures with their name as upvalue
+     */
+    FORCEINLINE void PushExportedFunction(lua_State *L, IExportedFunction *Func, lua_CFunction Invoker, const FString &Name)
+    {
+        if (Invoker)
+        {
+            lua_pushstring(L, TCHAR_TO_UTF8(*Name));
+            lua_pushcclosure(L, Invoker, 1);
+        }
+        else
+        {
+            lua_pushlightuserdata(L, Func);
+            lua_pushcclosure(L, InvokeFunction, 1);
+        }
+    }
+
+    FORCEINLINE FString GetExportedFunctionName(lua_State *L)
+    {
+        const char *Name = lua_tostring(L, lua_upvalueindex(1));
+        return Name ? UTF8_TO_TCHAR(Name) : TEXT("");
+    }
+
+    /**
+     * Entry of exported global/static function, CalleeType::Get() returns a lambda calling the target directly
+     */
+    template <typename CalleeType, typename RetType, typename... ArgType>
+    struct TStaticFunctionInvoker
+    {
+        static int32 Invoke(lua_State *L)
+        {
+            constexpr int Expected = sizeof...(ArgType);
+            const int Actual = lua_gettop(L);
+            if (Actual < Expected)
+            {
+                UE_LOG(LogUnLua, Warning, TEXT("Attempted to call %s with invalid arguments. %d expected but got %d."), *GetExportedFunctionName(L), Expected, Actual);
+                return 0;
+            }
+            TTuple<typename TArgTypeTraits<ArgType>::Type...> Args = GetArgs<typename TArgTypeTraits<ArgType>::Type...>(L, typename TOneBasedIndices<Expected>::Type());
+            return TInvokingHelper<RetType>::template Invoke<ArgType...>(L, CalleeType::Get(), Args, typename TZeroBasedIndices<Expected>::Type());
+        }
+    };
+
+    /**
+     * Entry of exported member function
+     */
+    template <typename ClassType, typename CalleeType, typename RetType, typename... ArgType>
+    struct TMemberFunctionInvoker
+    {
+        static int32 Invoke(lua_State *L)
+        {
+            constexpr int Expected = sizeof...(ArgType) + 1;
+            const int Actual = lua_gettop(L);
+            if (Actual < Expected)
+            {
+                UE_LOG(LogUnLua, Warning, TEXT("Attempted to call %s with invalid arguments. %d expected but got %d."), *GetExportedFunctionName(L), Expected, Actual);
+                return 0;
+            }
+            TTuple<ClassType*, typename TArgTypeTraits<ArgType>::Type...> Args = GetArgs<ClassType*, typename TArgTypeTraits<ArgType>::Type...>(L, typename TOneBasedIndices<Expected>::Type());
+            if (Args.template Get<0>() == nullptr)
+            {
+                UE_LOG(LogUnLua, Error, TEXT("Attempted to call %s with nullptr of 'this'."), *GetExportedFunctionName(L));
+                return 0;
+            }
+            return TInvokingHelper<RetType>::template Invoke<ClassType*, ArgType...>(L, CalleeType::Get(), Args, typename TOneBasedIndices<sizeof...(ArgType)>::Type());
+        }
+    };
+
 
     /**
      * __index, __newindex functions
@@ -351,31 +421,43 @@ namespace UnLua
     {
         // make sure the meta table is on the top of the stack
         lua_pushstring(L, "__call");
-        lua_pushlightuserdata(L, this);
-        lua_pushcclosure(L, InvokeFunction, 1);
+        lua_pushstring(L, TCHAR_TO_UTF8(*ClassName));
+        lua_pushcclosure(L, StaticInvoke, 1);
         lua_rawset(L, -3);
     }
 
     template <typename ClassType, typename... ArgType>
     int32 TConstructor<ClassType, ArgType...>::Invoke(lua_State *L)
+    {
+        return Call(L, TCHAR_TO_UTF8(*ClassName));
+    }
+
+    template <typename ClassType, typename... ArgType>
+    int32 TConstructor<ClassType, ArgType...>::StaticInvoke(lua_State *L)
+    {
+        return Call(L, lua_tostring(L, lua_upvalueindex(1)));
+    }
+
+    template <typename ClassType, typename... ArgType>
+    int32 TConstructor<ClassType, ArgType...>::Call(lua_State *L, const char *ClassName)
     {
         constexpr int Expected = sizeof...(ArgType);
         const int Actual = lua_gettop(L) - 1;
         if (Actual < Expected)
         {
-            UE_LOG(LogUnLua, Warning, TEXT("Attempted to call constructor of %s with invalid arguments. %d expected but got %d."), *ClassName, Expected, Actual);
+            UE_LOG(LogUnLua, Warning, TEXT("Attempted to call constructor of %s with invalid arguments. %d expected but got %d."), UTF8_TO_TCHAR(ClassName), Expected, Actual);
             return 0;
         }
 
         TTuple<typename TArgTypeTraits<ArgType>::Type...> Args = GetArgs<typename TArgTypeTraits<ArgType>::Type...>(L, typename TOneBasedIndices<Expected>::Type(), 1);
-        Construct(L, Args, typename TZeroBasedIndices<Expected>::Type());
+        Construct(L, ClassName, Args, typename TZeroBasedIndices<Expected>::Type());
         return 1;
     }
 
     template <typename ClassType, typename... ArgType>
-    template <uint32... N> void TConstructor<ClassType, ArgType...>::Construct(lua_State *L, TTuple<typename TArgTypeTraits<ArgType>::Type...> &Args, TIndices<N...>)
+    template <uint32... N> void TConstructor<ClassType, ArgType...>::Construct(lua_State *L, const char *ClassName, TTuple<typename TArgTypeTraits<ArgType>::Type...> &Args, TIndices<N...>)
     {
-        void *Userdata = UnLua::NewUserdata(L, sizeof(ClassType), TCHAR_TO_UTF8(*ClassName), alignof(ClassType));
+        void *Userdata = UnLua::NewUserdata(L, sizeof(ClassType), ClassName, alignof(ClassType));
         if (Userdata)
         {
             new(Userdata) ClassType(Args.template Get<N>()...);
@@ -396,8 +478,7 @@ namespace UnLua
     {
         // make sure the meta table is on the top of the stack
         lua_pushstring(L, TCHAR_TO_UTF8(*FuncName));
-        lua_pushlightuserdata(L, this);
-        lua_pushcclosure(L, InvokeFunction, 1);
+        lua_pushcfunction(L, StaticInvoke);
         lua_rawset(L, -3);
 
         char MetatableName[256];
@@ -435,12 +516,18 @@ namespace UnLua
 
     template <typename SmartPtrType, typename ClassType, typename... ArgType>
     int32 TSmartPtrConstructor<SmartPtrType, ClassType, ArgType...>::Invoke(lua_State *L)
+    {
+        return StaticInvoke(L);
+    }
+
+    template <typename SmartPtrType, typename ClassType, typename... ArgType>
+    int32 TSmartPtrConstructor<SmartPtrType, ClassType, ArgType...>::StaticInvoke(lua_State *L)
     {
         constexpr int Expected = sizeof...(ArgType);
         const int Actual = lua_gettop(L); 
         if (Actual < Expected)
         {
-            UE_LOG(LogUnLua, Warning, TEXT("Attempted to call constructor of %s with invalid arguments. %d expected but got %d."), *TType<ClassType>::GetName(), Expected, Actual);
+            UE_LOG(LogUnLua, Warning, TEXT("Attempted to call constructor of %s with invalid arguments. %d expected but got %d."), UTF8_TO_TCHAR(TType<ClassType>::GetName()), Expected, Actual);
             return 0;
         }
 
@@ -483,13 +570,12 @@ namespace UnLua
     {
         // make sure the meta table is on the top of the stack
         lua_pushstring(L, "__gc");
-        lua_pushlightuserdata(L, this);
-        lua_pushcclosure(L, InvokeFunction, 1);
+        lua_pushcfunction(L, StaticInvoke);
         lua_rawset(L, -3);
     }
 
     template <typename ClassType>
-    int32 TDestructor<ClassType>::Invoke(lua_State *L)
+    int32 TDestructor<ClassType>::StaticInvoke(lua_State *L)
     {
         bool bTwoLvlPtr = false;
         ClassType *Instance = (ClassType*)UnLua::GetPointer(L, 1, &bTwoLvlPtr);
@@ -506,20 +592,29 @@ namespace UnLua
      */
     template <typename RetType, typename... ArgType>
     TExportedFunction<RetType, ArgType...>::TExportedFunction(const FString &InName, RetType(*InFunc)(ArgType...))
-        : Name(InName), Func(InFunc)
+        : Name(InName), Func(InFunc), Invoker(nullptr)
+    {}
+
+    template <typename RetType, typename... ArgType>
+    TExportedFunction<RetType, ArgType...>::TExportedFunction(const FString &InName, lua_CFunction InInvoker)
+        : Name(InName), Invoker(InInvoker)
     {}
 
     template <typename RetType, typename... ArgType>
     void TExportedFunction<RetType, ArgType...>::Register(lua_State *L)
     {
-        lua_pushlightuserdata(L, this);
-        lua_pushcclosure(L, InvokeFunction, 1);
+        PushExportedFunction(L, this, Invoker, Name);
         lua_setglobal(L, TCHAR_TO_UTF8(*Name));
     }
 
     template <typename RetType, typename... ArgType>
     int32 TExportedFunction<RetType, ArgType...>::Invoke(lua_State *L)
     {
+        if (Invoker)
+        {
+            return Invoker(L);
+        }
+
         constexpr int Expected = sizeof...(ArgType);
         const int Actual = lua_gettop(L); 
         if (Actual < Expected)
@@ -528,7 +623,7 @@ namespace UnLua
             return 0;
         }
         TTuple<typename TArgTypeTraits<ArgType>::Type...> Args = GetArgs<typename TArgTypeTraits<ArgType>::Type...>(L, typename TOneBasedIndices<Expected>::Type());
-        return TInvokingHelper<RetType>::Invoke(L, Func, Args, typename TZeroBasedIndices<Expected>::Type());
+        return TInvokingHelper<RetType>::template Invoke<ArgType...>(L, Func, Args, typename TZeroBasedIndices<Expected>::Type());
     }
 
 #if WITH_EDITOR
@@ -550,13 +645,18 @@ namespace UnLua
     template <typename ClassType, typename RetType, typename... ArgType>
     TExportedMemberFunction<ClassType, RetType, ArgType...>::TExportedMemberFunction(const FString &InName, RetType(ClassType::*InFunc)(ArgType...), const FString &InClassName)
         : Name(InName), Func([InFunc](ClassType *Obj, ArgType&&... Args) -> RetType { return (Obj->*InFunc)(Forward<ArgType>(Args)...); })
-        , ClassName(InClassName)
+        , Invoker(nullptr), ClassName(InClassName)
     {}
 
     template <typename ClassType, typename RetType, typename... ArgType>
     TExportedMemberFunction<ClassType, RetType, ArgType...>::TExportedMemberFunction(const FString &InName, RetType(ClassType::*InFunc)(ArgType...) const, const FString &InClassName)
         : Name(InName), Func([InFunc](ClassType *Obj, ArgType&&... Args) -> RetType { return (Obj->*InFunc)(Forward<ArgType>(Args)...); })
-        , ClassName(InClassName)
+        , Invoker(nullptr), ClassName(InClassName)
+    {}
+
+    template <typename ClassType, typename RetType, typename... ArgType>
+    TExportedMemberFunction<ClassType, RetType, ArgType...>::TExportedMemberFunction(const FString &InName, lua_CFunction InInvoker, const FString &InClassName)
+        : Name(InName), Invoker(InInvoker), ClassName(InClassName)
     {}
 
     template <typename ClassType, typename RetType, typename... ArgType>
@@ -564,14 +664,18 @@ namespace UnLua
     {
         // make sure the meta table is on the top of the stack
         lua_pushstring(L, TCHAR_TO_UTF8(*Name));
-        lua_pushlightuserdata(L, this);
-        lua_pushcclosure(L, InvokeFunction, 1);
+        PushExportedFunction(L, this, Invoker, FString::Printf(TEXT("%s::%s"), *ClassName, *Name));
         lua_rawset(L, -3);
     }
 
     template <typename ClassType, typename RetType, typename... ArgType>
     int32 TExportedMemberFunction<ClassType, RetType, ArgType...>::Invoke(lua_State *L)
     {
+        if (Invoker)
+        {
+            return Invoker(L);
+        }
+
         constexpr int Expected = sizeof...(ArgType) + 1;
         const int Actual = lua_gettop(L); 
         if (Actual < Expected)
@@ -585,7 +689,7 @@ namespace UnLua
             UE_LOG(LogUnLua, Error, TEXT("Attempted to call %s::%s with nullptr of 'this'."), *ClassName, *Name);
             return 0;
         }
-        return TInvokingHelper<RetType>::Invoke(L, Func, Args, typename TOneBasedIndices<sizeof...(ArgType)>::Type());
+        return TInvokingHelper<RetType>::template Invoke<ClassType*, ArgType...>(L, Func, Args, typename TOneBasedIndices<sizeof...(ArgType)>::Type());
     }
 
 #if WITH_EDITOR
@@ -610,13 +714,18 @@ namespace UnLua
         , ClassName(InClassName)
     {}
 
+    template <typename RetType, typename... ArgType>
+    TExportedStaticMemberFunction<RetType, ArgType...>::TExportedStaticMemberFunction(const FString &InName, lua_CFunction InInvoker, const FString &InClassName)
+        : Super(InName, InInvoker)
+        , ClassName(InClassName)
+    {}
+
     template <typename RetType, typename... ArgType>
     void TExportedStaticMemberFunction<RetType, ArgType...>::Register(lua_State *L)
     {
         // make sure the meta table is on the top of the stack
         lua_pushstring(L, TCHAR_TO_UTF8(*Super::Name));
-        lua_pushlightuserdata(L, this);
-        lua_pushcclosure(L, InvokeFunction, 1);
+        PushExportedFunction(L, this, Super::Invoker, FString::Printf(TEXT("%s.%s"), *ClassName, *Super::Name));
         lua_rawset(L, -3);
     }
 
@@ -1006,6 +1115,24 @@ namespace UnLua
         FExportedClassBase::Functions.Add(new TExportedStaticMemberFunction<RetType, ArgType...>(InName, InFunc, FExportedClassBase::Name));
     }
 
+    template <bool bIsReflected, typename ClassType, typename... CtorArgType>
+    template <typename CalleeType, typename OwnerType, typename RetType, typename... ArgType> void TExportedClass<bIsReflected, ClassType, CtorArgType...>::AddBoundFunction(const FString &InName, RetType(OwnerType::*)(ArgType...))
+    {
+        FExportedClassBase::Functions.Add(new TExportedMemberFunction<ClassType, RetType, ArgType...>(InName, &TMemberFunctionInvoker<ClassType, CalleeType, RetType, ArgType...>::Invoke, FExportedClassBase::Name));
+    }
+
+    template <bool bIsReflected, typename ClassType, typename... CtorArgType>
+    template <typename CalleeType, typename OwnerType, typename RetType, typename... ArgType> void TExportedClass<bIsReflected, ClassType, CtorArgType...>::AddBoundFunction(const FString &InName, RetType(OwnerType::*)(ArgType...) const)
+    {
+        FExportedClassBase::Functions.Add(new TExportedMemberFunction<ClassType, RetType, ArgType...>(InName, &TMemberFunctionInvoker<ClassType, CalleeType, RetType, ArgType...>::Invoke, FExportedClassBase::Name));
+    }
+
+    template <bool bIsReflected, typename ClassType, typename... CtorArgType>
+    template <typename CalleeType, typename RetType, typename... ArgType> void TExportedClass<bIsReflected, ClassType, CtorArgType...>::AddBoundStaticFunction(const FString &InName, RetType(*)(ArgType...))
+    {
+        FExportedClassBase::Functions.Add(new TExportedStaticMemberFunction<RetType, ArgType...>(InName, &TStaticFunctionInvoker<CalleeType, RetType, ArgType...>::Invoke, FExportedClassBase::Name));
+    }
+
     template <bool bIsReflected, typename ClassType, typename... CtorArgType>
     template <ESPMode Mode, typename... ArgType> void TExportedClass<bIsReflected, ClassType, CtorArgType...>::AddSharedPtrConstructor()
     {
@@ -32,4 +32,11 @@ public:
 
     UFUNCTION(BlueprintCallable)
     static void HotReload();
+
+    UFUNCTION(BlueprintCallable)
+    static void HotReloadModules(const TArray<FString>& ModuleNames);
+
+    /** Convert a lua file path under script root path to module name, returns empty string if not a script file. */
+    UFUNCTION(BlueprintCallable)
+    static FString GetModuleNameFromFilePath(const FString& FilePath);
 };
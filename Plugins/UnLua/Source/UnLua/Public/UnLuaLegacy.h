@@ -187,6 +187,7 @@ namespace UnLua
     {
 #if UNLUA_ENABLE_FTEXT
         const auto Userdata = NewTypedUserdata(L, FText);
+        new(Userdata) FText(V);
 #else
         lua_pushstring(L, TCHAR_TO_UTF8(*V.ToString()));
 #endif
@@ -197,6 +198,7 @@ namespace UnLua
     {
 #if UNLUA_ENABLE_FTEXT
         const auto Userdata = NewTypedUserdata(L, FText);
+        new(Userdata) FText(MoveTemp(V));
 #else
         lua_pushstring(L, TCHAR_TO_UTF8(*V.ToString()));
 #endif
@@ -118,10 +118,5 @@ private:
     TSet<FName> DefaultActionNames;
     TArray<FKey> AllKeys;
 
-    UFunction *InputActionFunc;
-    UFunction *InputAxisFunc;
-    UFunction *InputTouchFunc;
-    UFunction *InputVectorAxisFunc;
-    UFunction *InputGestureFunc;
     UFunction *AnimNotifyFunc;
 };
@@ -30,4 +30,6 @@ public:
     virtual UnLua::FLuaEnv* GetEnv(UObject* Object = nullptr) = 0;
 
     virtual void HotReload() = 0;
+
+    virtual void HotReload(const TArray<FString>& ModuleNames) = 0;
 };
@@ -36,6 +36,10 @@ public:
     UPROPERTY(Config, EditAnywhere, Category="Runtime")
     int32 DeadLoopCheck = 0;
 
+    /** Max number of struct userdata released by UnLua.Release kept for reuse, per struct type and lua env. 0 to disable. */
+    UPROPERTY(Config, EditAnywhere, Category="Runtime")
+    int32 StructPoolCapacity = 64;
+
     /** Prevent dangling pointers in lua. */
     UPROPERTY(Config, EditAnywhere, Category="Runtime")
     bool DanglingCheck = false;
@@ -51,6 +55,10 @@ public:
     UPROPERTY(Config, EditAnywhere, Category=Runtime, Meta=(AllowAbstract="false", DisplayName="LuaModuleLocator"))
     TSubclassOf<ULuaModuleLocator> ModuleLocatorClass = ULuaModuleLocator::StaticClass();
 
+    /** List of metatables built when a lua env is created, named as in the UE table, e.g. AActor, FVector. */
+    UPROPERTY(Config, EditAnywhere, Category="Runtime")
+    TArray<FString> PreloadMetatables;
+
     /** List of classes to bind on startup. */
     UPROPERTY(config, EditAnywhere, Category=Runtime, meta = (MetaClass="Object", AllowAbstract="True", DisplayName = "List of classes to bind on startup"))
     TArray<FSoftClassPath> PreBindClasses;
@@ -71,31 +71,8 @@ public:
 
     virtual void Initialize(const FString& RootLocalPath, const FString& RootBuildPath, const FString& OutputDirectory, const FString& IncludeBase) override
     {
-        GeneratedFileContent.Empty();
-
-        GeneratedFileContent += FString::Printf(TEXT("FFunctionCollection* FC = nullptr;\r\n"));
-        GeneratedFileContent += FString::Printf(TEXT("FParameterCollection* PC = nullptr;\r\n"));
-        GeneratedFileContent += FString::Printf(TEXT("\r\n"));
-        GeneratedFileContent += FString::Printf(TEXT("FBoolParamValue* SharedBool_TRUE = new FBoolParamValue(true);\r\n"));
-        GeneratedFileContent += FString::Printf(TEXT("FBoolParamValue* SharedBool_FALSE = new FBoolParamValue(false);\r\n"));
-        GeneratedFileContent += FString::Printf(TEXT("FFloatParamValue* SharedFloat_Zero = new FFloatParamValue(0.000000f);\r\n"));
-        GeneratedFileContent += FString::Printf(TEXT("FFloatParamValue* SharedFloat_One = new FFloatParamValue(1.000000f);\r\n"));
-        GeneratedFileContent += FString::Printf(TEXT("FEnumParamValue* SharedEnum_Zero = new FEnumParamValue(0);\r\n"));
-        GeneratedFileContent += FString::Printf(TEXT("FIntParamValue* SharedInt_Zero = new FIntParamValue(0);\r\n"));
-        GeneratedFileContent += FString::Printf(TEXT("FByteParamValue* SharedByte_Zero = new FByteParamValue(0);\r\n"));
-        GeneratedFileContent += FString::Printf(TEXT("FNameParamValue* SharedFName_None = new FNameParamValue(FName(\"None\"));\r\n"));
-        GeneratedFileContent += FString::Printf(TEXT("\r\n"));
-        GeneratedFileContent += FString::Printf(TEXT("FVectorParamValue* SharedFVector_Zero = new FVectorParamValue(FVector(EForceInit::ForceInitToZero));\r\n"));
-        GeneratedFileContent += FString::Printf(TEXT("FVector2DParamValue* SharedFVector2D_Zero = new FVector2DParamValue(FVector2D(EForceInit::ForceInitToZero));\r\n"));
-        GeneratedFileContent += FString::Printf(TEXT("FRotatorParamValue* SharedFRotator_Zero = new FRotatorParamValue(FRotator(EForceInit::ForceInitToZero));\r\n"));
-        GeneratedFileContent += FString::Printf(TEXT("FLinearColorParamValue* SharedFLinearColor_Zero = new FLinearColorParamValue(FLinearColor(EForceInit::ForceInitToZero));\r\n"));
-        GeneratedFileContent += FString::Printf(TEXT("FColorParamValue* SharedFColor_Zero = new FColorParamValue(FColor(EForceInit::ForceInitToZero));\r\n"));
-        GeneratedFileContent += FString::Printf(TEXT("\r\n"));
-        GeneratedFileContent += FString::Printf(TEXT("FScriptArrayParamValue* SharedScriptArray = new FScriptArrayParamValue();\r\n"));
-        GeneratedFileContent += FString::Printf(TEXT("FScriptDelegateParamValue* SharedScriptDelegate = new FScriptDelegateParamValue(FScriptDelegate());\r\n"));
-        GeneratedFileContent += FString::Printf(TEXT("FMulticastScriptDelegateParamValue* SharedMulticastScriptDelegate = new FMulticastScriptDelegateParamValue(FMulticastScriptDelegate());\r\n"));
-        GeneratedFileContent += FString::Printf(TEXT("\r\n"));
-
+        ModuleComments.Empty();
+        Entries.Empty();
         OutputDir = OutputDirectory;
     }
 
@@ -109,10 +86,10 @@ public:
             return;
         }
 
+        const FString ClassName = FString::Printf(TEXT("%s%s"), Class->GetPrefixCPP(), *Class->GetName());
         for (TFieldIterator<UFunction> FuncIt(Class, EFieldIteratorFlags::ExcludeSuper, EFieldIteratorFlags::ExcludeDeprecated); FuncIt; ++FuncIt)
         {
             UFunction* Function = *FuncIt;
-            CurrentFunctionName.Empty();
 
             // filter out functions without meta data
             TMap<FName, FString>* MetaMap = UMetaData::GetMapForObject(Function);
@@ -128,7 +105,6 @@ public:
                 AutoCreateRefTerm.ParseIntoArray(AutoEmitParameterNames, TEXT(","), true);
                 for (FString& ParamName : AutoEmitParameterNames)
                     ParamName.TrimStartAndEndInline();
-                // GeneratedFileContent += FString::Printf(TEXT("// DEBUG %s AutoCreateRefTerm=%s \r\n"), *Function->GetName(), *AutoCreateRefTerm);
             }
 
             // parameters
@@ -142,270 +118,28 @@ public:
                 {
                     if (AutoEmitParameterNames.Find(Property->GetName()) == INDEX_NONE)
                     {
-                        // GeneratedFileContent += FString::Printf(TEXT("// DEBUG %s has no default value\r\n"),  *Property->GetName());
                         continue;
                     }
-                    // GeneratedFileContent += FString::Printf(TEXT("// DEBUG %s AutoEmitParameterNames(%d) %s\r\n"),
-                    //                                         *Property->GetName(), AutoEmitParameterNames.Find(Property->GetName()), *AutoCreateRefTerm);
                 }
 
-                if (Property->IsA(FStructProperty::StaticClass()))
-                {
-                    // get all possible script structs
-                    UPackage* CoreUObjectPackage = UObject::StaticClass()->GetOutermost();
-                    static const UScriptStruct* VectorStruct = FindObjectChecked<UScriptStruct>(CoreUObjectPackage, TEXT("Vector"));
-                    static const UScriptStruct* Vector2DStruct = FindObjectChecked<UScriptStruct>(CoreUObjectPackage, TEXT("Vector2D"));
-                    static const UScriptStruct* RotatorStruct = FindObjectChecked<UScriptStruct>(CoreUObjectPackage, TEXT("Rotator"));
-                    static const UScriptStruct* LinearColorStruct = FindObjectChecked<UScriptStruct>(CoreUObjectPackage, TEXT("LinearColor"));
-                    static const UScriptStruct* ColorStruct = FindObjectChecked<UScriptStruct>(CoreUObjectPackage, TEXT("Color"));
-
-                    const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
-                    if (StructProperty->Struct == VectorStruct) // FVector
-                    {
-                        if(ValueStr.IsEmpty())
-                        {
-                            PreAddProperty(Class, Function);
-                            GeneratedFileContent += FString::Printf(TEXT("PC->Parameters.Add(TEXT(\"%s\"), SharedFVector_Zero);\r\n"), *Property->GetName());
-                        }
-                        else
-                        {
-                            TArray<FString> Values;
-                            ValueStr.ParseIntoArray(Values, TEXT(","));
-                            if (Values.Num() == 3)
-                            {
-                                float X = TCString<TCHAR>::Atof(*Values[0]);
-                                float Y = TCString<TCHAR>::Atof(*Values[1]);
-                                float Z = TCString<TCHAR>::Atof(*Values[2]);
-                                PreAddProperty(Class, Function);
-                                GeneratedFileContent += FString::Printf(TEXT("PC->Parameters.Add(TEXT(\"%s\"), new FVectorParamValue(FVector(%ff,%ff,%ff)));\r\n"), *Property->GetName(), X, Y, Z);
-                            }
-                        }
-                    }
-                    else if (StructProperty->Struct == RotatorStruct) // FRotator
-                    {
-                        if(ValueStr.IsEmpty())
-                        {
-                            PreAddProperty(Class, Function);
-                            GeneratedFileContent += FString::Printf(TEXT("PC->Parameters.Add(TEXT(\"%s\"), SharedFRotator_Zero);\r\n"), *Property->GetName());
-                        }
-                        else
-                        {
-                            TArray<FString> Values;
-                            ValueStr.ParseIntoArray(Values, TEXT(","));
-                            if (Values.Num() == 3)
-                            {
-                                float Pitch = TCString<TCHAR>::Atof(*Values[0]);
-                                float Yaw = TCString<TCHAR>::Atof(*Values[1]);
-                                float Roll = TCString<TCHAR>::Atof(*Values[2]);
-                                PreAddProperty(Class, Function);
-                                GeneratedFileContent += FString::Printf(TEXT("PC->Parameters.Add(TEXT(\"%s\"), new FRotatorParamValue(FRotator(%ff,%ff,%ff)));\r\n"),
-                                                                        *Property->GetName(), Pitch, Yaw, Roll);
-                            }
-                        }
-                    }
-                    else if (StructProperty->Struct == Vector2DStruct) // FVector2D
-                    {
-                        if(ValueStr.IsEmpty())
-                        {
-                            PreAddProperty(Class, Function);
-                            GeneratedFileContent += FString::Printf(TEXT("PC->Parameters.Add(TEXT(\"%s\"), SharedFVector2D_Zero);\r\n"), *Property->GetName());
-                        }
-                        else
-                        {
-                            FVector2D Value;
-                            Value.InitFromString(ValueStr);
-                            PreAddProperty(Class, Function);
-                            GeneratedFileContent += FString::Printf(TEXT("PC->Parameters.Add(TEXT(\"%s\"), new FVector2DParamValue(FVector2D(%ff,%ff)));\r\n"), *Property->GetName(), Value.X, Value.Y);
-                        }
-                    }
-                    else if (StructProperty->Struct == LinearColorStruct) // FLinearColor
-                    {
-                        if(ValueStr.IsEmpty())
-                        {
-                            PreAddProperty(Class, Function);
-                            GeneratedFileContent += FString::Printf(TEXT("PC->Parameters.Add(TEXT(\"%s\"), SharedFLinearColor_Zero);\r\n"), *Property->GetName());
-                        }
-                        else
-                        {
-                            FLinearColor Value;
-                            Value.InitFromString(ValueStr);
-                            PreAddProperty(Class, Function);
-                            GeneratedFileContent += FString::Printf(TEXT("PC->Parameters.Add(TEXT(\"%s\"), new FLinearColorParamValue(FLinearColor(%ff,%ff,%ff,%ff)));\r\n"),
-                                                                    *Property->GetName(), Value.R, Value.G, Value.B, Value.A);    
-                        }
-                    }
-                    else if (StructProperty->Struct == ColorStruct) // FColor
-                    {
-                        if(ValueStr.IsEmpty())
-                        {
-                            PreAddProperty(Class, Function);
-                            GeneratedFileContent += FString::Printf(TEXT("PC->Parameters.Add(TEXT(\"%s\"), SharedFColor_Zero);\r\n"), *Property->GetName());
-                        }
-                        else
-                        {
-                            FColor Value;
-                            Value.InitFromString(ValueStr);
-                            PreAddProperty(Class, Function);
-                            GeneratedFileContent += FString::Printf(TEXT("PC->Parameters.Add(TEXT(\"%s\"), new FColorParamValue(FColor(%d,%d,%d,%d)));\r\n"),
-                                                                    *Property->GetName(), Value.R, Value.G, Value.B, Value.A);   
-                        }
-                    }
-                }
-                else
-                {
-                    if (Property->IsA(FIntProperty::StaticClass())) // int
-                    {
-                        int32 Value = TCString<TCHAR>::Atoi(*ValueStr);
-                        PreAddProperty(Class, Function);
-                        if (Value == 0)
-                            GeneratedFileContent += FString::Printf(TEXT("PC->Parameters.Add(TEXT(\"%s\"), SharedInt_Zero);\r\n"), *Property->GetName(), Value);
-                        else
-                            GeneratedFileContent += FString::Printf(TEXT("PC->Parameters.Add(TEXT(\"%s\"), new FIntParamValue(%d));\r\n"), *Property->GetName(), Value);
-                    }
-                    else if (Property->IsA(FByteProperty::StaticClass())) // byte
-                    {
-                        const UEnum* Enum = CastField<FByteProperty>(Property)->Enum;
-                        if(Enum)
-                        {
-                            int64 Value = Enum->GetValueByNameString(ValueStr);
-                            PreAddProperty(Class, Function);
-                            if (Value == 0)
-                            {
-                                GeneratedFileContent += FString::Printf(TEXT("PC->Parameters.Add(TEXT(\"%s\"), SharedByte_Zero);\r\n"), *Property->GetName(), Value);
-                            }
-                            else if (Value > 0 && Value <= 255)
-                            {
-                                GeneratedFileContent += FString::Printf(TEXT("PC->Parameters.Add(TEXT(\"%s\"), new FByteParamValue(%d));\r\n"), *Property->GetName(), Value);
-                            }
-                            else
-                            {
-                                GeneratedFileContent += FString::Printf(TEXT("PC->Parameters.Add(TEXT(\"%s\"), new FRuntimeEnumParamValue(\"%s\",%d));\r\n"), *Property->GetName(), *Enum->CppType, Enum->GetIndexByNameString(ValueStr));
-                            }
-                        }
-                        else
-                        {
-                            int32 Value = TCString<TCHAR>::Atoi(*ValueStr);
-                            check(Value >= 0 && Value <= 255)
-                            PreAddProperty(Class, Function);
-                            if (Value == 0)
-                                GeneratedFileContent += FString::Printf(TEXT("PC->Parameters.Add(TEXT(\"%s\"), SharedByte_Zero);\r\n"), *Property->GetName(), Value);
-                            else
-                                GeneratedFileContent += FString::Printf(TEXT("PC->Parameters.Add(TEXT(\"%s\"), new FByteParamValue(%d));\r\n"), *Property->GetName(), Value);
-                        }
-                    }
-                    else if (Property->IsA(FEnumProperty::StaticClass())) // enum
-                    {
-                        const UEnum* Enum = CastField<FEnumProperty>(Property)->GetEnum();
-                        if(Enum)
-                        {
-                            int64 Value = Enum->GetValueByNameString(ValueStr);
-                            PreAddProperty(Class, Function);
-                            if (Value == 0)
-                            {
-                                GeneratedFileContent += FString::Printf(TEXT("PC->Parameters.Add(TEXT(\"%s\"), SharedEnum_Zero);\r\n"), *Property->GetName(), Value);
-                            }
-                            else if (Value > 0 && Value <= 255)
-                            {
-                                GeneratedFileContent += FString::Printf(TEXT("PC->Parameters.Add(TEXT(\"%s\"), new FEnumParamValue(%ld));\r\n"), *Property->GetName(), Value);
-                            }
-                            else
-                            {
-                                GeneratedFileContent += FString::Printf(TEXT("PC->Parameters.Add(TEXT(\"%s\"), new FRuntimeEnumParamValue(\"%s\",%d));\r\n"), *Property->GetName(), *Enum->CppType, Enum->GetIndexByNameString(ValueStr));
-                            }
-                        }
-                        else
-                        {
-                            int64 Value = TCString<TCHAR>::Atoi64(*ValueStr);
-                            PreAddProperty(Class, Function);
-                            if (Value == 0)
-                                GeneratedFileContent += FString::Printf(TEXT("PC->Parameters.Add(TEXT(\"%s\"), SharedEnum_Zero);\r\n"), *Property->GetName(), Value);
-                            else
-                                GeneratedFileContent += FString::Printf(TEXT("PC->Parameters.Add(TEXT(\"%s\"), new FEnumParamValue(%ld));\r\n"), *Property->GetName(), Value);
-                        }
-                    }
-                    else if (Property->IsA(FFloatProperty::StaticClass())) // float
-                    {
-                        float Value = TCString<TCHAR>::Atof(*ValueStr);
-                        PreAddProperty(Class, Function);
-                        if (FMath::IsNearlyZero(Value))
-                            GeneratedFileContent += FString::Printf(TEXT("PC->Parameters.Add(TEXT(\"%s\"), SharedFloat_Zero);\r\n"), *Property->GetName(), Value);
-                        else if (FMath::IsNearlyEqual(Value, 1))
-                            GeneratedFileContent += FString::Printf(TEXT("PC->Parameters.Add(TEXT(\"%s\"), SharedFloat_One);\r\n"), *Property->GetName(), Value);
-                        else
-                            GeneratedFileContent += FString::Printf(TEXT("PC->Parameters.Add(TEXT(\"%s\"), new FFloatParamValue(%ff));\r\n"), *Property->GetName(), Value);
-                    }
-                    else if (Property->IsA(FDoubleProperty::StaticClass())) // double
-                    {
-                        double Value = TCString<TCHAR>::Atod(*ValueStr);
-                        PreAddProperty(Class, Function);
-                        GeneratedFileContent += FString::Printf(TEXT("PC->Parameters.Add(TEXT(\"%s\"), new FDoubleParamValue(%lf));\r\n"), *Property->GetName(), Value);
-                    }
-                    else if (Property->IsA(FBoolProperty::StaticClass())) // boolean
-                    {
-                        PreAddProperty(Class, Function);
-                        if (ValueStr.IsEmpty())
-                            GeneratedFileContent += FString::Printf(TEXT("PC->Parameters.Add(TEXT(\"%s\"), SharedBool_FALSE);\r\n"), *Property->GetName());
-                        else
-                            GeneratedFileContent += FString::Printf(TEXT("PC->Parameters.Add(TEXT(\"%s\"), SharedBool_%s);\r\n"), *Property->GetName(), *ValueStr.ToUpper());
-                    }
-                    else if (Property->IsA(FNameProperty::StaticClass())) // FName
-                    {
-                        PreAddProperty(Class, Function);
-                        if (ValueStr == "None")
-                            GeneratedFileContent += FString::Printf(TEXT("PC->Parameters.Add(TEXT(\"%s\"), SharedFName_None);\r\n"), *Property->GetName(), *ValueStr);
-                        else
-                            GeneratedFileContent += FString::Printf(TEXT("PC->Parameters.Add(TEXT(\"%s\"), new FNameParamValue(FName(\"%s\")));\r\n"), *Property->GetName(), *ValueStr);
-                    }
-                    else if (Property->IsA(FTextProperty::StaticClass())) // FText
-                    {
-                        PreAddProperty(Class, Function);
-#if ENGINE_MAJOR_VERSION > 4 || (ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION > 20)
-                        if (ValueStr.StartsWith(TEXT("INVTEXT(\"")))
-                        {
-                            GeneratedFileContent += FString::Printf(TEXT("PC->Parameters.Add(TEXT(\"%s\"), new FTextParamValue(%s));\r\n"), *Property->GetName(), *ValueStr);
-                        }
-                        else
-#endif
-                        {
-                            GeneratedFileContent += FString::Printf(
-                                TEXT("PC->Parameters.Add(TEXT(\"%s\"), new FTextParamValue(FText::FromString(TEXT(\"%s\"))));\r\n"), *Property->GetName(), *ValueStr);
-                        }
-                    }
-                    else if (Property->IsA(FStrProperty::StaticClass())) // FString
-                    {
-                        PreAddProperty(Class, Function);
-                        GeneratedFileContent += FString::Printf(TEXT("PC->Parameters.Add(TEXT(\"%s\"), new FStringParamValue(TEXT(\"%s\")));\r\n"), *Property->GetName(), *ValueStr);
-                    }
-                    else if (Property->IsA(FArrayProperty::StaticClass()))
-                    {
-                        PreAddProperty(Class, Function);
-                        GeneratedFileContent += FString::Printf(TEXT("PC->Parameters.Add(TEXT(\"%s\"), SharedScriptArray);\r\n"), *Property->GetName());
-                    }
-                    else if (Property->IsA(FDelegateProperty::StaticClass()))
-                    {
-                        PreAddProperty(Class, Function);
-                        GeneratedFileContent += FString::Printf(TEXT("PC->Parameters.Add(TEXT(\"%s\"), SharedScriptDelegate);\r\n"), *Property->GetName());
-                    }
-                    else if (Property->IsA(FMulticastDelegateProperty::StaticClass()))
-                    {
-                        PreAddProperty(Class, Function);
-                        GeneratedFileContent += FString::Printf(TEXT("PC->Parameters.Add(TEXT(\"%s\"), SharedMulticastDelegate);\r\n"), *Property->GetName());
-                    }
-                }
+                CurrentClassName = ClassName;
+                CurrentFunctionName = Function->GetName();
+                ExportParamProperty(Property, ValueStr);
             }
         }
-
-        if (CurrentClassName.Len() > 0)
-        {
-            CurrentClassName.Empty();
-            CurrentFunctionName.Empty();
-
-            GeneratedFileContent += TEXT("\r\n");
-        }
     }
 
     virtual void FinishExport() override
     {
+        // 按函数哈希排序，运行时二分查找
+        Entries.StableSort([](const FEntry& A, const FEntry& B) { return A.Hash < B.Hash; });
+
+        FString GeneratedFileContent = ModuleComments;
+        for (const FEntry& Entry : Entries)
+        {
+            GeneratedFileContent += Entry.Line;
+        }
+
         const FString FilePath = FString::Printf(TEXT("%s%s"), *OutputDir, TEXT("DefaultParamCollection.inl"));
         FString FileContent;
         FFileHelper::LoadFileToString(FileContent, *FilePath);
@@ -423,7 +157,9 @@ public:
         {
             // If Current build Engine Project, try create new file if has no DefaultParamCollection.inl to fix compile error
             // or do not update DefaultParamCollection.inl file if exists
-            if (!FPaths::FileExists(FilePath) || FileContent.Len() == 0)
+            // 旧格式的文件是逐条执行的语句，不能再包含进常量数组，也需要重新生成
+            const bool bLegacyFormat = FileContent.Contains(TEXT("FFunctionCollection* FC"));
+            if (!FPaths::FileExists(FilePath) || FileContent.Len() == 0 || bLegacyFormat)
             {
                 bool bResult = FFileHelper::SaveStringToFile(GeneratedFileContent, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
                 check(bResult);
@@ -437,23 +173,166 @@ public:
     }
 
 private:
-    void PreAddProperty(UClass* Class, UFunction* Function)
+    struct FEntry
+    {
+        uint32 Hash;
+        FString Line;
+    };
+
+    void ExportParamProperty(FProperty* Property, const FString& ValueStr)
     {
-        if (CurrentClassName.Len() < 1)
+        if (Property->IsA(FStructProperty::StaticClass()))
         {
-            CurrentClassName = FString::Printf(TEXT("%s%s"), Class->GetPrefixCPP(), *Class->GetName());
-            GeneratedFileContent += FString::Printf(TEXT("FC = &GDefaultParamCollection.Add(TEXT(\"%s\"));\r\n"), *CurrentClassName);
+            // get all possible script structs
+            UPackage* CoreUObjectPackage = UObject::StaticClass()->GetOutermost();
+            static const UScriptStruct* VectorStruct = FindObjectChecked<UScriptStruct>(CoreUObjectPackage, TEXT("Vector"));
+            static const UScriptStruct* Vector2DStruct = FindObjectChecked<UScriptStruct>(CoreUObjectPackage, TEXT("Vector2D"));
+            static const UScriptStruct* RotatorStruct = FindObjectChecked<UScriptStruct>(CoreUObjectPackage, TEXT("Rotator"));
+            static const UScriptStruct* LinearColorStruct = FindObjectChecked<UScriptStruct>(CoreUObjectPackage, TEXT("LinearColor"));
+            static const UScriptStruct* ColorStruct = FindObjectChecked<UScriptStruct>(CoreUObjectPackage, TEXT("Color"));
+
+            const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+            if (StructProperty->Struct == VectorStruct || StructProperty->Struct == RotatorStruct) // FVector, FRotator
+            {
+                const TCHAR* Type = StructProperty->Struct == VectorStruct ? TEXT("Vector") : TEXT("Rotator");
+                if (ValueStr.IsEmpty())
+                {
+                    AddEntry(Property, Type, {});
+                }
+                else
+                {
+                    TArray<FString> Values;
+                    ValueStr.ParseIntoArray(Values, TEXT(","));
+                    if (Values.Num() == 3)
+                        AddEntry(Property, Type, {TCString<TCHAR>::Atod(*Values[0]), TCString<TCHAR>::Atod(*Values[1]), TCString<TCHAR>::Atod(*Values[2])});
+                }
+            }
+            else if (StructProperty->Struct == Vector2DStruct) // FVector2D
+            {
+                FVector2D Value(EForceInit::ForceInitToZero);
+                if (!ValueStr.IsEmpty())
+                    Value.InitFromString(ValueStr);
+                AddEntry(Property, TEXT("Vector2D"), {Value.X, Value.Y});
+            }
+            else if (StructProperty->Struct == LinearColorStruct) // FLinearColor
+            {
+                FLinearColor Value(EForceInit::ForceInitToZero);
+                if (!ValueStr.IsEmpty())
+                    Value.InitFromString(ValueStr);
+                AddEntry(Property, TEXT("LinearColor"), {Value.R, Value.G, Value.B, Value.A});
+            }
+            else if (StructProperty->Struct == ColorStruct) // FColor
+            {
+                FColor Value(EForceInit::ForceInitToZero);
+                if (!ValueStr.IsEmpty())
+                    Value.InitFromString(ValueStr);
+                AddEntry(Property, TEXT("Color"), {(double)Value.R, (double)Value.G, (double)Value.B, (double)Value.A});
+            }
         }
-        if (CurrentFunctionName.Len() < 1)
+        else if (Property->IsA(FIntProperty::StaticClass())) // int
+        {
+            AddEntry(Property, TEXT("Int"), {(double)TCString<TCHAR>::Atoi(*ValueStr)});
+        }
+        else if (Property->IsA(FByteProperty::StaticClass()) || Property->IsA(FEnumProperty::StaticClass())) // byte, enum
+        {
+            const bool bIsByte = Property->IsA(FByteProperty::StaticClass());
+            const TCHAR* Type = bIsByte ? TEXT("Byte") : TEXT("Enum");
+            const UEnum* Enum = bIsByte ? CastField<FByteProperty>(Property)->Enum : CastField<FEnumProperty>(Property)->GetEnum();
+            if (Enum)
+            {
+                const int64 Value = Enum->GetValueByNameString(ValueStr);
+                if (Value >= 0 && Value <= 255)
+                    AddEntry(Property, Type, {(double)Value});
+                else
+                    AddEntry(Property, TEXT("RuntimeEnum"), {(double)Enum->GetIndexByNameString(ValueStr)}, &Enum->CppType);
+            }
+            else
+            {
+                const int64 Value = TCString<TCHAR>::Atoi64(*ValueStr);
+                check(!bIsByte || (Value >= 0 && Value <= 255));
+                AddEntry(Property, Type, {(double)Value});
+            }
+        }
+        else if (Property->IsA(FFloatProperty::StaticClass())) // float
+        {
+            AddEntry(Property, TEXT("Float"), {TCString<TCHAR>::Atof(*ValueStr)});
+        }
+        else if (Property->IsA(FDoubleProperty::StaticClass())) // double
+        {
+            AddEntry(Property, TEXT("Double"), {TCString<TCHAR>::Atod(*ValueStr)});
+        }
+        else if (Property->IsA(FBoolProperty::StaticClass())) // boolean
+        {
+            AddEntry(Property, TEXT("Bool"), {ValueStr.ToBool() ? 1.0 : 0.0});
+        }
+        else if (Property->IsA(FNameProperty::StaticClass())) // FName
+        {
+            AddEntry(Property, TEXT("Name"), {}, &ValueStr);
+        }
+        else if (Property->IsA(FTextProperty::StaticClass())) // FText
+        {
+#if ENGINE_MAJOR_VERSION > 4 || (ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION > 20)
+            if (ValueStr.StartsWith(TEXT("INVTEXT(\"")) && ValueStr.EndsWith(TEXT("\")")))
+            {
+                const FString InnerStr = ValueStr.Mid(9, ValueStr.Len() - 11);
+                AddEntry(Property, TEXT("InvariantText"), {}, &InnerStr);
+            }
+            else
+#endif
+            {
+                AddEntry(Property, TEXT("Text"), {}, &ValueStr);
+            }
+        }
+        else if (Property->IsA(FStrProperty::StaticClass())) // FString
+        {
+            AddEntry(Property, TEXT("String"), {}, &ValueStr);
+        }
+        else if (Property->IsA(FArrayProperty::StaticClass()))
+        {
+            AddEntry(Property, TEXT("ScriptArray"), {});
+        }
+        else if (Property->IsA(FDelegateProperty::StaticClass()))
+        {
+            AddEntry(Property, TEXT("ScriptDelegate"), {});
+        }
+        else if (Property->IsA(FMulticastDelegateProperty::StaticClass()))
+        {
+            AddEntry(Property, TEXT("MulticastScriptDelegate"), {});
+        }
+    }
+
+    void AddEntry(FProperty* Property, const TCHAR* Type, std::initializer_list<double> Values, const FString* String = nullptr)
+    {
+        FString ValuesStr;
+        for (const double Value : Values)
+        {
+            ValuesStr += FString::Printf(TEXT("%s%.17g"), ValuesStr.IsEmpty() ? TEXT("") : TEXT(","), Value);
+        }
+
+        const FString StringStr = String ? FString::Printf(TEXT("TEXT(\"%s\")"), **String) : FString(TEXT("nullptr"));
+        const uint32 Hash = HashFunction(CurrentClassName, CurrentFunctionName);
+        FEntry& Entry = Entries.AddDefaulted_GetRef();
+        Entry.Hash = Hash;
+        Entry.Line = FString::Printf(TEXT("{0x%08xu, TEXT(\"%s\"), TEXT(\"%s\"), TEXT(\"%s\"), EDefaultParamType::%s, {%s}, %s},\r\n"),
+                                     Hash, *CurrentClassName, *CurrentFunctionName, *Property->GetName(), Type, *ValuesStr, *StringStr);
+    }
+
+    // 与运行时的HashDefaultParamFunction保持一致
+    static uint32 HashFunction(const FString& ClassName, const FString& FunctionName)
+    {
+        const FString FullName = ClassName + TEXT(".") + FunctionName;
+        uint32 Hash = 2166136261u;
+        for (const TCHAR* Str = *FullName; *Str; ++Str)
         {
-            CurrentFunctionName = Function->GetName();
-            GeneratedFileContent += FString::Printf(TEXT("PC = &FC->Functions.Add(TEXT(\"%s\"));\r\n"), *CurrentFunctionName);
+            Hash ^= (uint32)*Str;
+            Hash *= 16777619u;
         }
+        return Hash;
     }
 
     void ParseModule(const FString& ModuleName, EBuildModuleType::Type ModuleType, const FString& ModuleGeneratedIncludeDirectory)
     {
-        GeneratedFileContent += FString::Printf(TEXT("// ModuleName %s Type %d  ModuleGeneratedIncludeDirectory %s \r\n"), *ModuleName, ModuleType, *ModuleGeneratedIncludeDirectory);
+        ModuleComments += FString::Printf(TEXT("// ModuleName %s Type %d  ModuleGeneratedIncludeDirectory %s \r\n"), *ModuleName, ModuleType, *ModuleGeneratedIncludeDirectory);
         if (ModuleType == EBuildModuleType::GameRuntime)
         {
             // For Only Game Project has GameRuntime Module, this should be Game Project
@@ -465,7 +344,8 @@ private:
     FString OutputDir;
     FString CurrentClassName;
     FString CurrentFunctionName;
-    FString GeneratedFileContent;
+    FString ModuleComments;
+    TArray<FEntry> Entries;
 };
 
 #undef LOCTEXT_NAMESPACE
@@ -27,32 +27,8 @@ namespace UnLuaDefaultParamCollectorUbtPlugin
             Factory = factory;
             Borrower = new BorrowStringBuilder(StringBuilderCache.Big);
             bHasGameRuntime = false;
-            bCurrentClassWritten = false;
-            bCurrentFunctionWritten = false;
 
             GeneratedContentBuilder.Append("// Generated By C# UbtPlugin\r\n");
-            GeneratedContentBuilder.Append("FFunctionCollection* FC = nullptr;\r\n");
-            GeneratedContentBuilder.Append("FParameterCollection* PC = nullptr;\r\n");
-            GeneratedContentBuilder.Append("\r\n");
-            GeneratedContentBuilder.Append("FBoolParamValue* SharedBool_TRUE = new FBoolParamValue(true);\r\n");
-            GeneratedContentBuilder.Append("FBoolParamValue* SharedBool_FALSE = new FBoolParamValue(false);\r\n");
-            GeneratedContentBuilder.Append("FFloatParamValue* SharedFloat_Zero = new FFloatParamValue(0.000000f);\r\n");
-            GeneratedContentBuilder.Append("FFloatParamValue* SharedFloat_One = new FFloatParamValue(1.000000f);\r\n");
-            GeneratedContentBuilder.Append("FEnumParamValue* SharedEnum_Zero = new FEnumParamValue(0);\r\n");
-            GeneratedContentBuilder.Append("FIntParamValue* SharedInt_Zero = new FIntParamValue(0);\r\n");
-            GeneratedContentBuilder.Append("FByteParamValue* SharedByte_Zero = new FByteParamValue(0);\r\n");
-            GeneratedContentBuilder.Append("FNameParamValue* SharedFName_None = new FNameParamValue(FName(\"None\"));\r\n");
-            GeneratedContentBuilder.Append("\r\n");
-            GeneratedContentBuilder.Append("FVectorParamValue* SharedFVector_Zero = new FVectorParamValue(FVector(EForceInit::ForceInitToZero));\r\n");
-            GeneratedContentBuilder.Append("FVector2DParamValue* SharedFVector2D_Zero = new FVector2DParamValue(FVector2D(EForceInit::ForceInitToZero));\r\n");
-            GeneratedContentBuilder.Append("FRotatorParamValue* SharedFRotator_Zero = new FRotatorParamValue(FRotator(EForceInit::ForceInitToZero));\r\n");
-            GeneratedContentBuilder.Append("FLinearColorParamValue* SharedFLinearColor_Zero = new FLinearColorParamValue(FLinearColor(EForceInit::ForceInitToZero));\r\n");
-            GeneratedContentBuilder.Append("FColorParamValue* SharedFColor_Zero = new FColorParamValue(FColor(EForceInit::ForceInitToZero));\r\n");
-            GeneratedContentBuilder.Append("\r\n");
-            GeneratedContentBuilder.Append("FScriptArrayParamValue* SharedScriptArray = new FScriptArrayParamValue();\r\n");
-            GeneratedContentBuilder.Append("FScriptDelegateParamValue* SharedScriptDelegate = new FScriptDelegateParamValue(FScriptDelegate());\r\n");
-            GeneratedContentBuilder.Append("FMulticastScriptDelegateParamValue* SharedMulticastScriptDelegate = new FMulticastScriptDelegateParamValue(FMulticastScriptDelegate());\r\n");
-            GeneratedContentBuilder.Append("\r\n");
         }
 
         private void Generate()
@@ -103,11 +79,6 @@ namespace UnLuaDefaultParamCollectorUbtPlugin
                     ExportFunction(classObj, function);
                 }
             }
-            if (bCurrentClassWritten)
-            {
-                bCurrentClassWritten = false;
-                GeneratedContentBuilder.Append("\r\n");
-            }
         }
 
         private bool CanExportFunction(UhtFunction function)
@@ -118,7 +89,6 @@ namespace UnLuaDefaultParamCollectorUbtPlugin
 
         private void ExportFunction(UhtClass classObj, UhtFunction function)
         {
-            bCurrentFunctionWritten = false;
             var metaData = function.MetaData;
             var autoCreateRefTerm = metaData.GetValueOrDefault("AutoCreateRefTerm");
             var autoEmitParameterNames = new string[] {};
@@ -155,100 +125,29 @@ namespace UnLuaDefaultParamCollectorUbtPlugin
                 }
             }
 
+            var entry = new DefaultParamEntry(classObj.EngineNamePrefix + classObj.EngineName, function.StrippedFunctionName, property.SourceName);
             if (property is UhtStructProperty structProperty)
             {
                 var structTypeName = structProperty.ScriptStruct.EngineName;
-                if (structTypeName.Equals("Vector"))
-                {
-                    if (string.IsNullOrEmpty(valueStr))
-                    {
-                        PreAddProperty(classObj, function);
-                        GeneratedContentBuilder.AppendFormat("PC->Parameters.Add(TEXT(\"{0}\"), SharedFVector_Zero);\r\n", property.SourceName);
-                    }
-                    else
-                    {
-                        var values = valueStr.Split(",").Select(float.Parse).ToArray();
-                        if (values.Length == 3)
-                        {
-                            PreAddProperty(classObj, function);
-                            GeneratedContentBuilder.AppendFormat("PC->Parameters.Add(TEXT(\"{0}\"), new FVectorParamValue(FVector({1:F6}f,{2:F6}f,{3:F6}f)));\r\n", property.SourceName, values[0], values[1], values[2]);
-                        }
-                    }
-                }
-                else if (structTypeName.Equals("Rotator"))
-                {
-                    if (string.IsNullOrEmpty(valueStr))
-                    {
-                        PreAddProperty(classObj, function);
-                        GeneratedContentBuilder.AppendFormat("PC->Parameters.Add(TEXT(\"{0}\"), SharedFRotator_Zero);\r\n", property.SourceName);
-                    }
-                    else
-                    {
-                        var values = valueStr.Split(",").Select(float.Parse).ToArray();
-                        if (values.Length == 3)
-                        {
-                            PreAddProperty(classObj, function);
-                            GeneratedContentBuilder.AppendFormat("PC->Parameters.Add(TEXT(\"{0}\"), new FRotatorParamValue(FRotator({1:F6}f,{2:F6}f,{3:F6}f)));\r\n", property.SourceName, values[0], values[1], values[2]);
-                        }
-                    }
-                }
-                else if (structTypeName.Equals("Vector2D"))
-                {
-                    if (string.IsNullOrEmpty(valueStr))
-                    {
-                        PreAddProperty(classObj, function);
-                        GeneratedContentBuilder.AppendFormat("PC->Parameters.Add(TEXT(\"{0}\"), SharedFVector2D_Zero);\r\n", property.SourceName);
-                    }
-                    else
-                    {
-                        var values = Regex.Split(valueStr, @"[^\d.]+").Where(x => !string.IsNullOrEmpty(x)).Select(float.Parse).ToArray();
-                        PreAddProperty(classObj, function);
-                        GeneratedContentBuilder.AppendFormat("PC->Parameters.Add(TEXT(\"{0}\"), new FVector2DParamValue(FVector2D({1:F6}f,{2:F6}f)));\r\n", property.SourceName, values[0], values[1]);
-                    }
-                }
-                else if (structTypeName.Equals("LinearColor"))
+                if (structTypeName.Equals("Vector") || structTypeName.Equals("Rotator"))
                 {
-                    if (string.IsNullOrEmpty(valueStr))
-                    {
-                        PreAddProperty(classObj, function);
-                        GeneratedContentBuilder.AppendFormat("PC->Parameters.Add(TEXT(\"{0}\"), SharedFLinearColor_Zero);\r\n", property.SourceName);
-                    }
-                    else
+                    var values = string.IsNullOrEmpty(valueStr) ? new double[] { 0, 0, 0 } : valueStr.Split(",").Select(x => (double)float.Parse(x)).ToArray();
+                    if (values.Length == 3)
                     {
-                        var values = Regex.Split(valueStr, @"[^\d.]+").Where(x => !string.IsNullOrEmpty(x)).Select(float.Parse).ToArray();
-
-                        PreAddProperty(classObj, function);
-                        GeneratedContentBuilder.AppendFormat("PC->Parameters.Add(TEXT(\"{0}\"), new FLinearColorParamValue(FLinearColor({1:F6}f,{2:F6}f,{3:F6}f,{4:F6}f)));\r\n", property.SourceName, values[0], values[1], values[2], values[3]);
+                        AddEntry(entry, structTypeName, values);
                     }
                 }
-                else if (structTypeName.Equals("Color"))
+                else if (structTypeName.Equals("Vector2D") || structTypeName.Equals("LinearColor") || structTypeName.Equals("Color"))
                 {
-                    if (string.IsNullOrEmpty(valueStr))
-                    {
-                        PreAddProperty(classObj, function);
-                        GeneratedContentBuilder.AppendFormat("PC->Parameters.Add(TEXT(\"{0}\"), SharedFColor_Zero);\r\n", property.SourceName);
-                    }
-                    else
-                    {
-                        var values = Regex.Split(valueStr, @"[^\d.]+").Where(x => !string.IsNullOrEmpty(x)).ToArray();
-
-                        PreAddProperty(classObj, function);
-                        GeneratedContentBuilder.AppendFormat("PC->Parameters.Add(TEXT(\"{0}\"), new FColorParamValue(FColor({1},{2},{3},{4})));\r\n", property.SourceName, values[0], values[1], values[2], values[3]);
-                    }
+                    var count = structTypeName.Equals("Vector2D") ? 2 : 4;
+                    var values = string.IsNullOrEmpty(valueStr) ? new double[count] : Regex.Split(valueStr, @"[^\d.]+").Where(x => !string.IsNullOrEmpty(x)).Select(double.Parse).ToArray();
+                    AddEntry(entry, structTypeName, values.Take(count).ToArray());
                 }
             }
             else if (property is UhtIntProperty)
             {
                 int.TryParse(valueStr, out var value);
-                PreAddProperty(classObj, function);
-                if (value == 0)
-                {
-                    GeneratedContentBuilder.AppendFormat("PC->Parameters.Add(TEXT(\"{0}\"), SharedInt_Zero);\r\n", property.SourceName);
-                }
-                else
-                {
-                    GeneratedContentBuilder.AppendFormat("PC->Parameters.Add(TEXT(\"{0}\"), new FIntParamValue({1}));\r\n", property.SourceName, value);
-                }
+                AddEntry(entry, "Int", value);
             }
             else if (property is UhtByteProperty byteProperty)
             {
@@ -256,33 +155,19 @@ namespace UnLuaDefaultParamCollectorUbtPlugin
                 {
                     var index = byteProperty.Enum.GetIndexByName(valueStr);
                     var value = index == -1 ? -1 : byteProperty.Enum.EnumValues[index].Value;
-            
-                    PreAddProperty(classObj, function);
-                    if (value == 0)
+                    if (value is >= 0 and <= 255)
                     {
-                        GeneratedContentBuilder.AppendFormat("PC->Parameters.Add(TEXT(\"{0}\"), SharedByte_Zero);\r\n", property.SourceName);
-                    }
-                    else if (value is > 0 and <= 255)
-                    {
-                        GeneratedContentBuilder.AppendFormat("PC->Parameters.Add(TEXT(\"{0}\"), new FByteParamValue({1}));\r\n", property.SourceName, value);
+                        AddEntry(entry, "Byte", value);
                     }
                     else
                     {
-                        GeneratedContentBuilder.AppendFormat("PC->Parameters.Add(TEXT(\"{0}\"), new FRuntimeEnumParamValue(\"{1}\",{2}));\r\n", property.SourceName, byteProperty.Enum.CppType, index);
+                        AddEntry(entry, "RuntimeEnum", index, byteProperty.Enum.CppType);
                     }
                 }
                 else
                 {
                     int.TryParse(valueStr, out var value);
-                    PreAddProperty(classObj, function);
-                    if (value == 0)
-                    {
-                        GeneratedContentBuilder.AppendFormat("PC->Parameters.Add(TEXT(\"{0}\"), SharedByte_Zero);\r\n", property.SourceName);
-                    }
-                    else
-                    {
-                        GeneratedContentBuilder.AppendFormat("PC->Parameters.Add(TEXT(\"{0}\"), new FByteParamValue({1}));\r\n", property.SourceName, value);
-                    }
+                    AddEntry(entry, "Byte", value);
                 }
             }
             else if (property is UhtEnumProperty enumProperty)
@@ -290,108 +175,113 @@ namespace UnLuaDefaultParamCollectorUbtPlugin
                 // [Mark]: A ByteProperty in C++ may be recognized as EnumProperty in C#, its UnderlyingProperty is null
                 var index = enumProperty.Enum.GetIndexByName(valueStr);
                 var value = index == -1 ? -1 : enumProperty.Enum.EnumValues[index].Value;
-                
-                PreAddProperty(classObj, function);
                 var isFakeEnum = enumProperty.UnderlyingProperty == null;
-                if (value == 0)
-                {
-                    GeneratedContentBuilder.AppendFormat("PC->Parameters.Add(TEXT(\"{0}\"), {1});\r\n", property.SourceName, isFakeEnum ? "SharedByte_Zero" : "SharedEnum_Zero");
-                }
-                else if (value is > 0 and <= 255)
+                if (value is >= 0 and <= 255)
                 {
-                    GeneratedContentBuilder.AppendFormat("PC->Parameters.Add(TEXT(\"{0}\"), new {1}({2}));\r\n", property.SourceName, isFakeEnum ? "FByteParamValue" : "FEnumParamValue", value);
+                    AddEntry(entry, isFakeEnum ? "Byte" : "Enum", value);
                 }
                 else
                 {
-                    GeneratedContentBuilder.AppendFormat("PC->Parameters.Add(TEXT(\"{0}\"), new FRuntimeEnumParamValue(\"{1}\",{2}));\r\n", property.SourceName, enumProperty.Enum.CppType, index);
+                    AddEntry(entry, "RuntimeEnum", index, enumProperty.Enum.CppType);
                 }
             }
             else if (property is UhtFloatProperty)
             {
                 // 1.f is not valid in C#
                 float.TryParse(valueStr.Replace(".f", ""), out var value);
-                PreAddProperty(classObj, function);
-                if (Math.Abs(value) < 1E-8)
-                {
-                    GeneratedContentBuilder.AppendFormat("PC->Parameters.Add(TEXT(\"{0}\"), SharedFloat_Zero);\r\n", property.SourceName);
-                }
-                else if (Math.Abs(value - 1) < 1E-8)
-                {
-                    GeneratedContentBuilder.AppendFormat("PC->Parameters.Add(TEXT(\"{0}\"), SharedFloat_One);\r\n", property.SourceName);
-                }
-                else
-                {
-                    GeneratedContentBuilder.AppendFormat("PC->Parameters.Add(TEXT(\"{0}\"), new FFloatParamValue({1:F6}f));\r\n", property.SourceName, value);
-                }
+                AddEntry(entry, "Float", value);
             }
             else if (property is UhtDoubleProperty)
             {
-                PreAddProperty(classObj, function);
-                GeneratedContentBuilder.AppendFormat("PC->Parameters.Add(TEXT(\"{0}\"), new FDoubleParamValue({1:F6}));\r\n", property.SourceName, double.Parse(valueStr));
+                AddEntry(entry, "Double", double.Parse(valueStr));
             }
             else if (property is UhtBoolProperty)
             {
-                PreAddProperty(classObj, function);
-                GeneratedContentBuilder.AppendFormat("PC->Parameters.Add(TEXT(\"{0}\"), SharedBool_{1});\r\n", property.SourceName, valueStr.ToUpper());
+                AddEntry(entry, "Bool", valueStr.Equals("true", StringComparison.OrdinalIgnoreCase) ? 1 : 0);
             }
             else if (property is UhtNameProperty)
             {
-                PreAddProperty(classObj, function);
-                if (valueStr.Equals("None"))
-                {
-                    GeneratedContentBuilder.AppendFormat("PC->Parameters.Add(TEXT(\"{0}\"), SharedFName_None);\r\n", property.SourceName);
-                }
-                else
-                {
-                    GeneratedContentBuilder.AppendFormat("PC->Parameters.Add(TEXT(\"{0}\"), new FNameParamValue(FName(\"{1}\")));\r\n", property.SourceName, valueStr);
-                }
+                AddEntry(entry, "Name", valueStr);
             }
             else if (property is UhtTextProperty)
             {
-                PreAddProperty(classObj, function);
-                if (valueStr.StartsWith("INVTEXT(\""))
+                if (valueStr.StartsWith("INVTEXT(\"") && valueStr.EndsWith("\")"))
                 {
-                    GeneratedContentBuilder.AppendFormat("PC->Parameters.Add(TEXT(\"{0}\"), new FTextParamValue({1}));\r\n", property.SourceName, valueStr);
+                    AddEntry(entry, "InvariantText", valueStr.Substring(9, valueStr.Length - 11));
                 }
                 else
                 {
-                    GeneratedContentBuilder.AppendFormat("PC->Parameters.Add(TEXT(\"{0}\"), new FTextParamValue(FText::FromString(TEXT(\"{1}\"))));\r\n", property.SourceName, valueStr);
+                    AddEntry(entry, "Text", valueStr);
                 }
             }
             else if (property is UhtStrProperty)
             {
-                PreAddProperty(classObj, function);
-                GeneratedContentBuilder.AppendFormat("PC->Parameters.Add(TEXT(\"{0}\"), new FStringParamValue(TEXT(\"{1}\")));\r\n", property.SourceName, valueStr);
+                AddEntry(entry, "String", valueStr);
             }
             else if (property is UhtArrayProperty)
             {
-                PreAddProperty(classObj, function);
-                GeneratedContentBuilder.AppendFormat("PC->Parameters.Add(TEXT(\"{0}\"), SharedScriptArray);\r\n", property.SourceName);
+                AddEntry(entry, "ScriptArray");
             }
             else if (property is UhtDelegateProperty)
             {
-                PreAddProperty(classObj, function);
-                GeneratedContentBuilder.AppendFormat("PC->Parameters.Add(TEXT(\"{0}\"), SharedScriptDelegate);\r\n", property.SourceName);
+                AddEntry(entry, "ScriptDelegate");
             }
             else if (property is UhtMulticastDelegateProperty)
             {
-                PreAddProperty(classObj, function);
-                GeneratedContentBuilder.AppendFormat("PC->Parameters.Add(TEXT(\"{0}\"), SharedMulticastDelegate);\r\n", property.SourceName);
+                AddEntry(entry, "MulticastScriptDelegate");
             }
         }
 
-        private void PreAddProperty(UhtClass classObj, UhtFunction function)
+        private void AddEntry(DefaultParamEntry entry, string type, params double[] values)
         {
-            if (!bCurrentClassWritten)
+            AddEntry(entry, type, values, null);
+        }
+
+        private void AddEntry(DefaultParamEntry entry, string type, string str)
+        {
+            AddEntry(entry, type, new double[] {}, str);
+        }
+
+        private void AddEntry(DefaultParamEntry entry, string type, double index, string str)
+        {
+            AddEntry(entry, type, new[] { index }, str);
+        }
+
+        private void AddEntry(DefaultParamEntry entry, string type, double[] values, string? str)
+        {
+            var valuesStr = string.Join(",", values.Select(x => x.ToString("R", CultureInfo.InvariantCulture)));
+            var stringStr = str == null ? "nullptr" : $"TEXT(\"{str}\")";
+            entry.Line = $"{{0x{entry.Hash:x8}u, TEXT(\"{entry.ClassName}\"), TEXT(\"{entry.FunctionName}\"), TEXT(\"{entry.ParamName}\"), EDefaultParamType::{type}, {{{valuesStr}}}, {stringStr}}},\r\n";
+            Entries.Add(entry);
+        }
+
+        private class DefaultParamEntry
+        {
+            public DefaultParamEntry(string className, string functionName, string paramName)
             {
-                bCurrentClassWritten = true;
-                GeneratedContentBuilder.AppendFormat("FC = &GDefaultParamCollection.Add(TEXT(\"{0}\"));\r\n", classObj.EngineNamePrefix + classObj.EngineName);
+                ClassName = className;
+                FunctionName = functionName;
+                ParamName = paramName;
+                Hash = HashFunction(className, functionName);
             }
-            if (!bCurrentFunctionWritten)
+
+            // 与运行时的HashDefaultParamFunction保持一致
+            private static uint HashFunction(string className, string functionName)
             {
-                bCurrentFunctionWritten = true;
-                GeneratedContentBuilder.AppendFormat("PC = &FC->Functions.Add(TEXT(\"{0}\"));\r\n", function.StrippedFunctionName);
+                uint hash = 2166136261;
+                foreach (char c in className + "." + functionName)
+                {
+                    hash ^= c;
+                    hash *= 16777619;
+                }
+                return hash;
             }
+
+            public readonly string ClassName;
+            public readonly string FunctionName;
+            public readonly string ParamName;
+            public readonly uint Hash;
+            public string Line = string.Empty;
         }
 
         private static bool FindDefaultValueString(UhtMetaData metaData, UhtProperty property, out string value)
@@ -417,6 +307,12 @@ namespace UnLuaDefaultParamCollectorUbtPlugin
 
         private void Finish()
         {
+            // 按函数哈希排序，运行时二分查找
+            foreach (var entry in Entries.OrderBy(x => x.Hash))
+            {
+                GeneratedContentBuilder.Append(entry.Line);
+            }
+
             var generatedFileContent = GeneratedContentBuilder.ToString();
             string filePath = Factory.MakePath("DefaultParamCollection", ".inl");
             
@@ -439,8 +335,7 @@ namespace UnLuaDefaultParamCollectorUbtPlugin
         private UhtSession Session => Factory.Session;
 
         private bool bHasGameRuntime;
-        private bool bCurrentClassWritten;
-        private bool bCurrentFunctionWritten;
+        private readonly List<DefaultParamEntry> Entries = new List<DefaultParamEntry>();
         private BorrowStringBuilder Borrower;
         private StringBuilder GeneratedContentBuilder => Borrower.StringBuilder;
     }
@@ -114,7 +114,21 @@ void UUnLuaEditorFunctionLibrary::OnLuaFilesModified(const TArray<FFileChangeDat
     const auto& Settings = *GetDefault<UUnLuaEditorSettings>();
     if (Settings.HotReloadMode != EHotReloadMode::Auto)
         return;
-    UUnLuaFunctionLibrary::HotReload();
+
+    // 只重载发生变化的模块，依赖它们的模块由运行时的依赖图展开
+    TArray<FString> ModuleNames;
+    for (const auto& FileChange : FileChanges)
+    {
+        if (FileChange.Action == FFileChangeData::FCA_Removed)
+            continue;
+
+        const auto ModuleName = UUnLuaFunctionLibrary::GetModuleNameFromFilePath(FileChange.Filename);
+        if (!ModuleName.IsEmpty())
+            ModuleNames.AddUnique(ModuleName);
+    }
+
+    if (ModuleNames.Num() > 0)
+        UUnLuaFunctionLibrary::HotReloadModules(ModuleNames);
 }
 
 FDelegateHandle UUnLuaEditorFunctionLibrary::DirectoryWatcherHandle;
@@ -27,11 +27,16 @@
 #include "Blueprint/WidgetTree.h"
 #include "Engine/Blueprint.h"
 #include "Interfaces/IPluginManager.h"
+#include "Async/ParallelFor.h"
+#include "Misc/FileHelper.h"
 
 #define LOCTEXT_NAMESPACE "UnLuaIntelliSenseGenerator"
 
 TSharedPtr<FUnLuaIntelliSenseGenerator> FUnLuaIntelliSenseGenerator::Singleton;
 
+static const TCHAR* MANIFEST_FILE_NAME = TEXT("IntelliSense.manifest");
+static const TCHAR* MANIFEST_BLUEPRINT_PREFIX = TEXT("Blueprint:");
+
 TSharedRef<FUnLuaIntelliSenseGenerator> FUnLuaIntelliSenseGenerator::Get()
 {
     if (!Singleton.IsValid())
@@ -73,36 +78,58 @@ void FUnLuaIntelliSenseGenerator::UpdateAll()
     AssetRegistryModule.Get().GetAssets(Filter, BlueprintAssets);
     CollectTypes(NativeTypes);
 
-    auto TotalCount = BlueprintAssets.Num() + NativeTypes.Num();
-    if (TotalCount == 0)
+    if (BlueprintAssets.Num() + NativeTypes.Num() == 0)
         return;
 
-    TotalCount++;
+    LoadManifest();
 
-    FScopedSlowTask SlowTask(TotalCount, LOCTEXT("GeneratingBlueprintsIntelliSense", "Generating Blueprints InstelliSense"));
+    FScopedSlowTask SlowTask(BlueprintAssets.Num() + 2, LOCTEXT("GeneratingBlueprintsIntelliSense", "Generating Blueprints InstelliSense"));
     SlowTask.MakeDialog();
 
     for (int32 i = 0; i < BlueprintAssets.Num(); i++)
-    {
-        if (SlowTask.ShouldCancel())
-            break;
-        OnAssetUpdated(BlueprintAssets[i]);
-        SlowTask.EnterProgressFrame();
-    }
-
-    for (const auto Type : NativeTypes)
     {
         if (SlowTask.ShouldCancel())
             break;
 
-        Export(Type);
+        // 资源文件没有变化、没有未保存的修改且生成的文件还在时不用加载蓝图
+        const FAssetData& AssetData = BlueprintAssets[i];
+        const FString Key = MANIFEST_BLUEPRINT_PREFIX + AssetData.ObjectPath.ToString();
+        const FString Stamp = GetBlueprintStamp(AssetData);
+        const UObject* Loaded = AssetData.FastGetAsset(false);
+        const bool bDirty = Loaded && Loaded->GetOutermost()->IsDirty();
+        const bool bFileExists = IFileManager::Get().FileExists(*GetFilePath(AssetData.PackagePath.ToString(), AssetData.AssetName.ToString()));
+        if (bDirty || Stamp.IsEmpty() || !bFileExists || BlueprintStamps.FindRef(Key) != Stamp)
+        {
+            OnAssetUpdated(AssetData);
+            if (!bDirty && !Stamp.IsEmpty())
+                BlueprintStamps.Add(Key, Stamp);
+        }
         SlowTask.EnterProgressFrame();
     }
 
     if (SlowTask.ShouldCancel())
+    {
+        SaveManifest();
         return;
+    }
+
+    // 反射信息只能在游戏线程上读取，先生成所有内容，只把比较与写文件放到其他线程
+    TArray<FString> ModuleNames, FileNames, Contents;
+    ModuleNames.SetNum(NativeTypes.Num());
+    FileNames.SetNum(NativeTypes.Num());
+    Contents.SetNum(NativeTypes.Num());
+    for (int32 Index = 0; Index < NativeTypes.Num(); ++Index)
+        Generate(NativeTypes[Index], ModuleNames[Index], FileNames[Index], Contents[Index]);
+
+    ParallelFor(NativeTypes.Num(), [&](const int32 Index)
+    {
+        SaveFile(ModuleNames[Index], FileNames[Index], Contents[Index]);
+    });
+    SlowTask.EnterProgressFrame();
+
     ExportUE(NativeTypes);
     ExportUnLua();
+    SaveManifest();
     SlowTask.EnterProgressFrame();
 }
 
@@ -126,6 +153,11 @@ bool FUnLuaIntelliSenseGenerator::ShouldExport(const FAssetData& AssetData, bool
     if (!IsBlueprint(AssetData))
         return false;
 
+    // 需要加载时，有生成类的标签就不用为了检查先加载一次；其他资源事件只处理已加载的蓝图
+    FString GeneratedClassPath;
+    if (bLoad && AssetData.GetTagValue(FBlueprintTags::GeneratedClassPath, GeneratedClassPath) && !GeneratedClassPath.IsEmpty())
+        return true;
+
     const auto Asset = AssetData.FastGetAsset(bLoad);
     if (!Asset)
         return false;
@@ -146,24 +178,30 @@ void FUnLuaIntelliSenseGenerator::Export(const UBlueprint* Blueprint)
 }
 
 void FUnLuaIntelliSenseGenerator::Export(const UField* Field)
+{
+    FString ModuleName, FileName, Content;
+    Generate(Field, ModuleName, FileName, Content);
+    SaveFile(ModuleName, FileName, Content);
+}
+
+void FUnLuaIntelliSenseGenerator::Generate(const UField* Field, FString& OutModuleName, FString& OutFileName, FString& OutContent)
 {
 #if ENGINE_MAJOR_VERSION > 4 || (ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION >= 26)
     const UPackage* Package = Field->GetPackage();
 #else
     const UPackage* Package = (UPackage*)Field->GetTypedOuter(UPackage::StaticClass());
 #endif
-    auto ModuleName = Package->GetName();
+    OutModuleName = Package->GetName();
     if (!Field->IsNative())
     {
         int32 LastSlashIndex;
-        if (ModuleName.FindLastChar('/', LastSlashIndex))
-            ModuleName.LeftInline(LastSlashIndex);
+        if (OutModuleName.FindLastChar('/', LastSlashIndex))
+            OutModuleName.LeftInline(LastSlashIndex);
     }
-    FString FileName = UnLua::IntelliSense::GetTypeName(Field);
-    if (FileName.EndsWith("_C"))
-        FileName.LeftChopInline(2);
-    const FString Content = UnLua::IntelliSense::Get(Field);
-    SaveFile(ModuleName, FileName, Content);
+    OutFileName = UnLua::IntelliSense::GetTypeName(Field);
+    if (OutFileName.EndsWith("_C"))
+        OutFileName.LeftChopInline(2);
+    OutContent = UnLua::IntelliSense::Get(Field);
 }
 
 void FUnLuaIntelliSenseGenerator::ExportUE(const TArray<const UField*> Types)
@@ -226,11 +264,23 @@ void FUnLuaIntelliSenseGenerator::SaveFile(const FString& ModuleName, const FStr
     if (!FileManager.DirectoryExists(*Directory))
         FileManager.MakeDirectory(*Directory);
 
-    const FString FilePath = FString::Printf(TEXT("%s/%s.lua"), *Directory, *FileName);
+    const FString FilePath = GetFilePath(ModuleName, FileName);
+    const FString Key = ModuleName / FileName;
+    const uint32 Hash = FCrc::StrCrc32(*GeneratedFileContent);
+    {
+        FScopeLock Lock(&ManifestLock);
+        const uint32* Cached = ContentHashes.Find(Key);
+        if (Cached && *Cached == Hash && FileManager.FileExists(*FilePath))
+            return;
+    }
+
     FString FileContent;
     FFileHelper::LoadFileToString(FileContent, *FilePath);
-    if (FileContent != GeneratedFileContent)
-        FFileHelper::SaveStringToFile(GeneratedFileContent, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+    if (FileContent != GeneratedFileContent && !FFileHelper::SaveStringToFile(GeneratedFileContent, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+        return;
+
+    FScopeLock Lock(&ManifestLock);
+    ContentHashes.Add(Key, Hash);
 }
 
 void FUnLuaIntelliSenseGenerator::DeleteFile(const FString& ModuleName, const FString& FileName)
@@ -240,9 +290,61 @@ void FUnLuaIntelliSenseGenerator::DeleteFile(const FString& ModuleName, const FS
     if (!FileManager.DirectoryExists(*Directory))
         FileManager.MakeDirectory(*Directory);
 
-    const FString FilePath = FString::Printf(TEXT("%s/%s.lua"), *Directory, *FileName);
+    const FString FilePath = GetFilePath(ModuleName, FileName);
     if (FileManager.FileExists(*FilePath))
         FileManager.Delete(*FilePath);
+
+    FScopeLock Lock(&ManifestLock);
+    ContentHashes.Remove(ModuleName / FileName);
+}
+
+FString FUnLuaIntelliSenseGenerator::GetFilePath(const FString& ModuleName, const FString& FileName) const
+{
+    return FString::Printf(TEXT("%s/%s.lua"), *(OutputDir / ModuleName), *FileName);
+}
+
+void FUnLuaIntelliSenseGenerator::LoadManifest()
+{
+    if (bManifestLoaded)
+        return;
+    bManifestLoaded = true;
+
+    TArray<FString> Lines;
+    if (!FFileHelper::LoadFileToStringArray(Lines, *(OutputDir / MANIFEST_FILE_NAME)))
+        return;
+
+    FString Key, Value;
+    for (const auto& Line : Lines)
+    {
+        if (!Line.Split(TEXT("\t"), &Key, &Value))
+            continue;
+        if (Key.StartsWith(MANIFEST_BLUEPRINT_PREFIX))
+            BlueprintStamps.Add(Key, Value);
+        else
+            ContentHashes.Add(Key, (uint32)FCString::Strtoui64(*Value, nullptr, 10));
+    }
+}
+
+void FUnLuaIntelliSenseGenerator::SaveManifest()
+{
+    FString Content;
+    for (const auto& Pair : ContentHashes)
+        Content += FString::Printf(TEXT("%s\t%u\n"), *Pair.Key, Pair.Value);
+    for (const auto& Pair : BlueprintStamps)
+        Content += FString::Printf(TEXT("%s\t%s\n"), *Pair.Key, *Pair.Value);
+    FFileHelper::SaveStringToFile(Content, *(OutputDir / MANIFEST_FILE_NAME), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
+
+FString FUnLuaIntelliSenseGenerator::GetBlueprintStamp(const FAssetData& AssetData)
+{
+    FString FileName;
+    if (!FPackageName::TryConvertLongPackageNameToFilename(AssetData.PackageName.ToString(), FileName, FPackageName::GetAssetPackageExtension()))
+        return FString();
+
+    const FFileStatData StatData = IFileManager::Get().GetStatData(*FileName);
+    if (!StatData.bIsValid)
+        return FString();
+    return FString::Printf(TEXT("%lld-%lld"), StatData.ModificationTime.GetTicks(), StatData.FileSize);
 }
 
 void FUnLuaIntelliSenseGenerator::OnAssetAdded(const FAssetData& AssetData)
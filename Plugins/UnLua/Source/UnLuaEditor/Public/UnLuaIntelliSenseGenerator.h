@@ -23,7 +23,7 @@ class FUnLuaIntelliSenseGenerator
 {
 public:
     FUnLuaIntelliSenseGenerator()
-        : bInitialized(false)
+        : bInitialized(false), bManifestLoaded(false)
     {
     }
 
@@ -45,6 +45,9 @@ private:
 
     void Export(const UField* Field);
 
+    /* 生成一个类型的文件内容，会读取反射信息，只能在游戏线程调用 */
+    static void Generate(const UField* Field, FString& OutModuleName, FString& OutFileName, FString& OutContent);
+
     void ExportUE(const TArray<const UField*> Types);
 
     void ExportUnLua();
@@ -54,6 +57,12 @@ private:
     // File helper
     void SaveFile(const FString& ModuleName, const FString& FileName, const FString& GeneratedFileContent);
     void DeleteFile(const FString& ModuleName, const FString& FileName);
+    FString GetFilePath(const FString& ModuleName, const FString& FileName) const;
+
+    // Manifest helper
+    void LoadManifest();
+    void SaveManifest();
+    static FString GetBlueprintStamp(const FAssetData& AssetData);
 
     // Handle asset event
     void OnAssetAdded(const FAssetData& AssetData);
@@ -63,4 +72,10 @@ private:
 
     FString OutputDir;
     bool bInitialized;
+
+    // 生成文件的内容哈希与蓝图资源文件的时间戳，没有变化时跳过写文件和加载蓝图
+    TMap<FString, uint32> ContentHashes;
+    TMap<FString, FString> BlueprintStamps;
+    FCriticalSection ManifestLock;
+    bool bManifestLoaded;
 };
@@ -13,10 +13,10 @@
 // See the License for the specific language governing permissions and limitations under the License.
 
 #include "LuaProtobufModule.h"
+#include "LuaProtobufStruct.h"
 #include "LuaEnv.h"
 #include "pb.h"
 
-extern "C" int luaopen_pb(lua_State *L);
 extern "C" int luaopen_pb_unsafe(lua_State *L);
 
 void FLuaProtobufModule::StartupModule()
@@ -31,7 +31,7 @@ void FLuaProtobufModule::ShutdownModule()
 
 void FLuaProtobufModule::OnLuaEnvCreated(UnLua::FLuaEnv& Env)
 {
-    Env.AddBuiltInLoader(TEXT("pb"), luaopen_pb);
+    Env.AddBuiltInLoader(TEXT("pb"), LuaProtobuf::Open);
     Env.AddBuiltInLoader(TEXT("pb.unsafe"), luaopen_pb_unsafe);
     Env.DoString("UnLua.PackagePath = UnLua.PackagePath .. ';/Plugins/UnLuaExtensions/LuaProtobuf/Content/Script/?.lua'");
 }
@@ -0,0 +1,1092 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+//
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License");
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+
+#ifdef _MSC_VER
+# pragma warning(disable: 4244) /* int -> char */
+# pragma warning(disable: 4505) /* unreferenced static function */
+# pragma warning(disable: 4706) /* = in if condition */
+# pragma warning(disable: 4127) /* const in if condition */
+#endif
+
+#include "LuaProtobufStruct.h"
+#include "LuaCore.h"
+#include "UnLuaBase.h"
+#include "UObject/EnumProperty.h"
+#include "UObject/TextProperty.h"
+
+// 与pb.cpp一样以静态方式展开pb.h的实现，类型信息本身仍由pb.cpp中的pb.State持有
+#define PB_STATIC_API
+#include "pb.h"
+
+PB_NS_BEGIN
+typedef struct lpb_State lpb_State;
+LUALIB_API lpb_State* lpb_lstate(lua_State* L);
+LUALIB_API const pb_Type* lpb_type(lpb_State* LS, pb_Slice s);
+LUALIB_API int luaopen_pb(lua_State* L);
+PB_NS_END
+
+namespace LuaProtobuf
+{
+    enum class EValueKind : uint8
+    {
+        Numeric,
+        Bool,
+        String,
+        Name,
+        Text,
+        Bytes,
+        Message,
+    };
+
+    enum class EContainerKind : uint8
+    {
+        Single,
+        Array,
+        Set,
+        Map,
+    };
+
+    struct FMessageBinding;
+
+    struct FValueBinding
+    {
+        const pb_Field* Field = nullptr;
+        FProperty* Property = nullptr;
+        EValueKind Kind = EValueKind::Numeric;
+        const FMessageBinding* Message = nullptr;
+        TMap<FName, int32> EnumValues; // pb枚举绑定到FString/FName时，按名字编码
+    };
+
+    struct FFieldBinding
+    {
+        const pb_Field* Field = nullptr;
+        FProperty* Property = nullptr;
+        EContainerKind Container = EContainerKind::Single;
+        FValueBinding Key;
+        FValueBinding Value;
+    };
+
+    /* 一个pb_Type与一个UScriptStruct的绑定，字段按编号排序，编号较小时直接查表 */
+    struct FMessageBinding
+    {
+        static constexpr int32 MaxDenseNumber = 1024;
+
+        const pb_Type* Type = nullptr;
+        TWeakObjectPtr<UScriptStruct> Struct;
+        TArray<FFieldBinding> Fields;
+        TArray<int32> DenseIndices;
+        TMap<int32, int32> SparseIndices;
+
+        FORCEINLINE const FFieldBinding* Find(uint32 Number) const
+        {
+            if (Number < (uint32)DenseIndices.Num())
+            {
+                const int32 Index = DenseIndices[Number];
+                return Index != INDEX_NONE ? &Fields[Index] : nullptr;
+            }
+            const int32* Index = SparseIndices.Find(Number);
+            return Index ? &Fields[*Index] : nullptr;
+        }
+    };
+
+    /* 数值统一按64位保存，编码/解码时再按pb类型和属性类型转换 */
+    struct FScalar
+    {
+        int64 Int = 0;
+        double Float = 0;
+        bool bFloat = false;
+        bool bUnsigned = false;
+
+        FORCEINLINE int64 AsInt() const { return bFloat ? (int64)Float : Int; }
+        FORCEINLINE double AsFloat() const { return bFloat ? Float : (bUnsigned ? (double)(uint64)Int : (double)Int); }
+    };
+
+    typedef TPair<const pb_Type*, const UScriptStruct*> FBindingKey;
+
+    /**
+     * 一个Lua虚拟机上的绑定缓存，pb_Type由该虚拟机的pb.State持有，缓存随虚拟机一起被GC
+     */
+    struct FBindingCache
+    {
+        const void* PbState = nullptr;
+        TMap<FBindingKey, TUniquePtr<FMessageBinding>> Bindings;
+    };
+
+    static const char* BINDING_CACHE_KEY = "UnLuaProtobufBindings";
+    static const char* BINDING_CACHE_METATABLE_NAME = "UnLuaProtobufBindingCache";
+
+    static int BindingCache_GC(lua_State* L)
+    {
+        const auto Cache = (FBindingCache*)lua_touserdata(L, 1);
+        Cache->~FBindingCache();
+        return 0;
+    }
+
+    static FBindingCache& GetBindingCache(lua_State* L)
+    {
+        if (lua_getfield(L, LUA_REGISTRYINDEX, BINDING_CACHE_KEY) == LUA_TUSERDATA)
+        {
+            const auto Cache = (FBindingCache*)lua_touserdata(L, -1);
+            lua_pop(L, 1);
+            return *Cache;
+        }
+        lua_pop(L, 1);
+
+        const auto Cache = new(lua_newuserdata(L, sizeof(FBindingCache))) FBindingCache();
+        if (luaL_newmetatable(L, BINDING_CACHE_METATABLE_NAME))
+        {
+            lua_pushcfunction(L, BindingCache_GC);
+            lua_setfield(L, -2, "__gc");
+        }
+        lua_setmetatable(L, -2);
+        lua_setfield(L, LUA_REGISTRYINDEX, BINDING_CACHE_KEY);
+        return *Cache;
+    }
+
+    static const FMessageBinding* Bind(FBindingCache& Cache, const pb_Type* Type, const UScriptStruct* Struct);
+
+    static const FNumericProperty* GetNumericProperty(const FProperty* Property)
+    {
+        if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+            return EnumProperty->GetUnderlyingProperty();
+        return CastField<FNumericProperty>(Property);
+    }
+
+    static bool IsByteArray(const FProperty* Property)
+    {
+        const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property);
+        if (!ArrayProperty)
+            return false;
+        const FByteProperty* Inner = CastField<FByteProperty>(ArrayProperty->Inner);
+        return Inner && !Inner->Enum;
+    }
+
+    /* 与FClassDesc::RegisterField保持一致，蓝图结构体的字段名去掉 _序号_GUID 后缀 */
+    static FString GetDisplayName(const FProperty* Property)
+    {
+        FString Name = Property->GetName();
+        const int32 GuidStrLen = 32;
+        const int32 MinimalPostfixlen = GuidStrLen + 3;
+        if (Name.Len() > MinimalPostfixlen)
+        {
+            Name = Name.LeftChop(GuidStrLen + 1);
+            int32 FirstCharToRemove = INDEX_NONE;
+            if (Name.FindLastChar(TCHAR('_'), FirstCharToRemove))
+                Name = Name.Mid(0, FirstCharToRemove);
+        }
+        return Name;
+    }
+
+    /**
+     * 按字段名查找属性，依次尝试原名、snake_case转PascalCase、bool的b前缀
+     */
+    static FProperty* FindProperty(const UScriptStruct* Struct, const char* FieldName)
+    {
+        const FString Name = UTF8_TO_TCHAR(FieldName);
+        if (FProperty* Property = Struct->FindPropertyByName(FName(*Name)))
+            return Property;
+
+        FString PascalName;
+        PascalName.Reserve(Name.Len());
+        bool bUpper = true;
+        for (const TCHAR Char : Name)
+        {
+            if (Char == TCHAR('_'))
+            {
+                bUpper = true;
+                continue;
+            }
+            PascalName.AppendChar(bUpper ? FChar::ToUpper(Char) : Char);
+            bUpper = false;
+        }
+
+        if (FProperty* Property = Struct->FindPropertyByName(FName(*PascalName)))
+            return Property;
+
+        if (FBoolProperty* Property = CastField<FBoolProperty>(Struct->FindPropertyByName(FName(*(TEXT("b") + PascalName)))))
+            return Property;
+
+        if (!Struct->IsNative())
+        {
+            for (TFieldIterator<FProperty> It(Struct); It; ++It)
+            {
+                const FString DisplayName = GetDisplayName(*It);
+                if (DisplayName.Equals(Name, ESearchCase::IgnoreCase) || DisplayName.Equals(PascalName, ESearchCase::IgnoreCase))
+                    return *It;
+            }
+        }
+        return nullptr;
+    }
+
+    static bool BindValue(FBindingCache& Cache, const pb_Field* Field, FProperty* Property, FValueBinding& Out)
+    {
+        Out.Field = Field;
+        Out.Property = Property;
+        switch (Field->type_id)
+        {
+        case PB_Tgroup:
+            return false;
+
+        case PB_Tmessage:
+            if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+            {
+                if (!Field->type || Field->type->is_dead || Field->type->is_map)
+                    return false;
+                Out.Kind = EValueKind::Message;
+                Out.Message = Bind(Cache, Field->type, StructProperty->Struct);
+                return Out.Message != nullptr;
+            }
+            return false;
+
+        case PB_Tstring:
+        case PB_Tbytes:
+            if (CastField<FStrProperty>(Property))
+                Out.Kind = EValueKind::String;
+            else if (CastField<FNameProperty>(Property))
+                Out.Kind = EValueKind::Name;
+            else if (CastField<FTextProperty>(Property))
+                Out.Kind = EValueKind::Text;
+            else if (IsByteArray(Property))
+                Out.Kind = EValueKind::Bytes;
+            else
+                return false;
+            return true;
+
+        case PB_Tenum:
+            if (CastField<FStrProperty>(Property) || CastField<FNameProperty>(Property))
+            {
+                if (!Field->type)
+                    return false;
+                Out.Kind = CastField<FStrProperty>(Property) ? EValueKind::String : EValueKind::Name;
+                const pb_Field* EnumValue = nullptr;
+                while (pb_nextfield(Field->type, &EnumValue))
+                    Out.EnumValues.Add(FName(UTF8_TO_TCHAR((const char*)EnumValue->name)), EnumValue->number);
+                return true;
+            }
+            break;
+
+        default:
+            break;
+        }
+
+        if (CastField<FBoolProperty>(Property))
+        {
+            Out.Kind = EValueKind::Bool;
+            return true;
+        }
+        if (GetNumericProperty(Property))
+        {
+            Out.Kind = EValueKind::Numeric;
+            return true;
+        }
+        return false;
+    }
+
+    static bool BindField(FBindingCache& Cache, const pb_Field* Field, FProperty* Property, FFieldBinding& Out)
+    {
+        Out.Field = Field;
+        Out.Property = Property;
+        if (Property->ArrayDim != 1)
+            return false;
+
+        if (Field->type && Field->type->is_map)
+        {
+            FMapProperty* MapProperty = CastField<FMapProperty>(Property);
+            const pb_Field* KeyField = pb_field(Field->type, 1);
+            const pb_Field* ValueField = pb_field(Field->type, 2);
+            Out.Container = EContainerKind::Map;
+            return MapProperty && KeyField && ValueField
+                && BindValue(Cache, KeyField, MapProperty->KeyProp, Out.Key)
+                && BindValue(Cache, ValueField, MapProperty->ValueProp, Out.Value);
+        }
+
+        if (Field->repeated)
+        {
+            if (FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+            {
+                Out.Container = EContainerKind::Array;
+                return BindValue(Cache, Field, ArrayProperty->Inner, Out.Value);
+            }
+            if (FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+            {
+                Out.Container = EContainerKind::Set;
+                return BindValue(Cache, Field, SetProperty->ElementProp, Out.Value);
+            }
+            return false;
+        }
+
+        Out.Container = EContainerKind::Single;
+        return BindValue(Cache, Field, Property, Out.Value);
+    }
+
+    static const FMessageBinding* Bind(FBindingCache& Cache, const pb_Type* Type, const UScriptStruct* Struct)
+    {
+        const FBindingKey Key(Type, Struct);
+        if (const TUniquePtr<FMessageBinding>* Existing = Cache.Bindings.Find(Key))
+            return Existing->Get();
+
+        // 先登记再绑定字段，自引用的消息（如TArray<FSelf>）可以直接拿到自身
+        FMessageBinding* Binding = Cache.Bindings.Add(Key, MakeUnique<FMessageBinding>()).Get();
+        Binding->Type = Type;
+        Binding->Struct = const_cast<UScriptStruct*>(Struct);
+
+        const pb_Field* Field = nullptr;
+        while (pb_nextfield(Type, &Field))
+        {
+            FProperty* Property = FindProperty(Struct, (const char*)Field->name);
+            if (!Property)
+            {
+                UE_LOG(LogUnLua, Verbose, TEXT("pb field '%s' of '%s' has no matching property in %s"),
+                       UTF8_TO_TCHAR((const char*)Field->name), UTF8_TO_TCHAR((const char*)Type->name), *Struct->GetName());
+                continue;
+            }
+
+            FFieldBinding FieldBinding;
+            if (!BindField(Cache, Field, Property, FieldBinding))
+            {
+                UE_LOG(LogUnLua, Warning, TEXT("pb field '%s' (%s) of '%s' is incompatible with property %s::%s (%s)"),
+                       UTF8_TO_TCHAR((const char*)Field->name), UTF8_TO_TCHAR(pb_typename(Field->type_id, "?")), UTF8_TO_TCHAR((const char*)Type->name),
+                       *Struct->GetName(), *Property->GetName(), *Property->GetCPPType());
+                continue;
+            }
+            Binding->Fields.Add(MoveTemp(FieldBinding));
+        }
+
+        Binding->Fields.Sort([](const FFieldBinding& A, const FFieldBinding& B) { return A.Field->number < B.Field->number; });
+        for (int32 Index = 0; Index < Binding->Fields.Num(); ++Index)
+        {
+            const int32 Number = Binding->Fields[Index].Field->number;
+            if (Number < FMessageBinding::MaxDenseNumber)
+            {
+                const int32 OldNum = Binding->DenseIndices.Num();
+                if (OldNum <= Number)
+                {
+                    Binding->DenseIndices.SetNumUninitialized(Number + 1);
+                    for (int32 Slot = OldNum; Slot < Number; ++Slot)
+                        Binding->DenseIndices[Slot] = INDEX_NONE;
+                }
+                Binding->DenseIndices[Number] = Index;
+            }
+            else
+            {
+                Binding->SparseIndices.Add(Number, Index);
+            }
+        }
+        return Binding;
+    }
+
+    static const FMessageBinding* FindBinding(lua_State* L, const char* TypeName, const UScriptStruct* Struct, FString& OutError)
+    {
+        lpb_State* PbState = lpb_lstate(L);
+        const pb_Type* Type = lpb_type(PbState, pb_slice(TypeName));
+        if (!Type)
+        {
+            OutError = FString::Printf(TEXT("type '%s' does not exists"), UTF8_TO_TCHAR(TypeName));
+            return nullptr;
+        }
+
+        // 切换了pb.State时pb_Type可能已失效，整体重建
+        FBindingCache& Cache = GetBindingCache(L);
+        if (Cache.PbState != PbState)
+        {
+            Cache.Bindings.Reset();
+            Cache.PbState = PbState;
+        }
+
+        const TUniquePtr<FMessageBinding>* Existing = Cache.Bindings.Find(FBindingKey(Type, Struct));
+        if (Existing && !(*Existing)->Struct.IsValid())
+            Cache.Bindings.Reset();
+
+        return Bind(Cache, Type, Struct);
+    }
+
+    class FDecoder
+    {
+    public:
+        FString Error;
+
+        bool DecodeMessage(const FMessageBinding& Binding, pb_Slice* S, void* Data, bool bMerge)
+        {
+            if (!bMerge)
+            {
+                for (const FFieldBinding& Field : Binding.Fields)
+                    Field.Property->ClearValue(Field.Property->ContainerPtrToValuePtr<void>(Data));
+            }
+
+            uint32_t Tag;
+            while (S->p < S->end)
+            {
+                if (!pb_readvarint32(S, &Tag))
+                    return Fail(TEXT("invalid tag"), S);
+
+                const FFieldBinding* Field = Binding.Find(pb_gettag(Tag));
+                if (!Field)
+                {
+                    if (!pb_skipvalue(S, Tag))
+                        return Fail(TEXT("invalid value"), S);
+                    continue;
+                }
+
+                void* ValuePtr = Field->Property->ContainerPtrToValuePtr<void>(Data);
+                const int WireType = pb_gettype(Tag);
+                const int Expected = pb_wtypebytype(Field->Field->type_id);
+                switch (Field->Container)
+                {
+                case EContainerKind::Single:
+                    if (WireType != Expected)
+                        return Mismatch(Field->Field, WireType, S);
+                    if (!ReadValue(Field->Value, S, ValuePtr))
+                        return false;
+                    break;
+
+                case EContainerKind::Array:
+                case EContainerKind::Set:
+                    if (WireType == PB_TBYTES && Expected != PB_TBYTES)
+                    {
+                        pb_Slice Packed;
+                        if (!pb_readbytes(S, &Packed))
+                            return Fail(TEXT("invalid packed field"), S);
+                        while (Packed.p < Packed.end)
+                        {
+                            if (!AddElement(*Field, &Packed, ValuePtr))
+                                return false;
+                        }
+                    }
+                    else
+                    {
+                        if (WireType != Expected)
+                            return Mismatch(Field->Field, WireType, S);
+                        if (!AddElement(*Field, S, ValuePtr))
+                            return false;
+                    }
+                    break;
+
+                case EContainerKind::Map:
+                    if (WireType != PB_TBYTES)
+                        return Mismatch(Field->Field, WireType, S);
+                    if (!AddPair(*Field, S, ValuePtr))
+                        return false;
+                    break;
+                }
+            }
+            return true;
+        }
+
+    private:
+        bool AddElement(const FFieldBinding& Field, pb_Slice* S, void* ContainerPtr)
+        {
+            if (Field.Container == EContainerKind::Array)
+            {
+                FScriptArrayHelper Helper(CastFieldChecked<FArrayProperty>(Field.Property), ContainerPtr);
+                const int32 Index = Helper.AddValue();
+                return ReadValue(Field.Value, S, Helper.GetRawPtr(Index));
+            }
+
+            FSetProperty* SetProperty = CastFieldChecked<FSetProperty>(Field.Property);
+            FProperty* ElementProperty = SetProperty->ElementProp;
+            void* Element = FMemory_Alloca(ElementProperty->ElementSize);
+            ElementProperty->InitializeValue(Element);
+            const bool bOk = ReadValue(Field.Value, S, Element);
+            if (bOk)
+                FScriptSetHelper(SetProperty, ContainerPtr).AddElement(Element);
+            ElementProperty->DestroyValue(Element);
+            return bOk;
+        }
+
+        bool AddPair(const FFieldBinding& Field, pb_Slice* S, void* ContainerPtr)
+        {
+            pb_Slice Entry;
+            if (!pb_readbytes(S, &Entry))
+                return Fail(TEXT("invalid map entry"), S);
+
+            FMapProperty* MapProperty = CastFieldChecked<FMapProperty>(Field.Property);
+            FProperty* KeyProperty = MapProperty->KeyProp;
+            FProperty* ValueProperty = MapProperty->ValueProp;
+            void* Key = FMemory_Alloca(KeyProperty->ElementSize);
+            void* Value = FMemory_Alloca(ValueProperty->ElementSize);
+            KeyProperty->InitializeValue(Key);
+            ValueProperty->InitializeValue(Value);
+
+            bool bOk = true;
+            uint32_t Tag;
+            while (bOk && Entry.p < Entry.end)
+            {
+                if (!pb_readvarint32(&Entry, &Tag))
+                {
+                    bOk = Fail(TEXT("invalid map entry tag"), &Entry);
+                    break;
+                }
+
+                const FValueBinding* Target = pb_gettag(Tag) == 1 ? &Field.Key : pb_gettag(Tag) == 2 ? &Field.Value : nullptr;
+                if (!Target)
+                    bOk = pb_skipvalue(&Entry, Tag) || Fail(TEXT("invalid value"), &Entry);
+                else if ((int)pb_gettype(Tag) != pb_wtypebytype(Target->Field->type_id))
+                    bOk = Mismatch(Target->Field, pb_gettype(Tag), &Entry);
+                else
+                    bOk = ReadValue(*Target, &Entry, Target == &Field.Key ? Key : Value);
+            }
+
+            // AddPair会替换已有的键，与pb中重复键后者覆盖前者的语义一致
+            if (bOk)
+                FScriptMapHelper(MapProperty, ContainerPtr).AddPair(Key, Value);
+            KeyProperty->DestroyValue(Key);
+            ValueProperty->DestroyValue(Value);
+            return bOk;
+        }
+
+        bool ReadValue(const FValueBinding& Value, pb_Slice* S, void* ValuePtr)
+        {
+            const int TypeId = Value.Field->type_id;
+            if (Value.Kind == EValueKind::Message)
+            {
+                pb_Slice Message;
+                if (!pb_readbytes(S, &Message))
+                    return Fail(TEXT("invalid message length"), S);
+                return DecodeMessage(*Value.Message, &Message, ValuePtr, true);
+            }
+
+            if (TypeId == PB_Tstring || TypeId == PB_Tbytes)
+            {
+                pb_Slice Bytes;
+                if (!pb_readbytes(S, &Bytes))
+                    return Fail(TEXT("invalid bytes length"), S);
+
+                const int32 Length = (int32)pb_len(Bytes);
+                if (Value.Kind == EValueKind::Bytes)
+                {
+                    FScriptArrayHelper Helper(CastFieldChecked<FArrayProperty>(Value.Property), ValuePtr);
+                    Helper.Resize(Length);
+                    if (Length > 0)
+                        FMemory::Memcpy(Helper.GetRawPtr(0), Bytes.p, Length);
+                    return true;
+                }
+
+                const FUTF8ToTCHAR Converted(Bytes.p, Length);
+                WriteString(Value, ValuePtr, FString(Converted.Length(), Converted.Get()));
+                return true;
+            }
+
+            FScalar Scalar;
+            if (!ReadScalar(TypeId, S, Scalar))
+                return Fail(TEXT("invalid scalar value"), S);
+
+            switch (Value.Kind)
+            {
+            case EValueKind::Bool:
+                CastFieldChecked<FBoolProperty>(Value.Property)->SetPropertyValue(ValuePtr, Scalar.bFloat ? Scalar.Float != 0 : Scalar.Int != 0);
+                return true;
+            case EValueKind::String:
+            case EValueKind::Name:
+            {
+                // 枚举按名字写入，找不到时退化为数字
+                const pb_Field* EnumValue = pb_field(Value.Field->type, (int32_t)Scalar.Int);
+                WriteString(Value, ValuePtr, EnumValue ? FString(UTF8_TO_TCHAR((const char*)EnumValue->name)) : LexToString(Scalar.Int));
+                return true;
+            }
+            default:
+                break;
+            }
+
+            const FNumericProperty* NumericProperty = GetNumericProperty(Value.Property);
+            if (NumericProperty->IsFloatingPoint())
+                NumericProperty->SetFloatingPointPropertyValue(ValuePtr, Scalar.AsFloat());
+            else if (Scalar.bUnsigned && !Scalar.bFloat)
+                NumericProperty->SetIntPropertyValue(ValuePtr, (uint64)Scalar.Int);
+            else
+                NumericProperty->SetIntPropertyValue(ValuePtr, Scalar.AsInt());
+            return true;
+        }
+
+        static bool ReadScalar(int TypeId, pb_Slice* S, FScalar& Out)
+        {
+            uint32_t U32;
+            uint64_t U64;
+            switch (TypeId)
+            {
+            case PB_Tdouble:
+                if (!pb_readfixed64(S, &U64)) return false;
+                Out.bFloat = true;
+                Out.Float = pb_decode_double(U64);
+                return true;
+            case PB_Tfloat:
+                if (!pb_readfixed32(S, &U32)) return false;
+                Out.bFloat = true;
+                Out.Float = pb_decode_float(U32);
+                return true;
+            case PB_Tfixed32:
+                if (!pb_readfixed32(S, &U32)) return false;
+                Out.Int = U32;
+                return true;
+            case PB_Tsfixed32:
+                if (!pb_readfixed32(S, &U32)) return false;
+                Out.Int = (int32)U32;
+                return true;
+            case PB_Tfixed64:
+            case PB_Tsfixed64:
+                if (!pb_readfixed64(S, &U64)) return false;
+                Out.Int = (int64)U64;
+                Out.bUnsigned = TypeId == PB_Tfixed64;
+                return true;
+            default:
+                break;
+            }
+
+            if (!pb_readvarint64(S, &U64))
+                return false;
+            switch (TypeId)
+            {
+            case PB_Tint32:
+            case PB_Tenum:
+                Out.Int = (int32)U64;
+                break;
+            case PB_Tuint32:
+                Out.Int = (uint32)U64;
+                break;
+            case PB_Tsint32:
+                Out.Int = pb_decode_sint32((uint32_t)U64);
+                break;
+            case PB_Tsint64:
+                Out.Int = pb_decode_sint64(U64);
+                break;
+            case PB_Tbool:
+                Out.Int = U64 != 0;
+                break;
+            case PB_Tuint64:
+                Out.bUnsigned = true;
+                Out.Int = (int64)U64;
+                break;
+            default:
+                Out.Int = (int64)U64;
+                break;
+            }
+            return true;
+        }
+
+        static void WriteString(const FValueBinding& Value, void* ValuePtr, const FString& String)
+        {
+            switch (Value.Kind)
+            {
+            case EValueKind::String:
+                CastFieldChecked<FStrProperty>(Value.Property)->SetPropertyValue(ValuePtr, String);
+                break;
+            case EValueKind::Name:
+                CastFieldChecked<FNameProperty>(Value.Property)->SetPropertyValue(ValuePtr, FName(*String));
+                break;
+            case EValueKind::Text:
+                CastFieldChecked<FTextProperty>(Value.Property)->SetPropertyValue(ValuePtr, FText::FromString(String));
+                break;
+            default:
+                break;
+            }
+        }
+
+        bool Mismatch(const pb_Field* Field, int WireType, const pb_Slice* S)
+        {
+            return Fail(FString::Printf(TEXT("type mismatch for field '%s', %s expected for type %s, got %s"),
+                                        UTF8_TO_TCHAR((const char*)Field->name),
+                                        UTF8_TO_TCHAR(pb_wtypename(pb_wtypebytype(Field->type_id), "?")),
+                                        UTF8_TO_TCHAR(pb_typename(Field->type_id, "?")),
+                                        UTF8_TO_TCHAR(pb_wtypename(WireType, "?"))), S);
+        }
+
+        bool Fail(const FString& Message, const pb_Slice* S)
+        {
+            Error = FString::Printf(TEXT("%s at offset %d"), *Message, (int32)pb_pos(*S) + 1);
+            return false;
+        }
+    };
+
+    class FEncoder
+    {
+    public:
+        explicit FEncoder(pb_Buffer* InBuffer) : Buffer(InBuffer) {}
+
+        FString Error;
+
+        bool EncodeMessage(const FMessageBinding& Binding, const void* Data)
+        {
+            for (const FFieldBinding& Field : Binding.Fields)
+            {
+                const void* ValuePtr = Field.Property->ContainerPtrToValuePtr<void>(Data);
+                const int32_t Number = Field.Field->number;
+                const int WireType = pb_wtypebytype(Field.Field->type_id);
+                switch (Field.Container)
+                {
+                case EContainerKind::Single:
+                    // proto3的标量字段取默认值时不编码
+                    if (Binding.Type->is_proto3 && !Field.Field->oneof_idx && Field.Value.Kind != EValueKind::Message
+                        && Field.Property->Identical(ValuePtr, nullptr))
+                        break;
+                    pb_addvarint32(Buffer, pb_pair(Number, WireType));
+                    if (!WriteValue(Field.Value, ValuePtr))
+                        return false;
+                    break;
+
+                case EContainerKind::Array:
+                {
+                    FScriptArrayHelper Helper(CastFieldChecked<FArrayProperty>(Field.Property), ValuePtr);
+                    if (!WriteRepeated(Field, Helper.Num(), [&Helper](int32 Index) { return Helper.GetRawPtr(Index); }))
+                        return false;
+                    break;
+                }
+
+                case EContainerKind::Set:
+                {
+                    FScriptSetHelper Helper(CastFieldChecked<FSetProperty>(Field.Property), ValuePtr);
+                    TArray<const void*, TInlineAllocator<16>> Elements;
+                    for (int32 Index = 0, Count = Helper.Num(); Count > 0; ++Index)
+                    {
+                        if (!Helper.IsValidIndex(Index))
+                            continue;
+                        Elements.Add(Helper.GetElementPtr(Index));
+                        --Count;
+                    }
+                    if (!WriteRepeated(Field, Elements.Num(), [&Elements](int32 Index) { return Elements[Index]; }))
+                        return false;
+                    break;
+                }
+
+                case EContainerKind::Map:
+                {
+                    FScriptMapHelper Helper(CastFieldChecked<FMapProperty>(Field.Property), ValuePtr);
+                    for (int32 Index = 0, Count = Helper.Num(); Count > 0; ++Index)
+                    {
+                        if (!Helper.IsValidIndex(Index))
+                            continue;
+                        --Count;
+                        pb_addvarint32(Buffer, pb_pair(Number, PB_TBYTES));
+                        const size_t Length = pb_bufflen(Buffer);
+                        pb_addvarint32(Buffer, pb_pair(1, pb_wtypebytype(Field.Key.Field->type_id)));
+                        if (!WriteValue(Field.Key, Helper.GetKeyPtr(Index)))
+                            return false;
+                        pb_addvarint32(Buffer, pb_pair(2, pb_wtypebytype(Field.Value.Field->type_id)));
+                        if (!WriteValue(Field.Value, Helper.GetValuePtr(Index)))
+                            return false;
+                        pb_addlength(Buffer, Length);
+                    }
+                    break;
+                }
+                }
+            }
+            return true;
+        }
+
+    private:
+        template <typename TGetElement>
+        bool WriteRepeated(const FFieldBinding& Field, int32 Num, TGetElement GetElement)
+        {
+            if (Num == 0)
+                return true;
+
+            const int32_t Number = Field.Field->number;
+            const int WireType = pb_wtypebytype(Field.Field->type_id);
+            if (Field.Field->packed && WireType != PB_TBYTES)
+            {
+                pb_addvarint32(Buffer, pb_pair(Number, PB_TBYTES));
+                const size_t Length = pb_bufflen(Buffer);
+                for (int32 Index = 0; Index < Num; ++Index)
+                {
+                    if (!WriteValue(Field.Value, GetElement(Index)))
+                        return false;
+                }
+                pb_addlength(Buffer, Length);
+                return true;
+            }
+
+            for (int32 Index = 0; Index < Num; ++Index)
+            {
+                pb_addvarint32(Buffer, pb_pair(Number, WireType));
+                if (!WriteValue(Field.Value, GetElement(Index)))
+                    return false;
+            }
+            return true;
+        }
+
+        bool WriteValue(const FValueBinding& Value, const void* ValuePtr)
+        {
+            const int TypeId = Value.Field->type_id;
+            switch (Value.Kind)
+            {
+            case EValueKind::Message:
+            {
+                const size_t Length = pb_bufflen(Buffer);
+                if (!EncodeMessage(*Value.Message, ValuePtr))
+                    return false;
+                pb_addlength(Buffer, Length);
+                return true;
+            }
+
+            case EValueKind::Bytes:
+            {
+                FScriptArrayHelper Helper(CastFieldChecked<FArrayProperty>(Value.Property), ValuePtr);
+                const int32 Num = Helper.Num();
+                pb_addbytes(Buffer, pb_lslice(Num > 0 ? (const char*)Helper.GetRawPtr(0) : "", Num));
+                return true;
+            }
+
+            case EValueKind::String:
+            case EValueKind::Name:
+            case EValueKind::Text:
+            {
+                const FString String = ReadString(Value, ValuePtr);
+                if (TypeId == PB_Tenum)
+                {
+                    const int32* EnumValue = Value.EnumValues.Find(FName(*String));
+                    if (!EnumValue)
+                    {
+                        Error = FString::Printf(TEXT("can not encode unknown enum '%s' at field '%s'"), *String, UTF8_TO_TCHAR((const char*)Value.Field->name));
+                        return false;
+                    }
+                    pb_addvarint64(Buffer, (uint64_t)(int64)*EnumValue);
+                    return true;
+                }
+                const FTCHARToUTF8 Converted(*String);
+                pb_addbytes(Buffer, pb_lslice(Converted.Get(), Converted.Length()));
+                return true;
+            }
+
+            case EValueKind::Bool:
+            {
+                FScalar Scalar;
+                Scalar.Int = CastFieldChecked<FBoolProperty>(Value.Property)->GetPropertyValue(ValuePtr) ? 1 : 0;
+                WriteScalar(TypeId, Scalar);
+                return true;
+            }
+
+            default:
+            {
+                FScalar Scalar;
+                const FNumericProperty* NumericProperty = GetNumericProperty(Value.Property);
+                if (NumericProperty->IsFloatingPoint())
+                {
+                    Scalar.bFloat = true;
+                    Scalar.Float = NumericProperty->GetFloatingPointPropertyValue(ValuePtr);
+                }
+                else if (CastField<FUInt64Property>(NumericProperty))
+                {
+                    Scalar.bUnsigned = true;
+                    Scalar.Int = (int64)NumericProperty->GetUnsignedIntPropertyValue(ValuePtr);
+                }
+                else
+                {
+                    Scalar.Int = NumericProperty->GetSignedIntPropertyValue(ValuePtr);
+                }
+                WriteScalar(TypeId, Scalar);
+                return true;
+            }
+            }
+        }
+
+        void WriteScalar(int TypeId, const FScalar& Scalar)
+        {
+            const int64 Int = Scalar.AsInt();
+            switch (TypeId)
+            {
+            case PB_Tdouble:
+                pb_addfixed64(Buffer, pb_encode_double(Scalar.AsFloat()));
+                break;
+            case PB_Tfloat:
+                pb_addfixed32(Buffer, pb_encode_float((float)Scalar.AsFloat()));
+                break;
+            case PB_Tfixed32:
+            case PB_Tsfixed32:
+                pb_addfixed32(Buffer, (uint32_t)Int);
+                break;
+            case PB_Tfixed64:
+            case PB_Tsfixed64:
+                pb_addfixed64(Buffer, (uint64_t)Int);
+                break;
+            case PB_Tuint32:
+                pb_addvarint32(Buffer, (uint32_t)Int);
+                break;
+            case PB_Tsint32:
+                pb_addvarint32(Buffer, pb_encode_sint32((int32_t)Int));
+                break;
+            case PB_Tsint64:
+                pb_addvarint64(Buffer, pb_encode_sint64(Int));
+                break;
+            case PB_Tbool:
+                pb_addvarint32(Buffer, Scalar.bFloat ? Scalar.Float != 0 : Int != 0);
+                break;
+            default:
+                // int32/enum为负数时按64位符号扩展编码，与pb.cpp一致
+                pb_addvarint64(Buffer, (uint64_t)Int);
+                break;
+            }
+        }
+
+        static FString ReadString(const FValueBinding& Value, const void* ValuePtr)
+        {
+            switch (Value.Kind)
+            {
+            case EValueKind::String:
+                return CastFieldChecked<FStrProperty>(Value.Property)->GetPropertyValue(ValuePtr);
+            case EValueKind::Name:
+                return CastFieldChecked<FNameProperty>(Value.Property)->GetPropertyValue(ValuePtr).ToString();
+            case EValueKind::Text:
+                return CastFieldChecked<FTextProperty>(Value.Property)->GetPropertyValue(ValuePtr).ToString();
+            default:
+                return FString();
+            }
+        }
+
+        pb_Buffer* Buffer;
+    };
+
+    static bool Encode(lua_State* L, const char* TypeName, const UScriptStruct* Struct, const void* StructData, pb_Buffer* Buffer, FString& OutError)
+    {
+        const FMessageBinding* Binding = FindBinding(L, TypeName, Struct, OutError);
+        if (!Binding)
+            return false;
+
+        FEncoder Encoder(Buffer);
+        if (Encoder.EncodeMessage(*Binding, StructData))
+            return true;
+        OutError = Encoder.Error;
+        return false;
+    }
+
+    bool DecodeStruct(lua_State* L, const char* TypeName, const char* Data, size_t Size, const UScriptStruct* Struct, void* StructData, bool bMerge, FString& OutError)
+    {
+        if (!Struct || !StructData)
+        {
+            OutError = TEXT("invalid struct");
+            return false;
+        }
+
+        const FMessageBinding* Binding = FindBinding(L, TypeName, Struct, OutError);
+        if (!Binding)
+            return false;
+
+        FDecoder Decoder;
+        pb_Slice Slice = pb_lslice(Data, Size);
+        if (Decoder.DecodeMessage(*Binding, &Slice, StructData, bMerge))
+            return true;
+        OutError = Decoder.Error;
+        return false;
+    }
+
+    bool EncodeStruct(lua_State* L, const char* TypeName, const UScriptStruct* Struct, const void* StructData, TArray<uint8>& OutBytes, FString& OutError)
+    {
+        if (!Struct || !StructData)
+        {
+            OutError = TEXT("invalid struct");
+            return false;
+        }
+
+        pb_Buffer Buffer;
+        pb_initbuffer(&Buffer);
+        const bool bOk = Encode(L, TypeName, Struct, StructData, &Buffer, OutError);
+        if (bOk)
+            OutBytes.Append((const uint8*)pb_buffer(&Buffer), pb_bufflen(&Buffer));
+        pb_resetbuffer(&Buffer);
+        return bOk;
+    }
+
+    /**
+     * 取得Lua栈上结构体userdata的类型与内存地址
+     */
+    static bool GetStruct(lua_State* L, int Index, const UScriptStruct*& OutStruct, void*& OutData)
+    {
+        if (lua_type(L, Index) != LUA_TUSERDATA || !lua_getmetatable(L, Index))
+            return false;
+
+        lua_pushstring(L, "TypeHash");
+        lua_rawget(L, -2);
+        const UStruct* Type = lua_type(L, -1) == LUA_TNUMBER ? (const UStruct*)(uint64)lua_tonumber(L, -1) : nullptr;
+        lua_pop(L, 2);
+
+        OutStruct = Cast<UScriptStruct>(const_cast<UStruct*>(Type));
+        OutData = OutStruct ? GetCppInstanceFast(L, Index) : nullptr;
+        return OutData != nullptr;
+    }
+
+    /* pb.decode_struct(type, data, struct [, merge]) */
+    static int Lpb_decode_struct(lua_State* L)
+    {
+        size_t Size = 0;
+        const char* TypeName = luaL_checkstring(L, 1);
+        const char* Data = luaL_checklstring(L, 2, &Size);
+        const UScriptStruct* Struct;
+        void* StructData;
+        if (!GetStruct(L, 3, Struct, StructData))
+            return luaL_argerror(L, 3, "struct expected");
+
+        bool bOk;
+        {
+            FString Error;
+            bOk = DecodeStruct(L, TypeName, Data, Size, Struct, StructData, lua_toboolean(L, 4) != 0, Error);
+            if (!bOk)
+                lua_pushstring(L, TCHAR_TO_UTF8(*Error));
+        }
+        if (!bOk)
+            return lua_error(L);
+
+        lua_settop(L, 3);
+        return 1;
+    }
+
+    /* pb.encode_struct(type, struct) */
+    static int Lpb_encode_struct(lua_State* L)
+    {
+        const char* TypeName = luaL_checkstring(L, 1);
+        const UScriptStruct* Struct;
+        void* StructData;
+        if (!GetStruct(L, 2, Struct, StructData))
+            return luaL_argerror(L, 2, "struct expected");
+
+        pb_Buffer Buffer;
+        pb_initbuffer(&Buffer);
+        bool bOk;
+        {
+            FString Error;
+            bOk = Encode(L, TypeName, Struct, StructData, &Buffer, Error);
+            if (bOk)
+                lua_pushlstring(L, pb_buffer(&Buffer), pb_bufflen(&Buffer));
+            else
+                lua_pushstring(L, TCHAR_TO_UTF8(*Error));
+        }
+        pb_resetbuffer(&Buffer);
+        return bOk ? 1 : lua_error(L);
+    }
+
+    /* 类型信息可能被替换的接口，调用后让当前虚拟机上已有的绑定失效 */
+    static int Lpb_schema_changed(lua_State* L)
+    {
+        lua_pushvalue(L, lua_upvalueindex(1));
+        lua_insert(L, 1);
+        lua_call(L, lua_gettop(L) - 1, LUA_MULTRET);
+        GetBindingCache(L).Bindings.Reset();
+        return lua_gettop(L);
+    }
+
+    int Open(lua_State* L)
+    {
+        luaopen_pb(L);
+
+        static const char* SchemaFunctions[] = {"load", "loadfile", "clear", "state"};
+        for (const char* Name : SchemaFunctions)
+        {
+            lua_getfield(L, -1, Name);
+            lua_pushcclosure(L, Lpb_schema_changed, 1);
+            lua_setfield(L, -2, Name);
+        }
+
+        lua_pushcfunction(L, Lpb_decode_struct);
+        lua_setfield(L, -2, "decode_struct");
+        lua_pushcfunction(L, Lpb_encode_struct);
+        lua_setfield(L, -2, "encode_struct");
+        return 1;
+    }
+}
@@ -0,0 +1,45 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+//
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License");
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct lua_State;
+
+namespace LuaProtobuf
+{
+    /**
+     * 把protobuf二进制直接解码到结构体内存，不经过中间的Lua表
+     *
+     * @param L - 加载了pb类型的Lua虚拟机（类型信息保存在各自的pb.State中）
+     * @param TypeName - pb消息类型名，如 ".game.MatchState"
+     * @param Data - 二进制数据
+     * @param Size - 数据长度
+     * @param Struct - 目标结构体类型，首次使用时与pb类型绑定并缓存
+     * @param StructData - 目标结构体内存
+     * @param bMerge - true时保留未出现的字段并追加repeated字段（MergeFrom语义），否则先重置已绑定的字段
+     * @param OutError - 失败时的错误信息
+     * @return - 成功返回true
+     */
+    LUAPROTOBUF_API bool DecodeStruct(lua_State* L, const char* TypeName, const char* Data, size_t Size, const UScriptStruct* Struct, void* StructData, bool bMerge, FString& OutError);
+
+    /**
+     * 把结构体内存直接编码为protobuf二进制
+     */
+    LUAPROTOBUF_API bool EncodeStruct(lua_State* L, const char* TypeName, const UScriptStruct* Struct, const void* StructData, TArray<uint8>& OutBytes, FString& OutError);
+
+    /* luaopen_pb，并增加 pb.decode_struct / pb.encode_struct */
+    int Open(lua_State* L);
+}
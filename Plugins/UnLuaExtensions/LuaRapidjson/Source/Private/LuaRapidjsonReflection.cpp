@@ -0,0 +1,1059 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+//
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License");
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+
+#include "LuaRapidjsonReflection.h"
+#include "LuaCore.h"
+#include "UnLuaBase.h"
+#include "ReflectionUtils/PropertyDesc.h"
+#include "UObject/EnumProperty.h"
+#include "UObject/TextProperty.h"
+#include "UObject/SoftObjectPtr.h"
+#include "Misc/EngineVersionComparison.h"
+
+#include "rapidjson/reader.h"
+#include "rapidjson/writer.h"
+#include "rapidjson/prettywriter.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/error/en.h"
+#include "StringStream.hpp"
+#include "luax.hpp"
+
+namespace LuaRapidjson
+{
+    struct FJsonField
+    {
+        FProperty* Property;
+        FName Name;
+        TArray<ANSICHAR> Utf8Name;
+        bool bEncode;
+    };
+
+    /* 每个UStruct只生成一次的字段表，字段名预先转好UTF-8，编码时不再逐个转换 */
+    struct FJsonStructLayout
+    {
+        TWeakObjectPtr<UStruct> Struct;
+        TArray<FJsonField> Fields;
+        TMap<FName, int32> NameToField;
+
+        const FJsonField* Find(const char* Key, rapidjson::SizeType Length) const
+        {
+            // 只查找不创建，未知的键不会污染FName表
+            const FName Name(static_cast<int32>(Length), Key, FNAME_Find);
+            if (Name.IsNone())
+                return nullptr;
+            const int32* Index = NameToField.Find(Name);
+            return Index ? &Fields[*Index] : nullptr;
+        }
+    };
+
+    static TMap<const UStruct*, TUniquePtr<FJsonStructLayout>> Layouts;
+
+    static bool IsSupported(const FProperty* Property)
+    {
+        switch (GetPropertyType(Property))
+        {
+        case CPT_Byte:
+        case CPT_Int8:
+        case CPT_Int16:
+        case CPT_Int:
+        case CPT_Int64:
+        case CPT_UInt16:
+        case CPT_UInt32:
+        case CPT_UInt64:
+        case CPT_Float:
+        case CPT_Double:
+        case CPT_Enum:
+        case CPT_Bool:
+        case CPT_ObjectReference:
+        case CPT_WeakObjectReference:
+        case CPT_LazyObjectReference:
+        case CPT_SoftObjectReference:
+        case CPT_Name:
+        case CPT_String:
+        case CPT_Text:
+        case CPT_Array:
+        case CPT_Map:
+        case CPT_Set:
+        case CPT_Struct:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    /* 与FClassDesc::RegisterField保持一致，蓝图结构体的字段名去掉 _序号_GUID 后缀 */
+    static FString GetFieldName(const UStruct* Struct, const FProperty* Property)
+    {
+        FString Name = Property->GetName();
+        if (Struct->IsNative() || !Struct->IsA<UScriptStruct>())
+            return Name;
+
+        const int32 GuidStrLen = 32;
+        const int32 MinimalPostfixlen = GuidStrLen + 3;
+        if (Name.Len() > MinimalPostfixlen)
+        {
+            Name = Name.LeftChop(GuidStrLen + 1);
+            int32 FirstCharToRemove = INDEX_NONE;
+            if (Name.FindLastChar(TCHAR('_'), FirstCharToRemove))
+                Name = Name.Mid(0, FirstCharToRemove);
+        }
+        return Name;
+    }
+
+    static TUniquePtr<FJsonStructLayout> BuildLayout(const UStruct* Struct)
+    {
+        TUniquePtr<FJsonStructLayout> Layout = MakeUnique<FJsonStructLayout>();
+        Layout->Struct = const_cast<UStruct*>(Struct);
+        for (TFieldIterator<FProperty> It(Struct, EFieldIteratorFlags::IncludeSuper, EFieldIteratorFlags::ExcludeDeprecated); It; ++It)
+        {
+            FProperty* Property = *It;
+            if (!IsSupported(Property))
+                continue;
+
+            const FString Name = GetFieldName(Struct, Property);
+            const FTCHARToUTF8 Utf8Name(*Name);
+            FJsonField Field;
+            Field.Property = Property;
+            Field.Name = FName(*Name);
+            Field.Utf8Name.Append(Utf8Name.Get(), Utf8Name.Length());
+            Field.bEncode = !Property->HasAnyPropertyFlags(CPF_Transient);
+            Layout->NameToField.Add(Field.Name, Layout->Fields.Add(MoveTemp(Field)));
+        }
+        return Layout;
+    }
+
+    /**
+     * 原生类型的字段表全局缓存。编辑器下蓝图结构体和蓝图类会就地重新编译并销毁旧的FProperty，它们的字段表只在单次编解码内复用
+     */
+    class FJsonLayoutCache
+    {
+    public:
+        const FJsonStructLayout* Get(const UStruct* Struct)
+        {
+#if WITH_EDITOR
+            if (!Struct->IsNative())
+            {
+                TUniquePtr<FJsonStructLayout>& Layout = Transient.FindOrAdd(Struct);
+                if (!Layout.IsValid())
+                    Layout = BuildLayout(Struct);
+                return Layout.Get();
+            }
+#endif
+            TUniquePtr<FJsonStructLayout>& Layout = Layouts.FindOrAdd(Struct);
+            if (!Layout.IsValid() || Layout->Struct.Get() != Struct)
+                Layout = BuildLayout(Struct);
+            return Layout.Get();
+        }
+
+    private:
+        TMap<const UStruct*, TUniquePtr<FJsonStructLayout>> Transient;
+    };
+
+    static const FNumericProperty* GetNumericProperty(const FProperty* Property)
+    {
+        if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+            return EnumProperty->GetUnderlyingProperty();
+        return CastField<FNumericProperty>(Property);
+    }
+
+    static const UEnum* GetEnum(const FProperty* Property)
+    {
+        if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+            return EnumProperty->GetEnum();
+        if (const FByteProperty* ByteProperty = CastField<FByteProperty>(Property))
+            return ByteProperty->Enum;
+        return nullptr;
+    }
+
+    static bool IsUnsigned(const FNumericProperty* Property)
+    {
+        return CastField<FByteProperty>(Property)
+            || CastField<FUInt16Property>(Property)
+            || CastField<FUInt32Property>(Property)
+            || CastField<FUInt64Property>(Property);
+    }
+
+    /* 整数属性能否表示这个值，超出范围时报错而不是截断 */
+    static bool CanHold(const FNumericProperty* Property, const int64 Value)
+    {
+        const int32 Bits = Property->ElementSize * 8;
+        if (IsUnsigned(Property))
+            return Value >= 0 && (Bits >= 64 || Value < (int64(1) << Bits));
+        return Bits >= 64 || (Value >= -(int64(1) << (Bits - 1)) && Value < (int64(1) << (Bits - 1)));
+    }
+
+    static bool CanHold(const FNumericProperty* Property, const uint64 Value)
+    {
+        const int32 Bits = Property->ElementSize * 8 - (IsUnsigned(Property) ? 0 : 1);
+        return Bits >= 64 || Value < (uint64(1) << Bits);
+    }
+
+    /**
+     * JSON里重复的键以最后一个为准，调用前需要先Rehash
+     */
+    template <typename THelper, typename TGetKey>
+    static void RemoveDuplicates(THelper& Helper, const FProperty* KeyProperty, TGetKey GetKey)
+    {
+        if (Helper.Num() < 2)
+            return;
+
+        TMultiMap<uint32, int32> Visited;
+        TArray<int32, TInlineAllocator<4>> Candidates;
+        for (int32 Index = 0, Count = Helper.Num(); Count > 0; ++Index)
+        {
+            if (!Helper.IsValidIndex(Index))
+                continue;
+            --Count;
+
+            const uint32 Hash = KeyProperty->GetValueTypeHash(GetKey(Index));
+            Candidates.Reset();
+            Visited.MultiFind(Hash, Candidates);
+            for (const int32 Other : Candidates)
+            {
+                if (KeyProperty->Identical(GetKey(Other), GetKey(Index)))
+                {
+                    Visited.RemoveSingle(Hash, Other);
+                    Helper.RemoveAt(Other);
+                    break;
+                }
+            }
+            Visited.Add(Hash, Index);
+        }
+    }
+
+    /**
+     * Handle json SAX events and write them into reflected memory.
+     */
+    class FToPropertyHandler
+    {
+    public:
+        FToPropertyHandler(const UStruct* InRootType, void* InRootData)
+            : RootType(InRootType), RootData(InRootData)
+        {
+            // 解码期间只写入字段的暂存副本，全部成功后才写回目标，失败时目标保持原样
+            RootLayout = LayoutCache.Get(RootType);
+            StagedData = FMemory::Malloc(RootType->GetPropertiesSize(), RootType->GetMinAlignment());
+            FMemory::Memzero(StagedData, RootType->GetPropertiesSize());
+            Staged.Init(false, RootLayout->Fields.Num());
+        }
+
+        ~FToPropertyHandler()
+        {
+            for (TConstSetBitIterator<> It(Staged); It; ++It)
+                RootLayout->Fields[It.GetIndex()].Property->DestroyValue_InContainer(StagedData);
+            FMemory::Free(StagedData);
+        }
+
+        void Commit()
+        {
+            for (TConstSetBitIterator<> It(Staged); It; ++It)
+                RootLayout->Fields[It.GetIndex()].Property->CopyCompleteValue_InContainer(RootData, StagedData);
+        }
+
+        bool Null()
+        {
+            FProperty* Property;
+            void* ValuePtr;
+            if (!Next(Property, ValuePtr))
+                return !Error.Len();
+            Property->ClearValue(ValuePtr);
+            return true;
+        }
+
+        bool Bool(bool b)
+        {
+            FProperty* Property;
+            void* ValuePtr;
+            if (!Next(Property, ValuePtr))
+                return !Error.Len();
+            const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property);
+            if (!BoolProperty)
+                return Mismatch(Property, TEXT("boolean"));
+            BoolProperty->SetPropertyValue(ValuePtr, b);
+            return true;
+        }
+
+        bool Int(int i) { return Integer(i); }
+        bool Uint(unsigned u) { return Integer(u); }
+        bool Int64(int64_t i) { return Integer(i); }
+
+        bool Uint64(uint64_t u)
+        {
+            FProperty* Property;
+            void* ValuePtr;
+            if (!Next(Property, ValuePtr))
+                return !Error.Len();
+            const FNumericProperty* NumericProperty = GetNumericProperty(Property);
+            if (!NumericProperty)
+                return Mismatch(Property, TEXT("number"));
+            if (NumericProperty->IsFloatingPoint())
+                NumericProperty->SetFloatingPointPropertyValue(ValuePtr, static_cast<double>(u));
+            else if (CanHold(NumericProperty, static_cast<uint64>(u)))
+                NumericProperty->SetIntPropertyValue(ValuePtr, static_cast<uint64>(u));
+            else
+                return OutOfRange(Property);
+            return true;
+        }
+
+        bool Double(double d)
+        {
+            FProperty* Property;
+            void* ValuePtr;
+            if (!Next(Property, ValuePtr))
+                return !Error.Len();
+            const FNumericProperty* NumericProperty = GetNumericProperty(Property);
+            if (!NumericProperty)
+                return Mismatch(Property, TEXT("number"));
+            if (NumericProperty->IsFloatingPoint())
+            {
+                NumericProperty->SetFloatingPointPropertyValue(ValuePtr, d);
+                return true;
+            }
+
+            // NaN或超出64位整数范围的浮点数转换为整数是未定义行为，先检查范围
+            if (!(d >= -9223372036854775808.0 && d < 18446744073709551616.0))
+                return OutOfRange(Property);
+            if (d < 0)
+            {
+                const int64 Value = static_cast<int64>(d);
+                if (!CanHold(NumericProperty, Value))
+                    return OutOfRange(Property);
+                NumericProperty->SetIntPropertyValue(ValuePtr, Value);
+            }
+            else
+            {
+                const uint64 Value = static_cast<uint64>(d);
+                if (!CanHold(NumericProperty, Value))
+                    return OutOfRange(Property);
+                NumericProperty->SetIntPropertyValue(ValuePtr, Value);
+            }
+            return true;
+        }
+
+        bool String(const char* Str, rapidjson::SizeType Length, bool)
+        {
+            FProperty* Property;
+            void* ValuePtr;
+            if (!Next(Property, ValuePtr))
+                return !Error.Len();
+            return ImportString(Property, ValuePtr, Str, Length, false);
+        }
+
+        bool Key(const char* Str, rapidjson::SizeType Length, bool)
+        {
+            FFrame& Frame = Stack.Last();
+            if (Frame.Kind == EKind::Struct)
+            {
+                Frame.Pending = Frame.Layout->Find(Str, Length);
+            }
+            else if (Frame.Kind == EKind::Map)
+            {
+                PendingKey.Reset();
+                PendingKey.Append(Str, Length);
+            }
+            return true;
+        }
+
+        bool StartObject()
+        {
+            if (Stack.Num() == 0)
+            {
+                Stack.Add(FFrame::MakeStruct(RootLayout, StagedData));
+                return true;
+            }
+
+            FProperty* Property;
+            void* ValuePtr;
+            if (!Next(Property, ValuePtr))
+            {
+                if (Error.Len())
+                    return false;
+                Stack.Add(FFrame::MakeSkip());
+                return true;
+            }
+
+            if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+            {
+                Stack.Add(FFrame::MakeStruct(LayoutCache.Get(StructProperty->Struct), ValuePtr));
+                return true;
+            }
+
+            if (FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+            {
+                FScriptMapHelper(MapProperty, ValuePtr).EmptyValues();
+                FFrame Frame(EKind::Map, ValuePtr);
+                Frame.Container = MapProperty;
+                Stack.Add(Frame);
+                return true;
+            }
+
+            return Mismatch(Property, TEXT("object"));
+        }
+
+        bool EndObject(rapidjson::SizeType)
+        {
+            const FFrame Frame = Stack.Pop();
+            if (Frame.Kind == EKind::Map)
+            {
+                FMapProperty* MapProperty = CastFieldChecked<FMapProperty>(Frame.Container);
+                FScriptMapHelper Helper(MapProperty, Frame.Data);
+                Helper.Rehash();
+                RemoveDuplicates(Helper, MapProperty->KeyProp, [&Helper](int32 Index) { return Helper.GetKeyPtr(Index); });
+            }
+            return true;
+        }
+
+        bool StartArray()
+        {
+            if (Stack.Num() == 0)
+                return Fail(TEXT("root value must be an object"));
+
+            // 只有结构体字段本身才可能是静态数组，静态数组的元素不能再展开
+            const bool bStructField = Stack.Last().Kind == EKind::Struct;
+            FProperty* Property;
+            void* ValuePtr;
+            if (!Next(Property, ValuePtr, bStructField))
+            {
+                if (Error.Len())
+                    return false;
+                Stack.Add(FFrame::MakeSkip());
+                return true;
+            }
+
+            FFrame Frame(EKind::Array, ValuePtr);
+            Frame.Container = Property;
+            if (bStructField && Property->ArrayDim > 1)
+            {
+                Frame.Kind = EKind::StaticArray;
+            }
+            else if (FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+            {
+                FScriptArrayHelper(ArrayProperty, ValuePtr).EmptyValues();
+            }
+            else if (FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+            {
+                FScriptSetHelper(SetProperty, ValuePtr).EmptyElements();
+                Frame.Kind = EKind::Set;
+            }
+            else
+            {
+                return Mismatch(Property, TEXT("array"));
+            }
+            Stack.Add(Frame);
+            return true;
+        }
+
+        bool EndArray(rapidjson::SizeType)
+        {
+            const FFrame Frame = Stack.Pop();
+            if (Frame.Kind == EKind::Set)
+            {
+                FSetProperty* SetProperty = CastFieldChecked<FSetProperty>(Frame.Container);
+                FScriptSetHelper Helper(SetProperty, Frame.Data);
+                Helper.Rehash();
+                RemoveDuplicates(Helper, SetProperty->ElementProp, [&Helper](int32 Index) { return Helper.GetElementPtr(Index); });
+            }
+            return true;
+        }
+
+        FString Error;
+
+    private:
+        enum class EKind : uint8
+        {
+            Struct,
+            Array,
+            StaticArray,
+            Set,
+            Map,
+            Skip,
+        };
+
+        struct FFrame
+        {
+            EKind Kind;
+            void* Data;
+            const FJsonStructLayout* Layout = nullptr;
+            FProperty* Container = nullptr;
+            const FJsonField* Pending = nullptr;
+            int32 Index = 0;
+            int32 Depth = 0;
+
+            FFrame(EKind InKind, void* InData) : Kind(InKind), Data(InData) {}
+
+            static FFrame MakeStruct(const FJsonStructLayout* Layout, void* Data)
+            {
+                FFrame Frame(EKind::Struct, Data);
+                Frame.Layout = Layout;
+                return Frame;
+            }
+
+            static FFrame MakeSkip()
+            {
+                FFrame Frame(EKind::Skip, nullptr);
+                Frame.Depth = 1;
+                return Frame;
+            }
+        };
+
+        template <typename T>
+        bool Integer(T Value)
+        {
+            FProperty* Property;
+            void* ValuePtr;
+            if (!Next(Property, ValuePtr))
+                return !Error.Len();
+            const FNumericProperty* NumericProperty = GetNumericProperty(Property);
+            if (!NumericProperty)
+                return Mismatch(Property, TEXT("number"));
+            if (NumericProperty->IsFloatingPoint())
+                NumericProperty->SetFloatingPointPropertyValue(ValuePtr, static_cast<double>(Value));
+            else if (CanHold(NumericProperty, static_cast<int64>(Value)))
+                NumericProperty->SetIntPropertyValue(ValuePtr, static_cast<int64>(Value));
+            else
+                return OutOfRange(Property);
+            return true;
+        }
+
+        /**
+         * 取得下一个值要写入的属性和地址，返回false表示跳过该值（Error非空时表示出错）
+         */
+        bool Next(FProperty*& OutProperty, void*& OutValuePtr, bool bWholeStaticArray = false)
+        {
+            if (Stack.Num() == 0)
+                return Fail(TEXT("root value must be an object"));
+
+            FFrame& Frame = Stack.Last();
+            switch (Frame.Kind)
+            {
+            case EKind::Struct:
+                if (!Frame.Pending)
+                    return false;
+                OutProperty = Frame.Pending->Property;
+                if (Stack.Num() == 1)
+                    Stage(Frame.Pending);
+                Frame.Pending = nullptr;
+                OutValuePtr = OutProperty->ContainerPtrToValuePtr<void>(Frame.Data);
+                // 静态数组只能由JSON数组整体写入，见StartArray
+                if (OutProperty->ArrayDim > 1 && !bWholeStaticArray)
+                    return Fail(FString::Printf(TEXT("array expected for property '%s'"), *OutProperty->GetName()));
+                return true;
+            case EKind::Array:
+            {
+                FArrayProperty* ArrayProperty = CastFieldChecked<FArrayProperty>(Frame.Container);
+                FScriptArrayHelper Helper(ArrayProperty, Frame.Data);
+                OutProperty = ArrayProperty->Inner;
+                OutValuePtr = Helper.GetRawPtr(Helper.AddValue());
+                return true;
+            }
+            case EKind::StaticArray:
+                if (Frame.Index >= Frame.Container->ArrayDim)
+                    return Fail(FString::Printf(TEXT("too many elements for property '%s'"), *Frame.Container->GetName()));
+                OutProperty = Frame.Container;
+                OutValuePtr = (uint8*)Frame.Data + Frame.Container->ElementSize * Frame.Index++;
+                return true;
+            case EKind::Set:
+            {
+                FSetProperty* SetProperty = CastFieldChecked<FSetProperty>(Frame.Container);
+                FScriptSetHelper Helper(SetProperty, Frame.Data);
+                OutProperty = SetProperty->ElementProp;
+                OutValuePtr = Helper.GetElementPtr(Helper.AddDefaultValue_Invalid_NeedsRehash());
+                return true;
+            }
+            case EKind::Map:
+            {
+                FMapProperty* MapProperty = CastFieldChecked<FMapProperty>(Frame.Container);
+                FScriptMapHelper Helper(MapProperty, Frame.Data);
+                const int32 Index = Helper.AddDefaultValue_Invalid_NeedsRehash();
+                if (!ImportString(MapProperty->KeyProp, Helper.GetKeyPtr(Index), PendingKey.GetData(), PendingKey.Num(), true))
+                    return false;
+                OutProperty = MapProperty->ValueProp;
+                OutValuePtr = Helper.GetValuePtr(Index);
+                return true;
+            }
+            case EKind::Skip:
+            default:
+                return false;
+            }
+        }
+
+        bool ImportString(FProperty* Property, void* ValuePtr, const char* Str, int32 Length, bool bIsKey)
+        {
+            const FUTF8ToTCHAR Converted(Str, Length);
+            const FString Value(Converted.Length(), Converted.Get());
+
+            if (const FStrProperty* StrProperty = CastField<FStrProperty>(Property))
+            {
+                StrProperty->SetPropertyValue(ValuePtr, Value);
+                return true;
+            }
+            if (const FNameProperty* NameProperty = CastField<FNameProperty>(Property))
+            {
+                NameProperty->SetPropertyValue(ValuePtr, FName(*Value));
+                return true;
+            }
+            if (const FTextProperty* TextProperty = CastField<FTextProperty>(Property))
+            {
+                TextProperty->SetPropertyValue(ValuePtr, FText::FromString(Value));
+                return true;
+            }
+            if (const FSoftObjectProperty* SoftObjectProperty = CastField<FSoftObjectProperty>(Property))
+            {
+                SoftObjectProperty->SetPropertyValue(ValuePtr, FSoftObjectPtr(FSoftObjectPath(Value)));
+                return true;
+            }
+            if (const FObjectPropertyBase* ObjectProperty = CastField<FObjectPropertyBase>(Property))
+            {
+                // 只解析已加载的对象，不在解码过程中触发同步加载
+                UObject* Object = FSoftObjectPath(Value).ResolveObject();
+                if (Object && !Object->IsA(ObjectProperty->PropertyClass))
+                    return Mismatch(Property, TEXT("object path"));
+                ObjectProperty->SetObjectPropertyValue(ValuePtr, Object);
+                return true;
+            }
+            if (const FNumericProperty* NumericProperty = GetNumericProperty(Property))
+            {
+                if (const UEnum* Enum = GetEnum(Property))
+                {
+                    const int64 EnumValue = Enum->GetValueByNameString(Value);
+                    if (EnumValue != INDEX_NONE)
+                    {
+                        NumericProperty->SetIntPropertyValue(ValuePtr, EnumValue);
+                        return true;
+                    }
+                }
+                // Map的键在JSON里总是字符串
+                if (bIsKey && Value.IsNumeric())
+                {
+                    if (NumericProperty->IsFloatingPoint())
+                    {
+                        NumericProperty->SetFloatingPointPropertyValue(ValuePtr, FCString::Atod(*Value));
+                        return true;
+                    }
+                    const int64 IntValue = FCString::Atoi64(*Value);
+                    if (!CanHold(NumericProperty, IntValue))
+                        return OutOfRange(Property);
+                    NumericProperty->SetIntPropertyValue(ValuePtr, IntValue);
+                    return true;
+                }
+            }
+            return Mismatch(Property, TEXT("string"));
+        }
+
+        bool Mismatch(const FProperty* Property, const TCHAR* JsonType)
+        {
+            return Fail(FString::Printf(TEXT("can't assign %s to property '%s' (%s)"), JsonType, *Property->GetName(), *Property->GetCPPType()));
+        }
+
+        bool OutOfRange(const FProperty* Property)
+        {
+            return Fail(FString::Printf(TEXT("number out of range for property '%s' (%s)"), *Property->GetName(), *Property->GetCPPType()));
+        }
+
+        bool Fail(FString Message)
+        {
+            Error = MoveTemp(Message);
+            return false;
+        }
+
+        /* 根对象的字段第一次被写入时，先从目标复制一份到暂存内存 */
+        void Stage(const FJsonField* Field)
+        {
+            const int32 Index = static_cast<int32>(Field - RootLayout->Fields.GetData());
+            if (Staged[Index])
+                return;
+            Staged[Index] = true;
+            Field->Property->InitializeValue_InContainer(StagedData);
+            Field->Property->CopyCompleteValue_InContainer(StagedData, RootData);
+        }
+
+    public:
+        /* 跳过未知字段里的嵌套对象/数组，只需要维护深度 */
+        bool Skipping()
+        {
+            return Stack.Num() > 0 && Stack.Last().Kind == EKind::Skip;
+        }
+
+        void EnterSkipped() { ++Stack.Last().Depth; }
+
+        void LeaveSkipped()
+        {
+            if (--Stack.Last().Depth == 0)
+                Stack.Pop();
+        }
+
+    private:
+        const UStruct* RootType;
+        void* RootData;
+        FJsonLayoutCache LayoutCache;
+        const FJsonStructLayout* RootLayout;
+        void* StagedData;
+        TBitArray<> Staged;
+        TArray<FFrame, TInlineAllocator<16>> Stack;
+        TArray<char, TInlineAllocator<64>> PendingKey;
+    };
+
+    /**
+     * 过滤被跳过字段下的事件，避免在FToPropertyHandler的每个回调里重复判断
+     */
+    class FSkippingHandler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, FSkippingHandler>
+    {
+    public:
+        explicit FSkippingHandler(FToPropertyHandler& InInner) : Inner(InInner) {}
+
+        bool Default() { return true; }
+
+        bool Null() { return Inner.Skipping() || Inner.Null(); }
+        bool Bool(bool b) { return Inner.Skipping() || Inner.Bool(b); }
+        bool Int(int i) { return Inner.Skipping() || Inner.Int(i); }
+        bool Uint(unsigned u) { return Inner.Skipping() || Inner.Uint(u); }
+        bool Int64(int64_t i) { return Inner.Skipping() || Inner.Int64(i); }
+        bool Uint64(uint64_t u) { return Inner.Skipping() || Inner.Uint64(u); }
+        bool Double(double d) { return Inner.Skipping() || Inner.Double(d); }
+        bool String(const char* Str, rapidjson::SizeType Length, bool bCopy) { return Inner.Skipping() || Inner.String(Str, Length, bCopy); }
+        bool Key(const char* Str, rapidjson::SizeType Length, bool bCopy) { return Inner.Skipping() || Inner.Key(Str, Length, bCopy); }
+
+        bool StartObject()
+        {
+            if (!Inner.Skipping())
+                return Inner.StartObject();
+            Inner.EnterSkipped();
+            return true;
+        }
+
+        bool EndObject(rapidjson::SizeType Count)
+        {
+            if (!Inner.Skipping())
+                return Inner.EndObject(Count);
+            Inner.LeaveSkipped();
+            return true;
+        }
+
+        bool StartArray()
+        {
+            if (!Inner.Skipping())
+                return Inner.StartArray();
+            Inner.EnterSkipped();
+            return true;
+        }
+
+        bool EndArray(rapidjson::SizeType Count)
+        {
+            if (!Inner.Skipping())
+                return Inner.EndArray(Count);
+            Inner.LeaveSkipped();
+            return true;
+        }
+
+    private:
+        FToPropertyHandler& Inner;
+    };
+
+    template <typename TWriter>
+    class TFromPropertyWriter
+    {
+    public:
+        TFromPropertyWriter(TWriter& InWriter, bool bInEnumAsName)
+            : Writer(InWriter), bEnumAsName(bInEnumAsName)
+        {
+        }
+
+        void WriteStruct(const UStruct* Struct, const void* Data)
+        {
+            const FJsonStructLayout* Layout = LayoutCache.Get(Struct);
+            Writer.StartObject();
+            for (const FJsonField& Field : Layout->Fields)
+            {
+                if (!Field.bEncode)
+                    continue;
+                Writer.Key(Field.Utf8Name.GetData(), Field.Utf8Name.Num());
+                WriteProperty(Field.Property, Field.Property->ContainerPtrToValuePtr<void>(const_cast<void*>(Data)));
+            }
+            Writer.EndObject();
+        }
+
+    private:
+        void WriteProperty(const FProperty* Property, const void* ValuePtr)
+        {
+            if (Property->ArrayDim == 1)
+            {
+                WriteValue(Property, ValuePtr);
+                return;
+            }
+
+            Writer.StartArray();
+            for (int32 i = 0; i < Property->ArrayDim; ++i)
+                WriteValue(Property, (const uint8*)ValuePtr + Property->ElementSize * i);
+            Writer.EndArray();
+        }
+
+        void WriteValue(const FProperty* Property, const void* ValuePtr)
+        {
+            if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
+            {
+                Writer.Bool(BoolProperty->GetPropertyValue(ValuePtr));
+                return;
+            }
+
+            if (const FNumericProperty* NumericProperty = GetNumericProperty(Property))
+            {
+                if (bEnumAsName)
+                {
+                    if (const UEnum* Enum = GetEnum(Property))
+                    {
+                        WriteString(Enum->GetNameStringByValue(NumericProperty->GetSignedIntPropertyValue(ValuePtr)));
+                        return;
+                    }
+                }
+                if (NumericProperty->IsFloatingPoint())
+                    Writer.Double(NumericProperty->GetFloatingPointPropertyValue(ValuePtr));
+                else if (CastField<FUInt64Property>(NumericProperty))
+                    Writer.Uint64(NumericProperty->GetUnsignedIntPropertyValue(ValuePtr));
+                else
+                    Writer.Int64(NumericProperty->GetSignedIntPropertyValue(ValuePtr));
+                return;
+            }
+
+            if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+            {
+                WriteStruct(StructProperty->Struct, ValuePtr);
+                return;
+            }
+
+            if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+            {
+                FScriptArrayHelper Helper(ArrayProperty, ValuePtr);
+                Writer.StartArray();
+                for (int32 i = 0; i < Helper.Num(); ++i)
+                    WriteValue(ArrayProperty->Inner, Helper.GetRawPtr(i));
+                Writer.EndArray();
+                return;
+            }
+
+            if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+            {
+                FScriptSetHelper Helper(SetProperty, ValuePtr);
+                Writer.StartArray();
+                for (int32 i = 0, Count = Helper.Num(); Count > 0; ++i)
+                {
+                    if (!Helper.IsValidIndex(i))
+                        continue;
+                    WriteValue(SetProperty->ElementProp, Helper.GetElementPtr(i));
+                    --Count;
+                }
+                Writer.EndArray();
+                return;
+            }
+
+            if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+            {
+                FScriptMapHelper Helper(MapProperty, ValuePtr);
+                Writer.StartObject();
+                for (int32 i = 0, Count = Helper.Num(); Count > 0; ++i)
+                {
+                    if (!Helper.IsValidIndex(i))
+                        continue;
+                    const FTCHARToUTF8 Key(*ExportString(MapProperty->KeyProp, Helper.GetKeyPtr(i)));
+                    Writer.Key(Key.Get(), Key.Length());
+                    WriteValue(MapProperty->ValueProp, Helper.GetValuePtr(i));
+                    --Count;
+                }
+                Writer.EndObject();
+                return;
+            }
+
+            if (const FObjectPropertyBase* ObjectProperty = CastField<FObjectPropertyBase>(Property))
+            {
+                if (const FSoftObjectProperty* SoftObjectProperty = CastField<FSoftObjectProperty>(Property))
+                {
+                    const FSoftObjectPath& Path = SoftObjectProperty->GetPropertyValue(ValuePtr).ToSoftObjectPath();
+                    if (Path.IsNull())
+                        Writer.Null();
+                    else
+                        WriteString(Path.ToString());
+                    return;
+                }
+
+                const UObject* Object = ObjectProperty->GetObjectPropertyValue(ValuePtr);
+                if (Object)
+                    WriteString(Object->GetPathName());
+                else
+                    Writer.Null();
+                return;
+            }
+
+            WriteString(ExportString(Property, ValuePtr));
+        }
+
+        static FString ExportString(const FProperty* Property, const void* ValuePtr)
+        {
+            if (const FStrProperty* StrProperty = CastField<FStrProperty>(Property))
+                return StrProperty->GetPropertyValue(ValuePtr);
+            if (const FNameProperty* NameProperty = CastField<FNameProperty>(Property))
+                return NameProperty->GetPropertyValue(ValuePtr).ToString();
+            if (const FTextProperty* TextProperty = CastField<FTextProperty>(Property))
+                return TextProperty->GetPropertyValue(ValuePtr).ToString();
+            if (const FNumericProperty* NumericProperty = GetNumericProperty(Property))
+            {
+                if (const UEnum* Enum = GetEnum(Property))
+                    return Enum->GetNameStringByValue(NumericProperty->GetSignedIntPropertyValue(ValuePtr));
+                return NumericProperty->GetNumericPropertyValueToString(ValuePtr);
+            }
+
+            FString Result;
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+            Property->ExportTextItem(Result, ValuePtr, nullptr, nullptr, PPF_None);
+#else
+            Property->ExportTextItem_Direct(Result, ValuePtr, nullptr, nullptr, PPF_None);
+#endif
+            return Result;
+        }
+
+        void WriteString(const FString& Value)
+        {
+            const FTCHARToUTF8 Utf8(*Value);
+            Writer.String(Utf8.Get(), Utf8.Length());
+        }
+
+        TWriter& Writer;
+        bool bEnumAsName;
+        FJsonLayoutCache LayoutCache;
+    };
+
+    template <typename TStream>
+    static bool Read(TStream& Stream, const UStruct* Type, void* Data, FString& OutError)
+    {
+        FToPropertyHandler Handler(Type, Data);
+        FSkippingHandler Filter(Handler);
+        rapidjson::Reader Reader;
+        const rapidjson::ParseResult Result = Reader.Parse(Stream, Filter);
+        if (Result)
+        {
+            Handler.Commit();
+            return true;
+        }
+
+        if (Handler.Error.Len())
+            OutError = Handler.Error;
+        else
+            OutError = FString::Printf(TEXT("%s (%d)"), UTF8_TO_TCHAR(rapidjson::GetParseError_En(Result.Code())), (int32)Result.Offset());
+        return false;
+    }
+
+    static void Write(rapidjson::StringBuffer& Buffer, const UStruct* Type, const void* Data, bool bPretty, bool bEnumAsName)
+    {
+        if (bPretty)
+        {
+            rapidjson::PrettyWriter<rapidjson::StringBuffer> Writer(Buffer);
+            TFromPropertyWriter<rapidjson::PrettyWriter<rapidjson::StringBuffer>>(Writer, bEnumAsName).WriteStruct(Type, Data);
+        }
+        else
+        {
+            rapidjson::Writer<rapidjson::StringBuffer> Writer(Buffer);
+            TFromPropertyWriter<rapidjson::Writer<rapidjson::StringBuffer>>(Writer, bEnumAsName).WriteStruct(Type, Data);
+        }
+    }
+
+    bool ReadFromJson(const char* Json, size_t Length, const UStruct* Type, void* Data, FString& OutError)
+    {
+        if (!Type || !Data)
+        {
+            OutError = TEXT("invalid target");
+            return false;
+        }
+        rapidjson::extend::StringStream Stream(Json, Length);
+        return Read(Stream, Type, Data, OutError);
+    }
+
+    bool WriteToJson(const UStruct* Type, const void* Data, FString& OutJson, bool bPretty)
+    {
+        if (!Type || !Data)
+            return false;
+        rapidjson::StringBuffer Buffer;
+        Write(Buffer, Type, Data, bPretty, false);
+        OutJson = UTF8_TO_TCHAR(Buffer.GetString());
+        return true;
+    }
+
+    /**
+     * 取得Lua栈上结构体或UObject的反射类型与内存地址
+     */
+    static bool GetTarget(lua_State* L, int Index, const UStruct*& OutType, void*& OutData)
+    {
+        if (lua_type(L, Index) == LUA_TUSERDATA && lua_getmetatable(L, Index))
+        {
+            lua_pushstring(L, "TypeHash");
+            lua_rawget(L, -2);
+            const UStruct* Type = lua_type(L, -1) == LUA_TNUMBER ? (const UStruct*)(uint64)lua_tonumber(L, -1) : nullptr;
+            lua_pop(L, 2);
+            if (Type && Type->IsA<UScriptStruct>())
+            {
+                OutType = Type;
+                OutData = GetCppInstanceFast(L, Index);
+                return OutData != nullptr;
+            }
+        }
+
+        UObject* Object = UnLua::GetUObject(L, Index);
+        if (!Object)
+            return false;
+        OutType = Object->GetClass();
+        OutData = Object;
+        return true;
+    }
+
+    int DecodeInto(lua_State* L)
+    {
+        size_t Length = 0;
+        const char* Json = luaL_checklstring(L, 1, &Length);
+
+        const UStruct* Type;
+        void* Data;
+        if (!GetTarget(L, 2, Type, Data))
+            return luaL_argerror(L, 2, "required a valid UStruct or UObject");
+
+        FString Error;
+        if (!ReadFromJson(Json, Length, Type, Data, Error))
+        {
+            lua_pushnil(L);
+            lua_pushstring(L, TCHAR_TO_UTF8(*Error));
+            return 2;
+        }
+
+        lua_pushvalue(L, 2);
+        return 1;
+    }
+
+    int EncodeFrom(lua_State* L)
+    {
+        const UStruct* Type;
+        void* Data;
+        if (!GetTarget(L, 1, Type, Data))
+            return luaL_argerror(L, 1, "required a valid UStruct or UObject");
+
+        bool bPretty = false;
+        bool bEnumAsName = false;
+        if (!lua_isnoneornil(L, 2))
+        {
+            luaL_checktype(L, 2, LUA_TTABLE);
+            bPretty = luax::optboolfield(L, 2, "pretty", false);
+            bEnumAsName = luax::optboolfield(L, 2, "enum_as_name", false);
+        }
+
+        rapidjson::StringBuffer Buffer;
+        Write(Buffer, Type, Data, bPretty, bEnumAsName);
+        lua_pushlstring(L, Buffer.GetString(), Buffer.GetSize());
+        return 1;
+    }
+}
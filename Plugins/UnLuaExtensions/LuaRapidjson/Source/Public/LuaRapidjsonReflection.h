@@ -0,0 +1,45 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+//
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License");
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct lua_State;
+
+namespace LuaRapidjson
+{
+    /**
+     * 直接把JSON的SAX事件写入反射内存，不经过中间的Lua表
+     *
+     * @param Json - UTF-8编码的JSON文本
+     * @param Length - 文本长度
+     * @param Type - Data对应的UScriptStruct或UClass
+     * @param Data - 结构体内存或UObject指针
+     * @param OutError - 失败时的错误信息
+     * @return - 成功返回true
+     */
+    LUARAPIDJSON_API bool ReadFromJson(const char* Json, size_t Length, const UStruct* Type, void* Data, FString& OutError);
+
+    /**
+     * 直接从反射内存生成JSON文本，不经过中间的Lua表
+     */
+    LUARAPIDJSON_API bool WriteToJson(const UStruct* Type, const void* Data, FString& OutJson, bool bPretty = false);
+
+    /* rapidjson.decode_into(json, target) */
+    int DecodeInto(lua_State* L);
+
+    /* rapidjson.encode_from(target [, option]) */
+    int EncodeFrom(lua_State* L);
+}
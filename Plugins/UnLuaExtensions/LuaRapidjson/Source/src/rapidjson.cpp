@@ -32,6 +32,7 @@
 #include "luax.hpp"
 #include "file.hpp"
 #include "StringStream.hpp"
+#include "LuaRapidjsonReflection.h"
 
 using namespace rapidjson;
 
@@ -384,6 +385,10 @@ static const luaL_Reg methods[] = {
 	{ "decode", json_decode },
 	{ "encode", json_encode },
 
+	// string <--> UStruct/UObject
+	{ "decode_into", LuaRapidjson::DecodeInto },
+	{ "encode_from", LuaRapidjson::EncodeFrom },
+
 	// file <--> lua table
 	{ "load", json_load },
 	{ "dump", json_dump },
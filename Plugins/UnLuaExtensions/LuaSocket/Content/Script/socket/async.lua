@@ -0,0 +1,112 @@
+-----------------------------------------------------------------------------
+-- Coroutine friendly TCP helpers built on socket.reactor
+--
+-- 所有接口都需要在协程中调用，socket未就绪时挂起当前协程，
+-- 由socket.reactor在引擎Tick中统一轮询后恢复，不会阻塞游戏线程。
+-----------------------------------------------------------------------------
+local socket = require("socket")
+local reactor = require("socket.reactor")
+
+local _M = {}
+
+_M.wait = reactor.wait
+_M.buffer = reactor.buffer
+
+-- 启动一个协程，参数透传给f
+function _M.spawn(f, ...)
+    local co = coroutine.create(f)
+    local ok, err = coroutine.resume(co, ...)
+    if not ok then
+        error(debug.traceback(co, err), 0)
+    end
+    return co
+end
+
+function _M.connect(host, port, timeout)
+    local sock, err = socket.tcp()
+    if not sock then return nil, err end
+    sock:settimeout(0)
+    local ok
+    ok, err = sock:connect(host, port)
+    if not ok and err == "timeout" then
+        ok, err = reactor.wait(sock, "w", timeout)
+        if ok then
+            -- 非阻塞connect完成后再次connect可以取得真正的结果
+            ok, err = sock:connect(host, port)
+            if not ok and err == "already connected" then ok = true end
+        end
+    end
+    if not ok then
+        sock:close()
+        return nil, err
+    end
+    return sock
+end
+
+function _M.listen(host, port, backlog)
+    local server, err = socket.bind(host, port, backlog)
+    if not server then return nil, err end
+    server:settimeout(0)
+    return server
+end
+
+function _M.accept(server, timeout)
+    while true do
+        local client, err = server:accept()
+        if client then
+            client:settimeout(0)
+            return client
+        end
+        if err ~= "timeout" then return nil, err end
+        local ok, werr = reactor.wait(server, "r", timeout)
+        if not ok then return nil, werr end
+    end
+end
+
+function _M.send(sock, data, timeout)
+    local i = 1
+    while true do
+        local last, err, partial = sock:send(data, i)
+        if last then return last end
+        if err ~= "timeout" then return nil, err, partial end
+        i = partial + 1
+        local ok, werr = reactor.wait(sock, "w", timeout)
+        if not ok then return nil, werr, partial end
+    end
+end
+
+-- 收取数据到可复用的buffer中，返回本次收到的字节数
+function _M.receive(sock, buffer, timeout)
+    while true do
+        local n, err = buffer:recv(sock)
+        if n then return n end
+        if err ~= "timeout" then return nil, err end
+        local ok, werr = reactor.wait(sock, "r", timeout)
+        if not ok then return nil, werr end
+    end
+end
+
+function _M.readline(sock, buffer, timeout)
+    while true do
+        local line = buffer:readline()
+        if line then return line end
+        local n, err = _M.receive(sock, buffer, timeout)
+        if not n then return nil, err end
+    end
+end
+
+function _M.read(sock, buffer, count, timeout)
+    while buffer:size() < count do
+        local n, err = _M.receive(sock, buffer, timeout)
+        if not n then return nil, err end
+    end
+    return buffer:read(count)
+end
+
+-- 关闭前先唤醒等待在这个socket上的协程
+function _M.close(sock)
+    reactor.cancel(sock)
+    return sock:close()
+end
+
+return _M
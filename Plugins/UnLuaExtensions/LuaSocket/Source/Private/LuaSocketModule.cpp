@@ -14,6 +14,7 @@
 
 #include "LuaSocketModule.h"
 #include "LuaEnv.h"
+#include "LuaSocketReactor.h"
 #include "luasocket.h"
 #include "mime.h"
 
@@ -33,6 +34,7 @@ void FLuaSocketModule::OnLuaEnvCreated(UnLua::FLuaEnv& Env)
     Env.AddBuiltInLoader(TEXT("socket"), luaopen_socket_core);
     Env.AddBuiltInLoader(TEXT("socket.core"), luaopen_socket_core);
     Env.AddBuiltInLoader(TEXT("mime.core"), luaopen_mime_core);
+    Env.AddBuiltInLoader(TEXT("socket.reactor"), luaopen_socket_reactor);
     Env.DoString("UnLua.PackagePath = UnLua.PackagePath .. ';/Plugins/UnLuaExtensions/LuaSocket/Content/Script/?.lua'");
 }
 
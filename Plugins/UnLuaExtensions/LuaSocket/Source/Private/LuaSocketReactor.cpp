@@ -0,0 +1,829 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+//
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License");
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+
+#include "LuaSocketReactor.h"
+#include "UnLuaBase.h"
+#include "Containers/Ticker.h"
+#include "Misc/EngineVersionComparison.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/AllowWindowsPlatformTypes.h"
+#endif
+#include "luasocket.h"
+#include "auxiliar.h"
+#include "socket.h"
+#include "tcp.h"
+#include "udp.h"
+#if PLATFORM_LINUX || PLATFORM_ANDROID
+#include <sys/epoll.h>
+#define UNLUA_SOCKET_EPOLL 1
+#else
+#define UNLUA_SOCKET_EPOLL 0
+#if !PLATFORM_WINDOWS
+#include <poll.h>
+#endif
+#endif
+#if !PLATFORM_WINDOWS
+#include <fcntl.h>
+#endif
+#if PLATFORM_WINDOWS
+#include "Windows/HideWindowsPlatformTypes.h"
+#endif
+
+namespace UnLuaExtensions
+{
+    namespace LuaSocket
+    {
+        static const char* REACTOR_KEY = "socket.reactor{state}";
+        static const char* BUFFER_METATABLE = "socket.reactor{buffer}";
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+        typedef FTicker FReactorTicker;
+        typedef FDelegateHandle FReactorTickerHandle;
+#else
+        typedef FTSTicker FReactorTicker;
+        typedef FTSTicker::FDelegateHandle FReactorTickerHandle;
+#endif
+
+#if !UNLUA_SOCKET_EPOLL
+#if PLATFORM_WINDOWS
+        typedef WSAPOLLFD FPollFd;
+        static FORCEINLINE int PollSockets(FPollFd* Fds, int32 Num, int TimeoutMs) { return WSAPoll(Fds, (ULONG)Num, TimeoutMs); }
+#else
+        typedef struct pollfd FPollFd;
+        static FORCEINLINE int PollSockets(FPollFd* Fds, int32 Num, int TimeoutMs) { return poll(Fds, (nfds_t)Num, TimeoutMs); }
+#endif
+#endif
+
+        /* 检查socket是否已经被关闭，用于发现没有经过reactor就被关闭的fd */
+        static bool IsSocketClosed(t_socket Socket)
+        {
+#if PLATFORM_WINDOWS
+            int Type;
+            int Length = sizeof(Type);
+            return getsockopt(Socket, SOL_SOCKET, SO_TYPE, (char*)&Type, &Length) == SOCKET_ERROR && WSAGetLastError() == WSAENOTSOCK;
+#else
+            return fcntl(Socket, F_GETFD) < 0 && errno == EBADF;
+#endif
+        }
+
+        class FReactor
+        {
+        public:
+            enum class EWakeReason : uint8
+            {
+                Ready,
+                Timeout,
+                Closed,
+            };
+
+            explicit FReactor(lua_State* InL)
+                : L(InL)
+            {
+#if UNLUA_SOCKET_EPOLL
+                EpollFd = epoll_create1(EPOLL_CLOEXEC);
+                EpollEvents.SetNumUninitialized(64);
+#endif
+                TickerHandle = FReactorTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FReactor::Tick));
+            }
+
+            ~FReactor()
+            {
+                FReactorTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+#if UNLUA_SOCKET_EPOLL
+                if (EpollFd >= 0)
+                    close(EpollFd);
+#endif
+            }
+
+            static FReactor* Get(lua_State* L)
+            {
+                lua_getfield(L, LUA_REGISTRYINDEX, REACTOR_KEY);
+                FReactor** Reactor = (FReactor**)lua_touserdata(L, -1);
+                lua_pop(L, 1);
+                return Reactor ? *Reactor : nullptr;
+            }
+
+            /**
+             * 挂起当前协程，等待socket可读/可写，返回nullptr表示成功
+             */
+            const char* Wait(lua_State* Thread, t_socket Socket, bool bWrite, double Timeout)
+            {
+                FWatch& Watch = Watches.FindOrAdd(Socket);
+                FWaiter& Waiter = bWrite ? Watch.Writer : Watch.Reader;
+                if (Waiter.ThreadRef != LUA_NOREF)
+                    return bWrite ? "socket already has a pending writer" : "socket already has a pending reader";
+
+                lua_pushthread(Thread);
+                Waiter.ThreadRef = luaL_ref(Thread, LUA_REGISTRYINDEX);
+                Waiter.Deadline = Timeout >= 0 ? FPlatformTime::Seconds() + Timeout : 0;
+
+                const int Error = Sync(Socket, Watch);
+                if (Error == 0)
+                    return nullptr;
+
+                luaL_unref(Thread, LUA_REGISTRYINDEX, Waiter.ThreadRef);
+                Waiter = FWaiter();
+                if (Watch.IsEmpty())
+                    Watches.Remove(Socket);
+                return socket_strerror(Error);
+            }
+
+            /**
+             * 取消socket上的等待，等待中的协程收到 nil, "closed"
+             */
+            int32 Cancel(lua_State* From, t_socket Socket)
+            {
+                FWatch Watch;
+                if (!Watches.RemoveAndCopyValue(Socket, Watch))
+                    return 0;
+
+                Unregister(Socket, Watch);
+                TArray<FWakeup, TInlineAllocator<2>> Wakeups;
+                Take(Watch.Reader, EWakeReason::Closed, Wakeups);
+                Take(Watch.Writer, EWakeReason::Closed, Wakeups);
+                for (const FWakeup& Wakeup : Wakeups)
+                    Resume(From, Wakeup);
+                return Wakeups.Num();
+            }
+
+            /**
+             * socket即将被关闭，等待中的协程在下一次轮询时收到 nil, "closed"
+             */
+            void Close(t_socket Socket)
+            {
+                FWatch Watch;
+                if (!Watches.RemoveAndCopyValue(Socket, Watch))
+                    return;
+
+                // 要在fd关闭前从epoll中移除，避免fd被复用后残留旧的注册
+                Unregister(Socket, Watch);
+                Take(Watch.Reader, EWakeReason::Closed, PendingWakeups);
+                Take(Watch.Writer, EWakeReason::Closed, PendingWakeups);
+            }
+
+            /**
+             * 轮询一次，恢复所有就绪或超时的协程，返回恢复的协程数
+             */
+            int32 Step(lua_State* From, double Timeout)
+            {
+                if (Watches.Num() == 0 && PendingWakeups.Num() == 0)
+                    return 0;
+
+                TArray<FWakeup> Wakeups = MoveTemp(PendingWakeups);
+                if (Watches.Num() > 0)
+                    Poll(Wakeups.Num() > 0 ? 0 : Timeout, Wakeups);
+                for (const FWakeup& Wakeup : Wakeups)
+                    Resume(From, Wakeup);
+                return Wakeups.Num();
+            }
+
+            int32 NumWaiters() const
+            {
+                int32 Count = PendingWakeups.Num();
+                for (const auto& Pair : Watches)
+                    Count += (Pair.Value.Reader.ThreadRef != LUA_NOREF ? 1 : 0) + (Pair.Value.Writer.ThreadRef != LUA_NOREF ? 1 : 0);
+                return Count;
+            }
+
+        private:
+            struct FWaiter
+            {
+                int32 ThreadRef = LUA_NOREF;
+                double Deadline = 0;
+            };
+
+            struct FWatch
+            {
+                FWaiter Reader;
+                FWaiter Writer;
+                uint32 Registered = 0;
+
+                FORCEINLINE bool IsEmpty() const { return Reader.ThreadRef == LUA_NOREF && Writer.ThreadRef == LUA_NOREF; }
+            };
+
+            struct FWakeup
+            {
+                int32 ThreadRef;
+                EWakeReason Reason;
+            };
+
+            bool Tick(float DeltaTime)
+            {
+                Step(L, 0);
+                return true;
+            }
+
+            template <typename AllocatorType>
+            static void Take(FWaiter& Waiter, EWakeReason Reason, TArray<FWakeup, AllocatorType>& Wakeups)
+            {
+                if (Waiter.ThreadRef == LUA_NOREF)
+                    return;
+                Wakeups.Add({Waiter.ThreadRef, Reason});
+                Waiter = FWaiter();
+            }
+
+            /* 取得最近的超时时间，用于限制阻塞轮询的时长 */
+            double GetNearestDeadline() const
+            {
+                double Nearest = 0;
+                for (const auto& Pair : Watches)
+                {
+                    for (const FWaiter* Waiter : {&Pair.Value.Reader, &Pair.Value.Writer})
+                    {
+                        if (Waiter->ThreadRef != LUA_NOREF && Waiter->Deadline > 0 && (Nearest == 0 || Waiter->Deadline < Nearest))
+                            Nearest = Waiter->Deadline;
+                    }
+                }
+                return Nearest;
+            }
+
+            int GetTimeoutMs(double Timeout) const
+            {
+                const double Nearest = GetNearestDeadline();
+                if (Nearest > 0)
+                {
+                    const double Remaining = FMath::Max(0.0, Nearest - FPlatformTime::Seconds());
+                    Timeout = Timeout < 0 ? Remaining : FMath::Min(Timeout, Remaining);
+                }
+                return Timeout < 0 ? -1 : (int)FMath::CeilToDouble(Timeout * 1000.0);
+            }
+
+            void Poll(double Timeout, TArray<FWakeup>& Wakeups)
+            {
+                const int TimeoutMs = GetTimeoutMs(Timeout);
+
+#if UNLUA_SOCKET_EPOLL
+                int Count;
+                do Count = epoll_wait(EpollFd, EpollEvents.GetData(), EpollEvents.Num(), TimeoutMs);
+                while (Count < 0 && errno == EINTR);
+
+                for (int Index = 0; Index < Count; ++Index)
+                {
+                    const epoll_event& Event = EpollEvents[Index];
+                    FWatch* Watch = Watches.Find(Event.data.fd);
+                    if (!Watch)
+                        continue;
+                    const bool bError = (Event.events & (EPOLLERR | EPOLLHUP)) != 0;
+                    if (bError || (Event.events & (EPOLLIN | EPOLLRDHUP)))
+                        Take(Watch->Reader, EWakeReason::Ready, Wakeups);
+                    if (bError || (Event.events & EPOLLOUT))
+                        Take(Watch->Writer, EWakeReason::Ready, Wakeups);
+                }
+                if (Count == EpollEvents.Num())
+                    EpollEvents.SetNumUninitialized(Count * 2);
+
+                // epoll会静默移除已关闭的fd，需要逐个检查
+                const bool bCheckClosed = true;
+#else
+                PollFds.Reset(Watches.Num());
+                for (const auto& Pair : Watches)
+                {
+                    FPollFd& PollFd = PollFds.AddZeroed_GetRef();
+                    PollFd.fd = Pair.Key;
+                    PollFd.events = (Pair.Value.Reader.ThreadRef != LUA_NOREF ? POLLIN : 0) | (Pair.Value.Writer.ThreadRef != LUA_NOREF ? POLLOUT : 0);
+                }
+
+                const int Count = PollSockets(PollFds.GetData(), PollFds.Num(), TimeoutMs);
+                for (int32 Index = 0; Count > 0 && Index < PollFds.Num(); ++Index)
+                {
+                    const FPollFd& PollFd = PollFds[Index];
+                    if (PollFd.revents == 0)
+                        continue;
+                    FWatch* Watch = Watches.Find(PollFd.fd);
+                    if (!Watch)
+                        continue;
+                    const EWakeReason Reason = (PollFd.revents & POLLNVAL) ? EWakeReason::Closed : EWakeReason::Ready;
+                    const bool bError = (PollFd.revents & (POLLERR | POLLHUP | POLLNVAL)) != 0;
+                    if (bError || (PollFd.revents & POLLIN))
+                        Take(Watch->Reader, Reason, Wakeups);
+                    if (bError || (PollFd.revents & POLLOUT))
+                        Take(Watch->Writer, Reason, Wakeups);
+                }
+
+                // 关闭的fd会被报告为POLLNVAL，但WSAPoll会直接返回错误
+                const bool bCheckClosed = Count < 0;
+#endif
+
+                const double Now = FPlatformTime::Seconds();
+                for (auto It = Watches.CreateIterator(); It; ++It)
+                {
+                    FWatch& Watch = It.Value();
+                    if (bCheckClosed && IsSocketClosed(It.Key()))
+                    {
+                        Take(Watch.Reader, EWakeReason::Closed, Wakeups);
+                        Take(Watch.Writer, EWakeReason::Closed, Wakeups);
+                    }
+                    if (Watch.Reader.Deadline > 0 && Now >= Watch.Reader.Deadline)
+                        Take(Watch.Reader, EWakeReason::Timeout, Wakeups);
+                    if (Watch.Writer.Deadline > 0 && Now >= Watch.Writer.Deadline)
+                        Take(Watch.Writer, EWakeReason::Timeout, Wakeups);
+
+                    if (Watch.IsEmpty())
+                    {
+                        Unregister(It.Key(), Watch);
+                        It.RemoveCurrent();
+                    }
+                    else
+                    {
+                        Sync(It.Key(), Watch);
+                    }
+                }
+            }
+
+            /* 同步epoll中的关注事件，其它平台每次轮询时重新生成pollfd，无需同步 */
+            int Sync(t_socket Socket, FWatch& Watch)
+            {
+#if UNLUA_SOCKET_EPOLL
+                const uint32 Desired = (Watch.Reader.ThreadRef != LUA_NOREF ? EPOLLIN | EPOLLRDHUP : 0) | (Watch.Writer.ThreadRef != LUA_NOREF ? EPOLLOUT : 0);
+                if (Desired == Watch.Registered)
+                    return 0;
+                if (Desired == 0)
+                {
+                    Unregister(Socket, Watch);
+                    return 0;
+                }
+
+                epoll_event Event;
+                Event.events = Desired;
+                Event.data.fd = Socket;
+                if (epoll_ctl(EpollFd, Watch.Registered ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, Socket, &Event) != 0)
+                {
+                    // fd被关闭后复用时epoll里可能残留旧的注册，或已被内核移除
+                    const int Op = errno == EEXIST ? EPOLL_CTL_MOD : errno == ENOENT ? EPOLL_CTL_ADD : -1;
+                    if (Op < 0 || epoll_ctl(EpollFd, Op, Socket, &Event) != 0)
+                        return errno;
+                }
+                Watch.Registered = Desired;
+#endif
+                return 0;
+            }
+
+            void Unregister(t_socket Socket, FWatch& Watch)
+            {
+#if UNLUA_SOCKET_EPOLL
+                if (Watch.Registered)
+                    epoll_ctl(EpollFd, EPOLL_CTL_DEL, Socket, nullptr);
+#endif
+                Watch.Registered = 0;
+            }
+
+            void Resume(lua_State* From, const FWakeup& Wakeup)
+            {
+                lua_rawgeti(From, LUA_REGISTRYINDEX, Wakeup.ThreadRef);
+                lua_State* Thread = lua_tothread(From, -1);
+                lua_pop(From, 1);
+                luaL_unref(From, LUA_REGISTRYINDEX, Wakeup.ThreadRef);
+                if (!Thread || Thread == From || lua_status(Thread) != LUA_YIELD)
+                    return;
+
+                int32 NArgs = 1;
+                if (Wakeup.Reason == EWakeReason::Ready)
+                {
+                    lua_pushboolean(Thread, 1);
+                }
+                else
+                {
+                    lua_pushnil(Thread);
+                    lua_pushstring(Thread, Wakeup.Reason == EWakeReason::Timeout ? "timeout" : "closed");
+                    NArgs = 2;
+                }
+
+#if 504 == LUA_VERSION_NUM
+                int NResults = 0;
+                const int32 Status = lua_resume(Thread, From, NArgs, &NResults);
+#else
+                const int32 Status = lua_resume(Thread, From, NArgs);
+                const int NResults = Status == LUA_OK || Status == LUA_YIELD ? lua_gettop(Thread) : 0;
+#endif
+                if (Status == LUA_OK || Status == LUA_YIELD)
+                {
+                    lua_pop(Thread, NResults);
+                    return;
+                }
+
+                luaL_traceback(From, Thread, lua_tostring(Thread, -1), 0);
+                UE_LOG(LogUnLua, Error, TEXT("socket.reactor: %s"), UTF8_TO_TCHAR(lua_tostring(From, -1)));
+                lua_pop(From, 1);
+            }
+
+            lua_State* L;
+            TMap<t_socket, FWatch> Watches;
+            TArray<FWakeup> PendingWakeups;
+            FReactorTickerHandle TickerHandle;
+#if UNLUA_SOCKET_EPOLL
+            int EpollFd = -1;
+            TArray<epoll_event> EpollEvents;
+#else
+            TArray<FPollFd> PollFds;
+#endif
+        };
+
+        /* 可复用的接收缓冲区，数据直接从内核收进来，Lua只在取用时才生成字符串 */
+        struct FRecvBuffer
+        {
+            size_t Capacity;
+            size_t First;
+            size_t Last;
+
+            FORCEINLINE char* Data() { return (char*)(this + 1); }
+            FORCEINLINE size_t Size() const { return Last - First; }
+
+            void Consume(size_t Count)
+            {
+                First += FMath::Min(Count, Size());
+                if (First == Last)
+                    First = Last = 0;
+            }
+        };
+
+        static t_socket CheckSocket(lua_State* L, int Index)
+        {
+            if (lua_type(L, Index) == LUA_TNUMBER)
+                return (t_socket)lua_tointeger(L, Index);
+            if (p_tcp Tcp = (p_tcp)auxiliar_getgroupudata(L, "tcp{any}", Index))
+                return Tcp->sock;
+            if (p_udp Udp = (p_udp)auxiliar_getgroupudata(L, "udp{any}", Index))
+                return Udp->sock;
+
+            // 其它socket对象统一走getfd
+            if (lua_type(L, Index) == LUA_TUSERDATA && lua_getfield(L, Index, "getfd") == LUA_TFUNCTION)
+            {
+                lua_pushvalue(L, Index);
+                lua_call(L, 1, 1);
+                const t_socket Socket = (t_socket)lua_tointeger(L, -1);
+                lua_pop(L, 1);
+                return Socket;
+            }
+            luaL_argerror(L, Index, "socket expected");
+            return SOCKET_INVALID;
+        }
+
+        static FReactor* CheckReactor(lua_State* L)
+        {
+            FReactor* Reactor = FReactor::Get(L);
+            if (!Reactor)
+                luaL_error(L, "socket.reactor is not available");
+            return Reactor;
+        }
+
+        /* 包装tcp/udp对象的close，关闭前通知reactor */
+        static int Socket_Close(lua_State* L)
+        {
+            p_tcp Tcp = (p_tcp)auxiliar_getgroupudata(L, "tcp{any}", 1);
+            p_udp Udp = Tcp ? nullptr : (p_udp)auxiliar_getgroupudata(L, "udp{any}", 1);
+            const t_socket Socket = Tcp ? Tcp->sock : Udp ? Udp->sock : SOCKET_INVALID;
+            FReactor* Reactor = FReactor::Get(L);
+            if (Reactor && Socket != SOCKET_INVALID)
+                Reactor->Close(Socket);
+
+            lua_pushvalue(L, lua_upvalueindex(1));
+            lua_insert(L, 1);
+            lua_call(L, lua_gettop(L) - 1, LUA_MULTRET);
+            return lua_gettop(L);
+        }
+
+        /* luasocket重复加载时会重建方法表，所以每次wait时都检查一下 */
+        static void HookClose(lua_State* L, int Index)
+        {
+            if (!auxiliar_getgroupudata(L, "tcp{any}", Index) && !auxiliar_getgroupudata(L, "udp{any}", Index))
+                return;
+
+            const int Top = lua_gettop(L);
+            if (lua_getmetatable(L, Index)
+                && lua_getfield(L, -1, "__index") == LUA_TTABLE
+                && lua_getfield(L, -1, "close") == LUA_TFUNCTION
+                && lua_tocfunction(L, -1) != Socket_Close)
+            {
+                lua_pushcclosure(L, Socket_Close, 1);
+                lua_setfield(L, -2, "close");
+            }
+            lua_settop(L, Top);
+        }
+
+        /* reactor.wait(sock, mode [, timeout]) */
+        static int Reactor_Wait(lua_State* L)
+        {
+            const t_socket Socket = CheckSocket(L, 1);
+            const char* Mode = luaL_optstring(L, 2, "r");
+            const double Timeout = luaL_optnumber(L, 3, -1);
+            luaL_argcheck(L, (Mode[0] == 'r' || Mode[0] == 'w') && Mode[1] == '\0', 2, "'r' or 'w' expected");
+            if (!lua_isyieldable(L))
+                return luaL_error(L, "reactor.wait must be called from a coroutine");
+
+            if (Socket == SOCKET_INVALID)
+            {
+                lua_pushnil(L);
+                lua_pushstring(L, "closed");
+                return 2;
+            }
+
+            const char* Error = CheckReactor(L)->Wait(L, Socket, Mode[0] == 'w', Timeout);
+            if (Error)
+                return luaL_error(L, "%s", Error);
+            HookClose(L, 1);
+            return lua_yield(L, 0);
+        }
+
+        /* reactor.cancel(sock) */
+        static int Reactor_Cancel(lua_State* L)
+        {
+            const t_socket Socket = CheckSocket(L, 1);
+            lua_pushinteger(L, CheckReactor(L)->Cancel(L, Socket));
+            return 1;
+        }
+
+        /* reactor.step([timeout]) */
+        static int Reactor_Step(lua_State* L)
+        {
+            const double Timeout = luaL_optnumber(L, 1, 0);
+            lua_pushinteger(L, CheckReactor(L)->Step(L, Timeout));
+            return 1;
+        }
+
+        /* reactor.count() */
+        static int Reactor_Count(lua_State* L)
+        {
+            lua_pushinteger(L, CheckReactor(L)->NumWaiters());
+            return 1;
+        }
+
+        /* reactor.buffer([capacity]) */
+        static int Reactor_Buffer(lua_State* L)
+        {
+            const lua_Integer Capacity = luaL_optinteger(L, 1, 64 * 1024);
+            luaL_argcheck(L, Capacity > 0 && Capacity <= 16 * 1024 * 1024, 1, "capacity out of range");
+            FRecvBuffer* Buffer = (FRecvBuffer*)lua_newuserdata(L, sizeof(FRecvBuffer) + (size_t)Capacity);
+            Buffer->Capacity = (size_t)Capacity;
+            Buffer->First = Buffer->Last = 0;
+            luaL_setmetatable(L, BUFFER_METATABLE);
+            return 1;
+        }
+
+        static int Reactor_GC(lua_State* L)
+        {
+            FReactor** Reactor = (FReactor**)lua_touserdata(L, 1);
+            delete *Reactor;
+            *Reactor = nullptr;
+            return 0;
+        }
+
+        static FRecvBuffer* CheckBuffer(lua_State* L)
+        {
+            return (FRecvBuffer*)luaL_checkudata(L, 1, BUFFER_METATABLE);
+        }
+
+        /* 把Lua风格的[i, j]转换为缓冲区内的偏移 */
+        static void CheckRange(lua_State* L, FRecvBuffer* Buffer, int Index, size_t& OutStart, size_t& OutEnd)
+        {
+            const lua_Integer Size = (lua_Integer)Buffer->Size();
+            lua_Integer Start = luaL_optinteger(L, Index, 1);
+            lua_Integer End = luaL_optinteger(L, Index + 1, -1);
+            if (Start < 0) Start = FMath::Max<lua_Integer>(Size + Start + 1, 1);
+            else if (Start == 0) Start = 1;
+            if (End < 0) End = Size + End + 1;
+            else if (End > Size) End = Size;
+            OutStart = (size_t)(Start - 1);
+            OutEnd = Start <= End ? (size_t)End : OutStart;
+        }
+
+        /* buffer:recv(sock)，返回收到的字节数，或 nil, err */
+        static int Buffer_Recv(lua_State* L)
+        {
+            FRecvBuffer* Buffer = CheckBuffer(L);
+            p_tcp Tcp = (p_tcp)auxiliar_getgroupudata(L, "tcp{any}", 2);
+            p_udp Udp = Tcp ? nullptr : (p_udp)auxiliar_getgroupudata(L, "udp{any}", 2);
+            if (!Tcp && !Udp)
+                return luaL_argerror(L, 2, "tcp or udp socket expected");
+
+            if (Buffer->First > 0 && Buffer->Last == Buffer->Capacity)
+            {
+                FMemory::Memmove(Buffer->Data(), Buffer->Data() + Buffer->First, Buffer->Size());
+                Buffer->Last -= Buffer->First;
+                Buffer->First = 0;
+            }
+
+            const size_t Free = Buffer->Capacity - Buffer->Last;
+            if (Free == 0)
+            {
+                lua_pushnil(L);
+                lua_pushstring(L, "buffer full");
+                return 2;
+            }
+
+            // 先取走socket:receive预读在内部缓冲区里的数据
+            if (Tcp && !buffer_isempty(&Tcp->buf))
+            {
+                const size_t Count = FMath::Min(Free, Tcp->buf.last - Tcp->buf.first);
+                FMemory::Memcpy(Buffer->Data() + Buffer->Last, Tcp->buf.data + Tcp->buf.first, Count);
+                Buffer->Last += Count;
+                Tcp->buf.first += Count;
+                if (buffer_isempty(&Tcp->buf))
+                    Tcp->buf.first = Tcp->buf.last = 0;
+                lua_pushinteger(L, (lua_Integer)Count);
+                return 1;
+            }
+
+            t_timeout Timeout;
+            timeout_init(&Timeout, 0, -1);
+            timeout_markstart(&Timeout);
+            size_t Got = 0;
+            const int Error = socket_recv(Tcp ? &Tcp->sock : &Udp->sock, Buffer->Data() + Buffer->Last, Free, &Got, &Timeout);
+            if (Error != IO_DONE)
+            {
+                lua_pushnil(L);
+                lua_pushstring(L, socket_strerror(Error));
+                return 2;
+            }
+
+            Buffer->Last += Got;
+            if (Tcp)
+                Tcp->buf.received += Got;
+            lua_pushinteger(L, (lua_Integer)Got);
+            return 1;
+        }
+
+        /* buffer:peek([i [, j]])，不消耗数据 */
+        static int Buffer_Peek(lua_State* L)
+        {
+            FRecvBuffer* Buffer = CheckBuffer(L);
+            size_t Start, End;
+            CheckRange(L, Buffer, 2, Start, End);
+            lua_pushlstring(L, Buffer->Data() + Buffer->First + Start, End - Start);
+            return 1;
+        }
+
+        /* buffer:read([n])，取出并消耗n个字节，默认全部 */
+        static int Buffer_Read(lua_State* L)
+        {
+            FRecvBuffer* Buffer = CheckBuffer(L);
+            const lua_Integer Count = luaL_optinteger(L, 2, (lua_Integer)Buffer->Size());
+            luaL_argcheck(L, Count >= 0, 2, "negative count");
+            if ((size_t)Count > Buffer->Size())
+            {
+                lua_pushnil(L);
+                return 1;
+            }
+            lua_pushlstring(L, Buffer->Data() + Buffer->First, (size_t)Count);
+            Buffer->Consume((size_t)Count);
+            return 1;
+        }
+
+        /* buffer:readline()，取出一行（不含行尾的\r\n），没有完整的行时返回nil */
+        static int Buffer_ReadLine(lua_State* L)
+        {
+            FRecvBuffer* Buffer = CheckBuffer(L);
+            const char* Begin = Buffer->Data() + Buffer->First;
+            const char* NewLine = (const char*)memchr(Begin, '\n', Buffer->Size());
+            if (!NewLine)
+            {
+                lua_pushnil(L);
+                return 1;
+            }
+
+            size_t Length = NewLine - Begin;
+            const size_t Consumed = Length + 1;
+            if (Length > 0 && Begin[Length - 1] == '\r')
+                --Length;
+            lua_pushlstring(L, Begin, Length);
+            Buffer->Consume(Consumed);
+            return 1;
+        }
+
+        /* buffer:find(str [, init])，按字节查找，返回起始位置 */
+        static int Buffer_Find(lua_State* L)
+        {
+            FRecvBuffer* Buffer = CheckBuffer(L);
+            size_t PatternLength;
+            const char* Pattern = luaL_checklstring(L, 2, &PatternLength);
+            lua_Integer Init = luaL_optinteger(L, 3, 1);
+            const size_t Size = Buffer->Size();
+            if (Init < 0) Init = FMath::Max<lua_Integer>((lua_Integer)Size + Init + 1, 1);
+            else if (Init == 0) Init = 1;
+
+            const char* Begin = Buffer->Data() + Buffer->First;
+            size_t Offset = (size_t)Init - 1;
+            if (PatternLength == 0 && Offset <= Size)
+            {
+                lua_pushinteger(L, (lua_Integer)Offset + 1);
+                return 1;
+            }
+            while (PatternLength > 0 && Offset + PatternLength <= Size)
+            {
+                const char* Found = (const char*)memchr(Begin + Offset, Pattern[0], Size - PatternLength - Offset + 1);
+                if (!Found)
+                    break;
+                Offset = Found - Begin;
+                if (FMemory::Memcmp(Found, Pattern, PatternLength) == 0)
+                {
+                    lua_pushinteger(L, (lua_Integer)Offset + 1);
+                    return 1;
+                }
+                ++Offset;
+            }
+            lua_pushnil(L);
+            return 1;
+        }
+
+        static int Buffer_Skip(lua_State* L)
+        {
+            FRecvBuffer* Buffer = CheckBuffer(L);
+            const lua_Integer Count = luaL_checkinteger(L, 2);
+            luaL_argcheck(L, Count >= 0, 2, "negative count");
+            const size_t Skipped = FMath::Min((size_t)Count, Buffer->Size());
+            Buffer->Consume(Skipped);
+            lua_pushinteger(L, (lua_Integer)Skipped);
+            return 1;
+        }
+
+        static int Buffer_Clear(lua_State* L)
+        {
+            FRecvBuffer* Buffer = CheckBuffer(L);
+            Buffer->First = Buffer->Last = 0;
+            return 0;
+        }
+
+        static int Buffer_Size(lua_State* L)
+        {
+            lua_pushinteger(L, (lua_Integer)CheckBuffer(L)->Size());
+            return 1;
+        }
+
+        static int Buffer_Capacity(lua_State* L)
+        {
+            lua_pushinteger(L, (lua_Integer)CheckBuffer(L)->Capacity);
+            return 1;
+        }
+
+        static int Buffer_ToString(lua_State* L)
+        {
+            FRecvBuffer* Buffer = CheckBuffer(L);
+            lua_pushfstring(L, "reactor.buffer: %d/%d", (int)Buffer->Size(), (int)Buffer->Capacity);
+            return 1;
+        }
+
+        static const luaL_Reg BufferMethods[] = {
+            {"recv", Buffer_Recv},
+            {"peek", Buffer_Peek},
+            {"read", Buffer_Read},
+            {"readline", Buffer_ReadLine},
+            {"find", Buffer_Find},
+            {"skip", Buffer_Skip},
+            {"clear", Buffer_Clear},
+            {"size", Buffer_Size},
+            {"capacity", Buffer_Capacity},
+            {"__len", Buffer_Size},
+            {"__tostring", Buffer_ToString},
+            {nullptr, nullptr}
+        };
+
+        static const luaL_Reg ReactorFunctions[] = {
+            {"wait", Reactor_Wait},
+            {"cancel", Reactor_Cancel},
+            {"step", Reactor_Step},
+            {"count", Reactor_Count},
+            {"buffer", Reactor_Buffer},
+            {nullptr, nullptr}
+        };
+
+        int luaopen_socket_reactor(lua_State* L)
+        {
+            if (!FReactor::Get(L))
+            {
+                lua_rawgeti(L, LUA_REGISTRYINDEX, LUA_RIDX_MAINTHREAD);
+                lua_State* MainThread = lua_tothread(L, -1);
+                lua_pop(L, 1);
+
+                FReactor** Reactor = (FReactor**)lua_newuserdata(L, sizeof(FReactor*));
+                *Reactor = new FReactor(MainThread);
+                lua_newtable(L);
+                lua_pushcfunction(L, Reactor_GC);
+                lua_setfield(L, -2, "__gc");
+                lua_setmetatable(L, -2);
+                lua_setfield(L, LUA_REGISTRYINDEX, REACTOR_KEY);
+            }
+
+            if (luaL_newmetatable(L, BUFFER_METATABLE))
+            {
+                luaL_setfuncs(L, BufferMethods, 0);
+                lua_pushvalue(L, -1);
+                lua_setfield(L, -2, "__index");
+            }
+            lua_pop(L, 1);
+
+            luaL_newlib(L, ReactorFunctions);
+            return 1;
+        }
+    }
+}
@@ -0,0 +1,33 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+//
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License");
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct lua_State;
+
+namespace UnLuaExtensions
+{
+    namespace LuaSocket
+    {
+        /**
+         * require "socket.reactor"
+         *
+         * 每个Lua虚拟机一个事件循环，随引擎Tick轮询所有等待中的socket（Linux/Android下使用epoll），
+         * 就绪或超时后恢复对应的协程，不再需要每帧对每个连接 settimeout(0) 轮询。
+         */
+        int luaopen_socket_reactor(lua_State* L);
+    }
+}
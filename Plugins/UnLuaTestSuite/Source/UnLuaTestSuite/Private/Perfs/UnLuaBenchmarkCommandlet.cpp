@@ -0,0 +1,345 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "Perfs/UnLuaBenchmarkCommandlet.h"
+#include "Perfs/UnLuaBenchmarkProxy.h"
+#include "Dom/JsonObject.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "LuaEnv.h"
+#include "UnLuaBase.h"
+#include "UnLuaTestHelpers.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogUnLuaBenchmark, Log, All);
+
+namespace UnLuaBenchmark
+{
+    struct FCase
+    {
+        const TCHAR* Name;
+        const TCHAR* Setup;
+        const TCHAR* Body;
+    };
+
+    // 先执行一次Setup，再循环N次Body，Proxy与Stub是预先创建好的对象
+    static const FCase Cases[] =
+    {
+        {TEXT("UFunction.NoParam"), TEXT(""), TEXT("Proxy:NOP()")},
+        {TEXT("UFunction.Int32Return"), TEXT(""), TEXT("Proxy:GetMeshID()")},
+        {TEXT("UFunction.Int32Param"), TEXT(""), TEXT("Proxy:UpdateMeshID(i)")},
+        {TEXT("UFunction.FStringParam"), TEXT("local Name = 'Mesh'"), TEXT("Proxy:UpdateMeshName(Name)")},
+        {TEXT("UFunction.StructRefParams"), TEXT("local Origin, Direction = UE.FVector(0, 0, 0), UE.FVector(1, 0, 0)"), TEXT("Proxy:Raycast(Origin, Direction)")},
+        {TEXT("UFunction.ArrayOutParam"), TEXT("local Indices = UE.TArray(0)"), TEXT("Proxy:GetIndices(Indices)")},
+        {TEXT("UFunction.ArrayRefReturn"), TEXT(""), TEXT("Proxy:GetPredictedPositions()")},
+        {TEXT("Property.Int32"), TEXT(""), TEXT("Proxy.MeshID = Proxy.MeshID + 1")},
+        {TEXT("Property.FString"), TEXT(""), TEXT("local _ = Proxy.MeshName")},
+        {TEXT("Property.FVector"), TEXT(""), TEXT("local _ = Proxy.COM")},
+        {TEXT("Delegate.AddRemove"), TEXT("local Event, Callback = Stub.SimpleEvent, function() end"), TEXT("Event:Add(Stub, Callback) Event:Remove(Stub, Callback)")},
+        {TEXT("Delegate.Broadcast"), TEXT("local Event = Stub.SimpleEvent Event:Clear() Event:Add(Stub, function() end)"), TEXT("Event:Broadcast()")},
+        {TEXT("TArray.AddGet"), TEXT("local Array = UE.TArray(0)"), TEXT("Array:Add(i) local _ = Array:Get(i)")},
+        {TEXT("TMap.AddFind"), TEXT("local Map = UE.TMap(0, 0)"), TEXT("Map:Add(i, i) local _ = Map:Find(i)")},
+        {TEXT("FVector.Add"), TEXT("local A, B = UE.FVector(1, 2, 3), UE.FVector(4, 5, 6)"), TEXT("local _ = A + B")},
+        {TEXT("Object.Push"), TEXT(""), TEXT("local _ = Stub:GetOuter()")},
+        {TEXT("Module.Require"), TEXT(""), TEXT("package.loaded.UnLuaBenchmarkModule = nil local _ = require('UnLuaBenchmarkModule')")},
+    };
+
+    static const TCHAR* ENV_CREATE_CASE_NAME = TEXT("Env.Create");
+
+    struct FResult
+    {
+        FString Name;
+        double Nanoseconds;
+        double Allocations;     // 每次操作的Lua内存分配次数，小于0表示没有统计
+        double AllocatedBytes;
+    };
+
+    /**
+     * 包装Lua分配器，统计分配次数与字节数
+     */
+    struct FAllocCounter
+    {
+        lua_Alloc Alloc;
+        void* UserData;
+        uint64 Count;
+        uint64 Bytes;
+
+        static void* Counting(void* ud, void* ptr, size_t osize, size_t nsize)
+        {
+            const auto Counter = (FAllocCounter*)ud;
+            if (nsize > 0 && (!ptr || nsize > osize))
+            {
+                Counter->Count++;
+                Counter->Bytes += ptr ? nsize - osize : nsize;
+            }
+            return Counter->Alloc(Counter->UserData, ptr, osize, nsize);
+        }
+    };
+
+    static bool LoadBenchmarkModule(const UnLua::FLuaEnv& Env, const FString& FilePath, TArray<uint8>& Data, FString& RealFilePath)
+    {
+        if (FilePath != TEXT("UnLuaBenchmarkModule"))
+            return false;
+
+        static const char Source[] = "local M = {} function M.Add(A, B) return A + B end return M";
+        Data.Append((const uint8*)Source, sizeof(Source) - 1);
+        RealFilePath = FilePath;
+        return true;
+    }
+
+    static bool CallBenchmark(lua_State* L, int32 FuncIndex, int32 Iterations, const TCHAR* Name)
+    {
+        lua_pushvalue(L, FuncIndex);
+        lua_pushinteger(L, Iterations);
+        if (lua_pcall(L, 1, 0, 0) == LUA_OK)
+            return true;
+        UE_LOG(LogUnLuaBenchmark, Error, TEXT("%s: %s"), Name, UTF8_TO_TCHAR(lua_tostring(L, -1)));
+        lua_pop(L, 1);
+        return false;
+    }
+
+    static bool RunCase(lua_State* L, FAllocCounter& Counter, const FCase& Case, int32 Iterations, int32 Repeat, FResult& OutResult)
+    {
+        const FString Chunk = FString::Printf(TEXT("%s\nreturn function(N) for i = 1, N do %s end end"), Case.Setup, Case.Body);
+        if (luaL_loadstring(L, TCHAR_TO_UTF8(*Chunk)) != LUA_OK || lua_pcall(L, 0, 1, 0) != LUA_OK)
+        {
+            UE_LOG(LogUnLuaBenchmark, Error, TEXT("%s: %s"), Case.Name, UTF8_TO_TCHAR(lua_tostring(L, -1)));
+            lua_pop(L, 1);
+            return false;
+        }
+
+        const int32 FuncIndex = lua_gettop(L);
+        bool bSuccess = CallBenchmark(L, FuncIndex, FMath::Max(Iterations / 10, 1), Case.Name);
+        double Best = MAX_dbl;
+        for (int32 i = 0; bSuccess && i < Repeat; ++i)
+        {
+            lua_gc(L, LUA_GCCOLLECT, 0);
+            Counter.Count = 0;
+            Counter.Bytes = 0;
+            const double Start = FPlatformTime::Seconds();
+            bSuccess = CallBenchmark(L, FuncIndex, Iterations, Case.Name);
+            Best = FMath::Min(Best, FPlatformTime::Seconds() - Start);
+        }
+        lua_settop(L, FuncIndex - 1);
+        if (!bSuccess)
+            return false;
+
+        OutResult.Name = Case.Name;
+        OutResult.Nanoseconds = Best * 1e9 / Iterations;
+        OutResult.Allocations = (double)Counter.Count / Iterations;
+        OutResult.AllocatedBytes = (double)Counter.Bytes / Iterations;
+        return true;
+    }
+
+    /**
+     * 创建Env时Lua分配器还没法替换，只记录创建后Lua堆的大小
+     */
+    static FResult RunEnvCreate(int32 Iterations, int32 Repeat)
+    {
+        double Best = MAX_dbl;
+        for (int32 i = 0; i < Repeat; ++i)
+        {
+            const double Start = FPlatformTime::Seconds();
+            for (int32 j = 0; j < Iterations; ++j)
+            {
+                UnLua::FLuaEnv Env;
+            }
+            Best = FMath::Min(Best, FPlatformTime::Seconds() - Start);
+        }
+
+        UnLua::FLuaEnv Env;
+        const auto L = Env.GetMainState();
+        FResult Result;
+        Result.Name = ENV_CREATE_CASE_NAME;
+        Result.Nanoseconds = Best * 1e9 / Iterations;
+        Result.Allocations = -1;
+        Result.AllocatedBytes = lua_gc(L, LUA_GCCOUNT, 0) * 1024.0 + lua_gc(L, LUA_GCCOUNTB, 0);
+        return Result;
+    }
+
+    static FString Serialize(const TArray<FResult>& Results, int32 Iterations)
+    {
+        TArray<TSharedPtr<FJsonValue>> Values;
+        for (const auto& Result : Results)
+        {
+            const auto Object = MakeShared<FJsonObject>();
+            Object->SetStringField(TEXT("Name"), Result.Name);
+            Object->SetNumberField(TEXT("Nanoseconds"), Result.Nanoseconds);
+            Object->SetNumberField(TEXT("Allocations"), Result.Allocations);
+            Object->SetNumberField(TEXT("AllocatedBytes"), Result.AllocatedBytes);
+            Values.Add(MakeShared<FJsonValueObject>(Object));
+        }
+
+        const auto Root = MakeShared<FJsonObject>();
+        Root->SetNumberField(TEXT("Iterations"), Iterations);
+        Root->SetArrayField(TEXT("Results"), Values);
+
+        FString Content;
+        const auto Writer = TJsonWriterFactory<>::Create(&Content);
+        FJsonSerializer::Serialize(Root, Writer);
+        return Content;
+    }
+
+    static bool LoadBaseline(const FString& FilePath, TMap<FString, FResult>& OutResults)
+    {
+        FString Content;
+        if (!FFileHelper::LoadFileToString(Content, *FilePath))
+            return false;
+
+        TSharedPtr<FJsonObject> Root;
+        if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Content), Root) || !Root.IsValid())
+            return false;
+
+        const TArray<TSharedPtr<FJsonValue>>* Values;
+        if (!Root->TryGetArrayField(TEXT("Results"), Values))
+            return false;
+
+        for (const auto& Value : *Values)
+        {
+            const auto Object = Value->AsObject();
+            if (!Object.IsValid())
+                continue;
+            FResult Result;
+            Result.Name = Object->GetStringField(TEXT("Name"));
+            Result.Nanoseconds = Object->GetNumberField(TEXT("Nanoseconds"));
+            Result.Allocations = Object->GetNumberField(TEXT("Allocations"));
+            Result.AllocatedBytes = Object->GetNumberField(TEXT("AllocatedBytes"));
+            OutResults.Add(Result.Name, Result);
+        }
+        return true;
+    }
+
+    /**
+     * 耗时或分配次数超过基准的(1 + Threshold)倍视为回退，返回回退的数量
+     */
+    static int32 Compare(const TArray<FResult>& Results, const TMap<FString, FResult>& Baseline, double Threshold)
+    {
+        int32 Regressions = 0;
+        for (const auto& Result : Results)
+        {
+            const auto Base = Baseline.Find(Result.Name);
+            if (!Base)
+            {
+                UE_LOG(LogUnLuaBenchmark, Display, TEXT("%-28s no baseline"), *Result.Name);
+                continue;
+            }
+
+            const double Ratio = Base->Nanoseconds > 0 ? Result.Nanoseconds / Base->Nanoseconds - 1 : 0;
+            const bool bSlower = Ratio > Threshold;
+            const bool bMoreAllocations = Base->Allocations >= 0 && Result.Allocations > Base->Allocations * (1 + Threshold) + 0.01;
+            if (bSlower || bMoreAllocations)
+            {
+                Regressions++;
+                UE_LOG(LogUnLuaBenchmark, Error, TEXT("%-28s %+.1f%% time, %.2f -> %.2f allocs"), *Result.Name, Ratio * 100, Base->Allocations, Result.Allocations);
+            }
+            else
+            {
+                UE_LOG(LogUnLuaBenchmark, Display, TEXT("%-28s %+.1f%% time, %.2f -> %.2f allocs"), *Result.Name, Ratio * 100, Base->Allocations, Result.Allocations);
+            }
+        }
+        return Regressions;
+    }
+}
+
+UUnLuaBenchmarkCommandlet::UUnLuaBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+    ShowErrorCount = true;
+    HelpDescription = TEXT("Run UnLua binding benchmarks, optionally compare against a baseline.");
+    HelpUsage = TEXT("-run=UnLuaBenchmark [-Iterations=100000] [-Repeat=5] [-Filter=Name] [-Output=File.json] [-Baseline=File.json] [-Threshold=0.1]");
+}
+
+int32 UUnLuaBenchmarkCommandlet::Main(const FString& Params)
+{
+    using namespace UnLuaBenchmark;
+
+    int32 Iterations = 100000;
+    int32 Repeat = 5;
+    float Threshold = 0.1f;
+    FString Filter, OutputPath, BaselinePath;
+    FParse::Value(*Params, TEXT("Iterations="), Iterations);
+    FParse::Value(*Params, TEXT("Repeat="), Repeat);
+    FParse::Value(*Params, TEXT("Threshold="), Threshold);
+    FParse::Value(*Params, TEXT("Filter="), Filter);
+    FParse::Value(*Params, TEXT("Output="), OutputPath);
+    FParse::Value(*Params, TEXT("Baseline="), BaselinePath);
+    Iterations = FMath::Max(Iterations, 1);
+    Repeat = FMath::Max(Repeat, 1);
+
+    TMap<FString, FResult> Baseline;
+    if (!BaselinePath.IsEmpty() && !LoadBaseline(BaselinePath, Baseline))
+    {
+        UE_LOG(LogUnLuaBenchmark, Error, TEXT("failed to load baseline %s"), *BaselinePath);
+        return 1;
+    }
+
+    const auto Stub = NewObject<UUnLuaTestStub>();
+    const auto Proxy = NewObject<AUnLuaBenchmarkProxy>();
+    Stub->AddToRoot();
+    Proxy->AddToRoot();
+
+    TArray<FResult> Results;
+    {
+        UnLua::FLuaEnv Env;
+        Env.AddLoader(UnLua::FLuaEnv::FLuaFileLoader::CreateStatic(&LoadBenchmarkModule));
+        const auto L = Env.GetMainState();
+        UnLua::PushUObject(L, Proxy);
+        lua_setglobal(L, "Proxy");
+        UnLua::PushUObject(L, Stub);
+        lua_setglobal(L, "Stub");
+
+        FAllocCounter Counter;
+        Counter.Alloc = lua_getallocf(L, &Counter.UserData);
+        lua_setallocf(L, FAllocCounter::Counting, &Counter);
+        for (const auto& Case : Cases)
+        {
+            if (!Filter.IsEmpty() && !FString(Case.Name).Contains(Filter))
+                continue;
+            FResult Result;
+            if (RunCase(L, Counter, Case, Iterations, Repeat, Result))
+                Results.Add(Result);
+        }
+        lua_setallocf(L, Counter.Alloc, Counter.UserData);
+    }
+
+    if (Filter.IsEmpty() || FString(ENV_CREATE_CASE_NAME).Contains(Filter))
+        Results.Add(RunEnvCreate(FMath::Max(Iterations / 1000, 1), Repeat));
+
+    Stub->RemoveFromRoot();
+    Proxy->RemoveFromRoot();
+
+    for (const auto& Result : Results)
+        UE_LOG(LogUnLuaBenchmark, Display, TEXT("%-28s %12.1f ns %10.2f allocs %12.1f bytes"), *Result.Name, Result.Nanoseconds, Result.Allocations, Result.AllocatedBytes);
+
+    if (OutputPath.IsEmpty())
+        OutputPath = FString::Printf(TEXT("%sBenchmark/UnLuaBenchmark-%s.json"), *FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir()), *FDateTime::Now().ToString());
+    FFileHelper::SaveStringToFile(Serialize(Results, Iterations), *OutputPath);
+    UE_LOG(LogUnLuaBenchmark, Display, TEXT("results saved to %s"), *OutputPath);
+
+    if (Baseline.Num() == 0)
+        return 0;
+
+    const int32 Regressions = Compare(Results, Baseline, Threshold);
+    if (Regressions > 0)
+    {
+        UE_LOG(LogUnLuaBenchmark, Error, TEXT("%d benchmark(s) regressed more than %.0f%%"), Regressions, Threshold * 100);
+        return 1;
+    }
+    return 0;
+}
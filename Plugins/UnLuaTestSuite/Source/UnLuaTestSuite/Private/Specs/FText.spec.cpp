@@ -0,0 +1,113 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "UnLuaBase.h"
+#include "UnLuaTemplate.h"
+#include "Misc/AutomationTest.h"
+#include "UnLuaTestHelpers.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && UNLUA_ENABLE_FTEXT
+
+BEGIN_DEFINE_SPEC(FUnLuaFTextSpec, "UnLua.API.FText", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+    TSharedPtr<UnLua::FLuaEnv> Env;
+    lua_State* L;
+END_DEFINE_SPEC(FUnLuaFTextSpec)
+
+void FUnLuaFTextSpec::Define()
+{
+    BeforeEach([this]
+    {
+        Env = MakeShared<UnLua::FLuaEnv>();
+        L = Env->GetMainState();
+    });
+
+    AfterEach([this]
+    {
+        Env.Reset();
+        L = nullptr;
+    });
+
+    Describe(TEXT("Format"), [this]
+    {
+        It(TEXT("使用命名参数"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Text = UE.FText.Format("{Name} has {Count} items", {Name = "Player", Count = 3})
+            return tostring(Text)
+            )";
+            Env->DoString(Chunk);
+            TEST_EQUAL(lua_tostring(L, -1), "Player has 3 items");
+        });
+
+        It(TEXT("使用顺序参数，参数可以是FText"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Name = UE.FText.FromString("Player")
+            local A = UE.FText.Format("{0}:{1}", Name, 2)
+            local B = UE.FText.Format("{0}:{1}", {Name, 2})
+            return tostring(A), tostring(B)
+            )";
+            Env->DoString(Chunk);
+            TEST_EQUAL(lua_tostring(L, -2), "Player:2");
+            TEST_EQUAL(lua_tostring(L, -1), "Player:2");
+        });
+    });
+
+    Describe(TEXT("比较与判空"), [this]
+    {
+        It(TEXT("相同内容的FText相等"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local A = UE.FText.FromString("a")
+            local B = UE.FText.FromString("b")
+            return A == UE.FText.FromString("a"), A < B, UE.FText.FromString(""):IsEmpty(), A:IsEmpty()
+            )";
+            Env->DoString(Chunk);
+            TEST_TRUE(lua_toboolean(L, -4));
+            TEST_TRUE(lua_toboolean(L, -3));
+            TEST_TRUE(lua_toboolean(L, -2));
+            TEST_FALSE(lua_toboolean(L, -1));
+        });
+
+        It(TEXT("其他类型的userdata不按FText读取"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Text = UE.FText.FromString("a")
+            local Vector = UE.FVector()
+            return Text == Vector, UE.FText.IsEmpty(Vector), pcall(UE.FText.Format, Vector)
+            )";
+            Env->DoString(Chunk);
+            TEST_FALSE(lua_toboolean(L, -4));
+            TEST_TRUE(lua_toboolean(L, -3));
+            TEST_FALSE(lua_toboolean(L, -2));
+        });
+    });
+
+    Describe(TEXT("ToString"), [this]
+    {
+        It(TEXT("tostring与ToString结果一致"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Text = UE.FText.AsNumber(42)
+            return tostring(Text), Text:ToString()
+            )";
+            Env->DoString(Chunk);
+            TEST_EQUAL(lua_tostring(L, -2), "42");
+            TEST_EQUAL(FString(lua_tostring(L, -2)), FString(lua_tostring(L, -1)));
+        });
+    });
+}
+
+#endif
@@ -0,0 +1,89 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "UnLuaBase.h"
+#include "UnLuaTemplate.h"
+#include "HeapSnapshot.h"
+#include "Misc/AutomationTest.h"
+#include "UnLuaTestHelpers.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FHeapSnapshotSpec, "UnLua.API.HeapSnapshot", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+    TSharedPtr<UnLua::FLuaEnv> Env;
+    lua_State* L;
+END_DEFINE_SPEC(FHeapSnapshotSpec)
+
+void FHeapSnapshotSpec::Define()
+{
+    BeforeEach([this]
+    {
+        Env = MakeShared<UnLua::FLuaEnv>();
+        L = Env->GetMainState();
+    });
+
+    AfterEach([this]
+    {
+        Env.Reset();
+        L = nullptr;
+    });
+
+    Describe(TEXT("Capture"), [this]
+    {
+        It(TEXT("模块表引用的对象归到模块名下"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            Env->DoString(TEXT("package.loaded['HeapSnapshotTest'] = { Data = string.rep('x', 10000) }"));
+            const auto Snapshot = UnLua::FHeapSnapshot::Capture(L);
+            const auto Entry = Snapshot.Roots.Find(TEXT("module:HeapSnapshotTest"));
+            TEST_TRUE(Entry != nullptr);
+            TEST_TRUE(Entry && Entry->Bytes >= 10000);
+        });
+
+        It(TEXT("绑定的UObject按类名归类，结构体按类型汇总"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            Env->DoString(TEXT("G_Stub = NewObject(UE.UUnLuaTestStub); G_Vector = UE.FVector(1, 2, 3)"));
+            const auto Snapshot = UnLua::FHeapSnapshot::Capture(L);
+            TEST_TRUE(Snapshot.Roots.Contains(TEXT("object:UnLuaTestStub")));
+            TEST_TRUE(Snapshot.Types.Contains(TEXT("userdata:FVector")));
+        });
+
+        It(TEXT("快照前后栈平衡"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const int32 Top = lua_gettop(L);
+            UnLua::FHeapSnapshot::Capture(L);
+            TEST_EQUAL(lua_gettop(L), Top);
+        });
+    });
+
+    Describe(TEXT("Diff"), [this]
+    {
+        It(TEXT("只包含有变化的路径"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            Env->GC();
+            const auto Before = UnLua::FHeapSnapshot::Capture(L);
+            Env->DoString(TEXT("G_Leak = {} for i = 1, 100 do G_Leak[i] = { i } end"));
+            Env->GC();
+            const auto After = UnLua::FHeapSnapshot::Capture(L);
+            const auto Diff = UnLua::FHeapSnapshot::Diff(Before, After);
+            const auto Entry = Diff.Roots.Find(TEXT("global"));
+            TEST_TRUE(Entry != nullptr);
+            TEST_TRUE(Entry && Entry->Count >= 101);
+            TEST_TRUE(Diff.TotalBytes > 0);
+            TEST_FALSE(Diff.Roots.Contains(TEXT("module:string")));
+        });
+    });
+}
+
+#endif
@@ -0,0 +1,81 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "LuaEnv.h"
+#include "UnLuaTestHelpers.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FLuaDanglingCheckSpec, "UnLua.API.DanglingCheck", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+    bool bWasEnabled;
+END_DEFINE_SPEC(FLuaDanglingCheckSpec)
+
+void FLuaDanglingCheckSpec::Define()
+{
+    BeforeEach([this]
+    {
+        bWasEnabled = UnLua::FDanglingCheck::Enabled;
+        UnLua::FDanglingCheck::Enabled = true;
+    });
+
+    It(TEXT("内层调用未析构时外层调用仍可正常返回"), EAsyncExecution::TaskGraphMainThread, [this]()
+    {
+        UnLua::FLuaEnv Env;
+        const auto DanglingCheck = Env.GetDanglingCheck();
+
+        auto Outer = DanglingCheck->MakeGuard();
+        const auto OuterGeneration = DanglingCheck->GetGeneration();
+        auto Inner = DanglingCheck->MakeGuard();
+        const auto InnerGeneration = DanglingCheck->GetGeneration();
+        TEST_TRUE(InnerGeneration > OuterGeneration);
+
+        // 模拟luaL_error跳过内层的析构
+        Outer.Reset();
+        TEST_EQUAL(DanglingCheck->GetGeneration(), (uint64)0);
+        TEST_FALSE(DanglingCheck->IsAlive(InnerGeneration));
+
+        Inner.Reset();
+        TEST_EQUAL(DanglingCheck->GetGeneration(), (uint64)0);
+    });
+
+    It(TEXT("调用中抛出Lua错误后后续调用正常"), EAsyncExecution::TaskGraphMainThread, [this]()
+    {
+        UnLua::FLuaEnv Env;
+        const auto L = Env.GetMainState();
+
+        TEST_TRUE(Env.DoString("local ok = pcall(error, 'boom'); assert(not ok)"));
+        TEST_TRUE(Env.DoString("return 1"));
+        TEST_EQUAL((int32)lua_tointeger(L, -1), 1);
+        TEST_EQUAL(Env.GetDanglingCheck()->GetGeneration(), (uint64)0);
+    });
+
+    It(TEXT("不同Lua环境的调用互不影响"), EAsyncExecution::TaskGraphMainThread, [this]()
+    {
+        UnLua::FLuaEnv Env1;
+        UnLua::FLuaEnv Env2;
+
+        const auto Guard = Env1.GetDanglingCheck()->MakeGuard();
+        TEST_TRUE(UnLua::FDanglingCheck::GetGeneration(Env1.GetMainState()) > 0);
+        TEST_EQUAL(UnLua::FDanglingCheck::GetGeneration(Env2.GetMainState()), (uint64)0);
+    });
+
+    AfterEach([this]
+    {
+        UnLua::FDanglingCheck::Enabled = bWasEnabled;
+    });
+}
+
+#endif
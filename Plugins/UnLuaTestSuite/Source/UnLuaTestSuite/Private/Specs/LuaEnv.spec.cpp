@@ -19,6 +19,25 @@
 
 #if WITH_DEV_AUTOMATION_TESTS
 
+namespace
+{
+    // 记录候选对象的就绪检查次数
+    class FPendingBindTestEnv : public UnLua::FLuaEnv
+    {
+    public:
+        using FLuaEnv::EnqueueBindCandidate;
+
+        bool bReady = false;
+        mutable int32 NumReadyChecks = 0;
+
+    protected:
+        virtual bool IsReadyToBind(const UObject* Object) const override
+        {
+            ++NumReadyChecks;
+            return bReady;
+        }
+    };
+}
 
 BEGIN_DEFINE_SPEC(FLuaEnvSpec, "UnLua.API.FLuaEnv", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
     TSharedPtr<UnLua::FLuaEnv> Env;
@@ -62,6 +81,49 @@ void FLuaEnvSpec::Define()
         });
     });
 
+    Describe(TEXT("异步加载期间的绑定候选对象"), [this]()
+    {
+#if UNLUA_WITH_END_LOAD_PACKAGE
+        It(TEXT("未就绪的对象暂存，之后的Flush不再重复检查，所在Package加载完成后才重新检查"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            FPendingBindTestEnv TestEnv;
+            const auto Object = NewObject<UUnLuaTestStub>();
+            TestEnv.EnqueueBindCandidate(Object);
+
+            FCoreDelegates::OnAsyncLoadingFlushUpdate.Broadcast();
+            TEST_EQUAL(TestEnv.NumReadyChecks, 1);
+
+            TestEnv.bReady = true;
+            FCoreDelegates::OnAsyncLoadingFlushUpdate.Broadcast();
+            TEST_EQUAL(TestEnv.NumReadyChecks, 1);
+
+            const TArray<UPackage*> Packages = {Object->GetOutermost()};
+            FCoreUObjectDelegates::OnEndLoadPackage.Broadcast(FEndLoadPackageContext{Packages, 0, false});
+            TEST_EQUAL(TestEnv.NumReadyChecks, 2);
+
+            FCoreUObjectDelegates::OnEndLoadPackage.Broadcast(FEndLoadPackageContext{Packages, 0, false});
+            TEST_EQUAL(TestEnv.NumReadyChecks, 2);
+        });
+#else
+        It(TEXT("未就绪的对象暂存，之后的Flush重新检查"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            FPendingBindTestEnv TestEnv;
+            const auto Object = NewObject<UUnLuaTestStub>();
+            TestEnv.EnqueueBindCandidate(Object);
+
+            FCoreDelegates::OnAsyncLoadingFlushUpdate.Broadcast();
+            TEST_EQUAL(TestEnv.NumReadyChecks, 1);
+
+            TestEnv.bReady = true;
+            FCoreDelegates::OnAsyncLoadingFlushUpdate.Broadcast();
+            TEST_EQUAL(TestEnv.NumReadyChecks, 2);
+
+            FCoreDelegates::OnAsyncLoadingFlushUpdate.Broadcast();
+            TEST_EQUAL(TestEnv.NumReadyChecks, 2);
+        });
+#endif
+    });
+
     AfterEach([this]
     {
         Env.Reset();
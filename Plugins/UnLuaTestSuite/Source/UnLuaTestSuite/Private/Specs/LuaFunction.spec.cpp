@@ -0,0 +1,105 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "UnLuaBase.h"
+#include "LuaFunction.h"
+#include "UnLuaModule.h"
+#include "Misc/AutomationTest.h"
+#include "UnLuaTestHelpers.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && (ENGINE_MAJOR_VERSION > 4 || ENGINE_MINOR_VERSION >= 25)
+
+BEGIN_DEFINE_SPEC(FLuaFunctionSpec, "UnLua.API.LuaFunction", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+END_DEFINE_SPEC(FLuaFunctionSpec)
+
+void FLuaFunctionSpec::Define()
+{
+    Describe(TEXT("Override"), [this]
+    {
+        It(TEXT("添加到子类的覆写持有自己的属性链，原函数重新编译后仍然有效"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            // 复制一个非原生的UFunction作为原函数，模拟蓝图函数
+            const auto Original = AUnLuaTestActor::StaticClass()->FindFunctionByName(TEXT("TestForIssue445"));
+            const auto Source = static_cast<UFunction*>(StaticDuplicateObject(Original, GetTransientPackage(), TEXT("UnLuaTestLuaFunctionSource")));
+            Source->ClearInternalFlags(EInternalObjectFlags::Native);
+            Source->StaticLink(true);
+
+            TArray<FName> ExpectedNames;
+            TArray<int32> ExpectedOffsets;
+            for (TFieldIterator<FProperty> It(Source); It; ++It)
+            {
+                ExpectedNames.Add(It->GetFName());
+                ExpectedOffsets.Add(It->GetOffset_ForUFunction());
+            }
+
+            UClass* Class = UUnLuaTestStub::StaticClass();
+            const FName NewName = TEXT("UnLuaTestLuaFunctionOverride");
+            ULuaFunction::Override(Source, Class, NewName);
+            const auto LuaFunction = Cast<ULuaFunction>(Class->FindFunctionByName(NewName, EIncludeSuperFlag::ExcludeSuper));
+            TEST_TRUE(LuaFunction != nullptr);
+            if (!LuaFunction)
+                return;
+            TEST_TRUE(LuaFunction->ChildProperties != Source->ChildProperties);
+
+            // 重新编译时原函数的属性链会被销毁重建
+            Source->DestroyChildPropertiesAndResetPropertyLinks();
+
+            TArray<FName> Names;
+            TArray<int32> Offsets;
+            for (TFieldIterator<FProperty> It(LuaFunction); It; ++It)
+            {
+                Names.Add(It->GetFName());
+                Offsets.Add(It->GetOffset_ForUFunction());
+            }
+            TEST_TRUE(Names == ExpectedNames);
+            TEST_TRUE(Offsets == ExpectedOffsets);
+            TEST_EQUAL((int32)LuaFunction->ParmsSize, (int32)Original->ParmsSize);
+
+            ULuaFunction::RestoreOverrides(Class);
+        });
+
+        It(TEXT("子类覆写父类的原生事件时共享原函数的属性链，调用仍然转发到Lua"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            UnLua::Startup();
+            const auto Env = IUnLuaModule::Get().GetEnv();
+            Env->DoString(R"(
+            local M = UnLua.Class()
+            function M:TestNativeEvent(Value)
+                return Value + 1
+            end
+            package.loaded["UnLuaTestLuaFunctionNativeEvent"] = M
+            )");
+
+            UClass* Class = UUnLuaTestStubChild::StaticClass();
+            const auto Object = NewObject<UUnLuaTestStubChild>();
+            TEST_TRUE(Env->GetManager()->Bind(Object, TEXT("UnLuaTestLuaFunctionNativeEvent")));
+
+            const auto Original = UUnLuaTestStub::StaticClass()->FindFunctionByName(TEXT("TestNativeEvent"));
+            const auto LuaFunction = Cast<ULuaFunction>(Class->FindFunctionByName(TEXT("TestNativeEvent"), EIncludeSuperFlag::ExcludeSuper));
+            TEST_TRUE(LuaFunction != nullptr);
+            if (LuaFunction)
+            {
+                TEST_TRUE(LuaFunction->ChildProperties == Original->ChildProperties);
+                TEST_TRUE(LuaFunction->PropertyLink == Original->PropertyLink);
+            }
+            TEST_EQUAL(Object->TestNativeEvent(1), 2);
+
+            ULuaFunction::RestoreOverrides(Class);
+            UnLua::Shutdown();
+        });
+    });
+}
+
+#endif
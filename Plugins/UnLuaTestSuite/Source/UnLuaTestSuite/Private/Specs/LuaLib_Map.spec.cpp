@@ -203,6 +203,34 @@ void FUnLuaLibMapSpec::Define()
             Env->DoString(Chunk);
             TEST_EQUAL(lua_tointeger(L, -1), 1LL);
         });
+
+        It(TEXT("FString作为Key时大小写不敏感"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Map = UE.TMap('',0)
+            Map:Add('Apple',1)
+            return Map:Find('APPLE'), Map:Find('Banana')
+            )";
+            Env->DoString(Chunk);
+            TEST_EQUAL(lua_tointeger(L, -2), 1LL);
+            TEST_TRUE(lua_isnil(L, -1));
+        });
+
+        It(TEXT("UObject作为Key"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local A = NewObject(UE.UUnLuaTestStub)
+            local B = NewObject(UE.UUnLuaTestStub)
+            local Map = UE.TMap(UE.UObject,0)
+            Map:Add(A,1)
+            Map:Add(B,2)
+            Map:Remove(A)
+            return Map:Find(A), Map:Find(B)
+            )";
+            Env->DoString(Chunk);
+            TEST_TRUE(lua_isnil(L, -2));
+            TEST_EQUAL(lua_tointeger(L, -1), 2LL);
+        });
     });
 
     Describe(TEXT("FindRef"), [this]
@@ -304,6 +332,27 @@ void FUnLuaLibMapSpec::Define()
             TEST_EQUAL(lua_tointeger(L, -1), 4LL);
             TEST_EQUAL(lua_tointeger(L, -2), 3LL);
         });
+
+        It(TEXT("移除元素后转为LuaTable"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Map = UE.TMap('',0)
+            for i = 1, 8 do
+                Map:Add('Key' .. i, i)
+            end
+            Map:Remove('Key2')
+            Map:Remove('Key5')
+            local Count, Sum = 0, 0
+            for _, V in pairs(Map:ToTable()) do
+                Count = Count + 1
+                Sum = Sum + V
+            end
+            return Count, Sum
+            )";
+            Env->DoString(Chunk);
+            TEST_EQUAL(lua_tointeger(L, -2), 6LL);
+            TEST_EQUAL(lua_tointeger(L, -1), 29LL);
+        });
     });
 
     Describe(TEXT("pairs"), [this]
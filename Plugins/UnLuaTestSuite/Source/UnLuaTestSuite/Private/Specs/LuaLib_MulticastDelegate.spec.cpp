@@ -73,6 +73,66 @@ void FUnLuaLibMulticastDelegateSpec::Define()
             Stub->SimpleEvent.Broadcast();
             TEST_EQUAL(Stub->Counter, 1);
         });
+
+        It(TEXT("重复添加同一个函数只绑定一次"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const char* Chunk = R"(
+            Stub.SimpleEvent:Add(Stub, Stub.AddCount)
+            Stub.SimpleEvent:Add(Stub, Stub.AddCount)
+            )";
+            UnLua::RunChunk(L, Chunk);
+            Stub->SimpleEvent.Broadcast();
+            TEST_EQUAL(Stub->Counter, 1);
+        });
+
+        It(TEXT("C++中清理后可以重新添加"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            UnLua::RunChunk(L, "Stub.SimpleEvent:Add(Stub, Stub.AddCount)");
+            Stub->SimpleEvent.Clear();
+            UnLua::RunChunk(L, "Stub.SimpleEvent:Add(Stub, Stub.AddCount)");
+            Stub->SimpleEvent.Broadcast();
+            TEST_EQUAL(Stub->Counter, 1);
+        });
+    });
+
+    Describe(TEXT("AddListeners/RemoveListeners"), [this]()
+    {
+        It(TEXT("批量添加和移除绑定"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const char* Chunk = R"(
+            Counter = 0
+            local Callback = function() Counter = Counter + 1 end
+            local Listeners = { Stub.SimpleEvent, Stub.AddCount, Stub.SimpleEvent, Callback }
+            local Added = UnLua.AddListeners(Stub, Listeners)
+            local Duplicated = UnLua.AddListeners(Stub, Listeners)
+            Stub.SimpleEvent:Broadcast()
+            local Removed = UnLua.RemoveListeners(Stub, Listeners)
+            return Added, Duplicated, Removed
+            )";
+            UnLua::RunChunk(L, Chunk);
+            TEST_EQUAL(lua_tointeger(L, -3), 2LL);
+            TEST_EQUAL(lua_tointeger(L, -2), 0LL);
+            TEST_EQUAL(lua_tointeger(L, -1), 2LL);
+            TEST_EQUAL(Stub->Counter, 1);
+            TEST_FALSE(Stub->SimpleEvent.IsBound());
+            lua_getglobal(L, "Counter");
+            TEST_EQUAL(lua_tointeger(L, -1), 1LL);
+        });
+
+        It(TEXT("委托和函数没有成对出现时报错"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const char* Chunk = R"(
+            local Callback = function() end
+            local Listeners = { Stub.SimpleEvent, Callback, Stub.SimpleEvent }
+            local AddOk = pcall(UnLua.AddListeners, Stub, Listeners)
+            local RemoveOk = pcall(UnLua.RemoveListeners, Stub, Listeners)
+            return AddOk, RemoveOk
+            )";
+            UnLua::RunChunk(L, Chunk);
+            TEST_FALSE(lua_toboolean(L, -2));
+            TEST_FALSE(lua_toboolean(L, -1));
+            TEST_FALSE(Stub->SimpleEvent.IsBound());
+        });
     });
 
     Describe(TEXT("Remove"), [this]()
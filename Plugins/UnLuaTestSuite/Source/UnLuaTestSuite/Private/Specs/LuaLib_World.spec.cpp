@@ -17,6 +17,7 @@
 #include "GameFramework/DefaultPawn.h"
 #include "Misc/AutomationTest.h"
 #include "Engine.h"
+#include "EngineUtils.h"
 #include "UnLuaTestHelpers.h"
 
 #if WITH_DEV_AUTOMATION_TESTS
@@ -157,6 +158,66 @@ void FUnLuaLibWorldSpec::Define()
         });
     });
 
+    Describe(TEXT("SpawnActorDeferred"), [this]
+    {
+        It(TEXT("创建Actor，在FinishSpawning之前写入属性"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto OwnerActor = World->SpawnActor(AActor::StaticClass());
+            UnLua::PushUObject(L, OwnerActor);
+            lua_setglobal(L, "G_OwnerActor");
+
+            const auto Chunk = R"(
+            local Transform = UE.FTransform(UE.FQuat(0,0,0,1), UE.FVector(1,2,3))
+            local Actor = World:SpawnActorDeferred(UE.AActor, Transform, { CustomTimeDilation = 0.5, NotExist = 1 }, { Owner = G_OwnerActor })
+            return Actor
+            )";
+            UnLua::RunChunk(L, Chunk);
+            const auto Actor = (AActor*)UnLua::GetUObject(L, -1);
+            TEST_EQUAL(Actor->CustomTimeDilation, 0.5f);
+            TEST_EQUAL(Actor->GetActorLocation(), FVector(1,2,3));
+            TEST_EQUAL(Actor->GetOwner(), OwnerActor);
+        });
+
+        It(TEXT("写入属性出错时销毁未完成构造的Actor"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            int32 NumActors = 0;
+            for (TActorIterator<AActor> It(World); It; ++It)
+                ++NumActors;
+
+            const auto Chunk = R"(
+            return pcall(World.SpawnActorDeferred, World, UE.AActor, UE.FTransform(), { CustomTimeDilation = 0.5 }, { Fields = { 1 } })
+            )";
+            UnLua::RunChunk(L, Chunk);
+            TEST_FALSE(lua_toboolean(L, -2));
+
+            int32 NumActorsAfter = 0;
+            for (TActorIterator<AActor> It(World); It; ++It)
+                ++NumActorsAfter;
+            TEST_EQUAL(NumActorsAfter, NumActors);
+        });
+    });
+
+    Describe(TEXT("SpawnActors"), [this]
+    {
+        It(TEXT("批量创建Actor，每个Actor使用各自的属性表"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Transforms, Properties = {}, {}
+            for i = 1, 3 do
+                Transforms[i] = UE.FTransform(UE.FQuat(0,0,0,1), UE.FVector(i,0,0))
+                Properties[i] = { CustomTimeDilation = i }
+            end
+            local Actors = World:SpawnActors(UE.AActor, Transforms, Properties, { Fields = { "CustomTimeDilation" } })
+            return #Actors, Actors[3]
+            )";
+            UnLua::RunChunk(L, Chunk);
+            TEST_EQUAL(lua_tointeger(L, -2), 3LL);
+            const auto Actor = (AActor*)UnLua::GetUObject(L, -1);
+            TEST_EQUAL(Actor->CustomTimeDilation, 3.0f);
+            TEST_EQUAL(Actor->GetActorLocation(), FVector(3,0,0));
+        });
+    });
+
     AfterEach([this]
     {
         GEngine->DestroyWorldContext(World);
@@ -0,0 +1,66 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "LuaModuleLocator.h"
+#include "UnLuaTestHelpers.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FLuaModuleLocatorSpec, "UnLua.API.LuaModuleLocator", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+END_DEFINE_SPEC(FLuaModuleLocatorSpec)
+
+void FLuaModuleLocatorSpec::Define()
+{
+    Describe(TEXT("LocateCached"), [this]()
+    {
+        It(TEXT("内置的Locator按类缓存"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto Locator = NewObject<ULuaModuleLocator_ByPackage>();
+            const auto Object1 = NewObject<UUnLuaTestStub>();
+            const auto Object2 = NewObject<UUnLuaTestStub>();
+            const auto ModuleName1 = Locator->LocateCached(Object1);
+            const auto ModuleName2 = Locator->LocateCached(Object2);
+            TEST_TRUE(ModuleName1.IsValid());
+            TEST_TRUE(ModuleName1 == ModuleName2);
+        });
+
+        It(TEXT("自定义的Locator默认不缓存"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto Locator = NewObject<UUnLuaTestModuleLocator>();
+            const auto Object1 = NewObject<UUnLuaTestStub>();
+            const auto Object2 = NewObject<UUnLuaTestStub>();
+            const auto ModuleName1 = Locator->LocateCached(Object1);
+            const auto ModuleName2 = Locator->LocateCached(Object2);
+            TEST_EQUAL(*ModuleName1, Object1->GetName());
+            TEST_EQUAL(*ModuleName2, Object2->GetName());
+        });
+
+        It(TEXT("预先写入缓存的模块名直接命中"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto Locator = NewObject<ULuaModuleLocator_ByPackage>();
+            TEST_TRUE(Locator->CanLocateConcurrently());
+            TEST_FALSE(NewObject<UUnLuaTestModuleLocator>()->CanLocateConcurrently());
+
+            Locator->AddToCache(UUnLuaTestStub::StaticClass(), TEXT("Tests.Specs.Prebound"));
+            const auto ModuleName = Locator->LocateCached(NewObject<UUnLuaTestStub>());
+            TEST_TRUE(ModuleName.IsValid());
+            if (ModuleName.IsValid())
+                TEST_EQUAL(*ModuleName, FString(TEXT("Tests.Specs.Prebound")));
+        });
+    });
+}
+
+#endif
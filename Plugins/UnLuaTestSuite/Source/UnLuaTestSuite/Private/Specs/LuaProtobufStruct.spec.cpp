@@ -0,0 +1,130 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "UnLuaBase.h"
+#include "UnLuaTemplate.h"
+#include "Misc/AutomationTest.h"
+#include "UnLuaTestHelpers.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FLuaProtobufStructSpec, "UnLua.Extensions.LuaProtobuf.Struct", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+    TSharedPtr<UnLua::FLuaEnv> Env;
+    lua_State* L;
+END_DEFINE_SPEC(FLuaProtobufStructSpec)
+
+void FLuaProtobufStructSpec::Define()
+{
+    BeforeEach([this]
+    {
+        Env = MakeShared<UnLua::FLuaEnv>();
+        L = Env->GetMainState();
+
+        const auto Chunk = R"(
+        pb = require("pb")
+        protoc = require("protoc")
+        )";
+        Env->DoString(Chunk);
+    });
+
+    AfterEach([this]
+    {
+        Env.Reset();
+        L = nullptr;
+    });
+
+    Describe(TEXT("decode_struct/encode_struct"), [this]
+    {
+        It(TEXT("多个字段的消息全部解码与编码"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            assert(protoc:load([[
+            syntax = "proto3";
+            message Vec { double X = 1; double Y = 2; double Z = 3; }
+            ]]))
+            local Vector = UE.FVector()
+            pb.decode_struct("Vec", pb.encode("Vec", {X = 1, Y = 2, Z = 3}), Vector)
+            Vector.Y = 20
+            local Decoded = pb.decode("Vec", pb.encode_struct("Vec", Vector))
+            return Vector.X, Vector.Z, Decoded.X, Decoded.Y, Decoded.Z
+            )";
+            Env->DoString(Chunk);
+            TEST_EQUAL(lua_tonumber(L, -5), 1.0);
+            TEST_EQUAL(lua_tonumber(L, -4), 3.0);
+            TEST_EQUAL(lua_tonumber(L, -3), 1.0);
+            TEST_EQUAL(lua_tonumber(L, -2), 20.0);
+            TEST_EQUAL(lua_tonumber(L, -1), 3.0);
+        });
+
+        It(TEXT("字段编号不连续时按编号查找"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            assert(protoc:load([[
+            syntax = "proto3";
+            message Color { float R = 1; float G = 3; float B = 8; float A = 2000; }
+            ]]))
+            local Color = UE.FLinearColor()
+            pb.decode_struct("Color", pb.encode("Color", {R = 0.25, G = 0.5, B = 0.75, A = 1}), Color)
+            return Color.R, Color.G, Color.B, Color.A
+            )";
+            Env->DoString(Chunk);
+            TEST_EQUAL(lua_tonumber(L, -4), 0.25);
+            TEST_EQUAL(lua_tonumber(L, -3), 0.5);
+            TEST_EQUAL(lua_tonumber(L, -2), 0.75);
+            TEST_EQUAL(lua_tonumber(L, -1), 1.0);
+        });
+
+        It(TEXT("新的Lua环境不复用已关闭环境的绑定"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            Env->DoString(R"(
+            assert(protoc:load('syntax = "proto3"; message Vec { double X = 1; double Y = 2; double Z = 3; }'))
+            pb.decode_struct("Vec", pb.encode("Vec", {X = 1}), UE.FVector())
+            )");
+            Env.Reset();
+
+            Env = MakeShared<UnLua::FLuaEnv>();
+            L = Env->GetMainState();
+            const auto Chunk = R"(
+            local pb = require("pb")
+            assert(require("protoc"):load('syntax = "proto3"; message Vec { double Z = 1; double X = 2; }'))
+            local Vector = UE.FVector()
+            pb.decode_struct("Vec", pb.encode("Vec", {X = 5, Z = 7}), Vector)
+            return Vector.X, Vector.Z
+            )";
+            Env->DoString(Chunk);
+            TEST_EQUAL(lua_tonumber(L, -2), 5.0);
+            TEST_EQUAL(lua_tonumber(L, -1), 7.0);
+        });
+
+        It(TEXT("pb.clear后重新加载的类型重新绑定"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            assert(protoc:load('syntax = "proto3"; message Vec { double X = 1; }'))
+            local Vector = UE.FVector()
+            pb.decode_struct("Vec", pb.encode("Vec", {X = 1}), Vector)
+            pb.clear()
+            protoc.reload()
+            assert(protoc:load('syntax = "proto3"; message Vec { double Y = 1; }'))
+            pb.decode_struct("Vec", pb.encode("Vec", {Y = 2}), Vector)
+            return Vector.X, Vector.Y
+            )";
+            Env->DoString(Chunk);
+            TEST_EQUAL(lua_tonumber(L, -2), 0.0);
+            TEST_EQUAL(lua_tonumber(L, -1), 2.0);
+        });
+    });
+}
+
+#endif
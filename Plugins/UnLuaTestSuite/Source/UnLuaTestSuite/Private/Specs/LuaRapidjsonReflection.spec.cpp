@@ -0,0 +1,101 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "UnLuaBase.h"
+#include "UnLuaTemplate.h"
+#include "Misc/AutomationTest.h"
+#include "UnLuaTestHelpers.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FLuaRapidjsonReflectionSpec, "UnLua.Extensions.LuaRapidjson.Reflection", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+    TSharedPtr<UnLua::FLuaEnv> Env;
+    lua_State* L;
+END_DEFINE_SPEC(FLuaRapidjsonReflectionSpec)
+
+void FLuaRapidjsonReflectionSpec::Define()
+{
+    BeforeEach([this]
+    {
+        Env = MakeShared<UnLua::FLuaEnv>();
+        L = Env->GetMainState();
+        Env->DoString("rapidjson = require('rapidjson')");
+    });
+
+    AfterEach([this]
+    {
+        Env.Reset();
+        L = nullptr;
+    });
+
+    Describe(TEXT("decode_into"), [this]
+    {
+        It(TEXT("解码到结构体"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Vector = rapidjson.decode_into('{"X": 1, "Y": 2, "Z": 3}', UE.FVector())
+            return Vector.X, Vector.Y, Vector.Z
+            )";
+            Env->DoString(Chunk);
+            TEST_EQUAL(lua_tonumber(L, -3), 1.0);
+            TEST_EQUAL(lua_tonumber(L, -2), 2.0);
+            TEST_EQUAL(lua_tonumber(L, -1), 3.0);
+        });
+
+        It(TEXT("整数超出属性范围时解码失败"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Point = UE.FIntPoint(1, 2)
+            local Result1 = rapidjson.decode_into('{"X": 1e20}', Point)
+            local Result2 = rapidjson.decode_into('{"Y": 4294967296}', Point)
+            return Result1 == nil, Result2 == nil, Point.X, Point.Y
+            )";
+            Env->DoString(Chunk);
+            TEST_TRUE(lua_toboolean(L, -4));
+            TEST_TRUE(lua_toboolean(L, -3));
+            TEST_EQUAL(lua_tointeger(L, -2), 1LL);
+            TEST_EQUAL(lua_tointeger(L, -1), 2LL);
+        });
+
+        It(TEXT("解码失败时目标保持原样"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Stub = NewObject(UE.UUnLuaTestStub)
+            Stub.Counter = 1
+            local Result, Error = rapidjson.decode_into('{"Counter": 5, "MapForIssue407": {"x": 1}}', Stub)
+            return Result == nil, Error ~= nil, Stub.Counter, Stub.MapForIssue407:Length()
+            )";
+            Env->DoString(Chunk);
+            TEST_TRUE(lua_toboolean(L, -4));
+            TEST_TRUE(lua_toboolean(L, -3));
+            TEST_EQUAL(lua_tointeger(L, -2), 1LL);
+            TEST_EQUAL(lua_tointeger(L, -1), 2LL);
+        });
+
+        It(TEXT("重复的键以最后一个为准"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Stub = NewObject(UE.UUnLuaTestStub)
+            rapidjson.decode_into('{"MapForIssue407": {"3": 1, "4": 1, "3": 2}}', Stub)
+            return Stub.MapForIssue407:Length(), Stub.MapForIssue407:Find(3)
+            )";
+            Env->DoString(Chunk);
+            TEST_EQUAL(lua_tointeger(L, -2), 2LL);
+            TEST_EQUAL(lua_tointeger(L, -1), 2LL);
+        });
+    });
+}
+
+#endif
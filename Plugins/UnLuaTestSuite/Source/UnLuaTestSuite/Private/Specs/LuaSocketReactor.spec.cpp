@@ -0,0 +1,231 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+//
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License");
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+
+#include "UnLuaBase.h"
+#include "UnLuaTemplate.h"
+#include "Misc/AutomationTest.h"
+#include "UnLuaTestHelpers.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FLuaSocketReactorSpec, "UnLua.Extensions.LuaSocket.Reactor", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+    TSharedPtr<UnLua::FLuaEnv> Env;
+    lua_State* L;
+END_DEFINE_SPEC(FLuaSocketReactorSpec)
+
+void FLuaSocketReactorSpec::Define()
+{
+    BeforeEach([this]
+    {
+        Env = MakeShared<UnLua::FLuaEnv>();
+        L = Env->GetMainState();
+
+        // 只使用本机回环地址，step驱动事件循环直到所有协程结束或超时
+        const auto Chunk = R"(
+        socket = require("socket")
+        async = require("socket.async")
+        reactor = require("socket.reactor")
+        function run(timeout)
+            local deadline = socket.gettime() + (timeout or 5)
+            while reactor.count() > 0 and socket.gettime() < deadline do
+                reactor.step(0.01)
+            end
+            return reactor.count()
+        end
+        )";
+        Env->DoString(Chunk);
+    });
+
+    AfterEach([this]
+    {
+        Env.Reset();
+        L = nullptr;
+    });
+
+    Describe(TEXT("协程等待socket"), [this]
+    {
+        It(TEXT("回环地址上收发一行数据"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local server = assert(async.listen("127.0.0.1", 0))
+            local _, port = server:getsockname()
+            local reply
+            async.spawn(function()
+                local client = assert(async.accept(server, 5))
+                local buffer = async.buffer(1024)
+                local line = assert(async.readline(client, buffer, 5))
+                assert(async.send(client, line:upper() .. "\r\n", 5))
+                async.close(client)
+            end)
+            async.spawn(function()
+                local sock = assert(async.connect("127.0.0.1", port, 5))
+                assert(async.send(sock, "hello\n", 5))
+                reply = async.readline(sock, async.buffer(1024), 5)
+                async.close(sock)
+            end)
+            local pending = run()
+            server:close()
+            return reply, pending
+            )";
+            Env->DoString(Chunk);
+            TEST_EQUAL(lua_tostring(L, -2), "HELLO");
+            TEST_EQUAL((int32)lua_tointeger(L, -1), 0);
+        });
+
+        It(TEXT("多个连接共用一个事件循环"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local server = assert(async.listen("127.0.0.1", 0))
+            local _, port = server:getsockname()
+            local count = 8
+            local total = 0
+            async.spawn(function()
+                for i = 1, count do
+                    local client = assert(async.accept(server, 5))
+                    async.spawn(function()
+                        local data = assert(async.read(client, async.buffer(16), 4, 5))
+                        total = total + tonumber(data)
+                        async.close(client)
+                    end)
+                end
+            end)
+            for i = 1, count do
+                async.spawn(function()
+                    local sock = assert(async.connect("127.0.0.1", port, 5))
+                    assert(async.send(sock, string.format("%04d", i), 5))
+                    reactor.wait(sock, "r", 5)
+                    async.close(sock)
+                end)
+            end
+            run()
+            server:close()
+            return total
+            )";
+            Env->DoString(Chunk);
+            TEST_EQUAL((int32)lua_tointeger(L, -1), 36);
+        });
+
+        It(TEXT("超时后返回timeout"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local server = assert(async.listen("127.0.0.1", 0))
+            local ok, err
+            async.spawn(function()
+                ok, err = reactor.wait(server, "r", 0.05)
+            end)
+            run()
+            server:close()
+            return ok, err
+            )";
+            Env->DoString(Chunk);
+            TEST_TRUE(lua_isnil(L, -2));
+            TEST_EQUAL(lua_tostring(L, -1), "timeout");
+        });
+
+        It(TEXT("cancel唤醒等待中的协程"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local server = assert(async.listen("127.0.0.1", 0))
+            local err
+            async.spawn(function()
+                _, err = reactor.wait(server, "r")
+            end)
+            local woken = reactor.cancel(server)
+            server:close()
+            return woken, err, reactor.count()
+            )";
+            Env->DoString(Chunk);
+            TEST_EQUAL((int32)lua_tointeger(L, -3), 1);
+            TEST_EQUAL(lua_tostring(L, -2), "closed");
+            TEST_EQUAL((int32)lua_tointeger(L, -1), 0);
+        });
+
+        It(TEXT("没有cancel直接关闭socket时唤醒等待中的协程"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local server = assert(async.listen("127.0.0.1", 0))
+            local ok, err
+            async.spawn(function()
+                ok, err = reactor.wait(server, "r")
+            end)
+            server:close()
+            local before = err
+            reactor.step()
+            return before, ok, err, reactor.count()
+            )";
+            Env->DoString(Chunk);
+            TEST_TRUE(lua_isnil(L, -4));
+            TEST_TRUE(lua_isnil(L, -3));
+            TEST_EQUAL(lua_tostring(L, -2), "closed");
+            TEST_EQUAL((int32)lua_tointeger(L, -1), 0);
+        });
+
+        It(TEXT("不在协程中调用wait时报错"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local server = assert(async.listen("127.0.0.1", 0))
+            local ok = pcall(reactor.wait, server, "r")
+            server:close()
+            return ok
+            )";
+            Env->DoString(Chunk);
+            TEST_FALSE(lua_toboolean(L, -1));
+        });
+    });
+
+    Describe(TEXT("接收缓冲区"), [this]
+    {
+        It(TEXT("按行和按长度读取"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local server = assert(async.listen("127.0.0.1", 0))
+            local _, port = server:getsockname()
+            local result = {}
+            async.spawn(function()
+                local client = assert(async.accept(server, 5))
+                assert(async.send(client, "first\r\nsecond\nXYZ", 5))
+                async.close(client)
+            end)
+            async.spawn(function()
+                local sock = assert(async.connect("127.0.0.1", port, 5))
+                local buffer = async.buffer(64)
+                while buffer:size() < 17 do
+                    if not async.receive(sock, buffer, 5) then break end
+                end
+                result.find = buffer:find("second")
+                result.first = buffer:readline()
+                result.second = buffer:readline()
+                result.noline = buffer:readline()
+                result.peek = buffer:peek(2, 3)
+                result.rest = buffer:read()
+                result.size = #buffer
+                async.close(sock)
+            end)
+            run()
+            server:close()
+            return result.find, result.first, result.second, result.noline, result.peek, result.rest, result.size
+            )";
+            Env->DoString(Chunk);
+            TEST_EQUAL((int32)lua_tointeger(L, -7), 8);
+            TEST_EQUAL(lua_tostring(L, -6), "first");
+            TEST_EQUAL(lua_tostring(L, -5), "second");
+            TEST_TRUE(lua_isnil(L, -4));
+            TEST_EQUAL(lua_tostring(L, -3), "YZ");
+            TEST_EQUAL(lua_tostring(L, -2), "XYZ");
+            TEST_EQUAL((int32)lua_tointeger(L, -1), 0);
+        });
+    });
+}
+
+#endif
@@ -0,0 +1,79 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "UnLuaBase.h"
+#include "UnLuaTemplate.h"
+#include "Misc/AutomationTest.h"
+#include "UnLuaTestHelpers.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FMetatableTemplateSpec, "UnLua.API.MetatableTemplate", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+    TSharedPtr<UnLua::FLuaEnv> Env1;
+    TSharedPtr<UnLua::FLuaEnv> Env2;
+END_DEFINE_SPEC(FMetatableTemplateSpec)
+
+void FMetatableTemplateSpec::Define()
+{
+    BeforeEach([this]
+    {
+        Env1 = MakeShared<UnLua::FLuaEnv>();
+        Env2 = MakeShared<UnLua::FLuaEnv>();
+    });
+
+    AfterEach([this]
+    {
+        Env1.Reset();
+        Env2.Reset();
+    });
+
+    Describe(TEXT("多个Lua环境共享元表描述"), [this]
+    {
+        It(TEXT("后创建的环境中结构体的元表与导出函数可用"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local V = UE.FVector(1, 2, 3) + UE.FVector(1, 1, 1)
+            local Copied = V:Copy()
+            return V.X, Copied == V, V:Size() > 0
+            )";
+            for (const auto& Env : {Env1, Env2})
+            {
+                const auto L = Env->GetMainState();
+                Env->DoString(Chunk);
+                TEST_EQUAL(lua_tonumber(L, -3), 2.0);
+                TEST_TRUE(lua_toboolean(L, -2));
+                TEST_TRUE(lua_toboolean(L, -1));
+            }
+        });
+
+        It(TEXT("每个环境的元表指向各自的ClassDesc"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Class = UE.UUnLuaTestStub
+            return rawget(Class, "ClassDesc"), Class.StaticClass() == UE.UUnLuaTestStub.StaticClass()
+            )";
+            Env1->DoString(Chunk);
+            Env2->DoString(Chunk);
+            const auto L1 = Env1->GetMainState();
+            const auto L2 = Env2->GetMainState();
+            TEST_TRUE(lua_touserdata(L1, -2) != nullptr);
+            TEST_TRUE(lua_touserdata(L2, -2) != nullptr);
+            TEST_TRUE(lua_touserdata(L1, -2) != lua_touserdata(L2, -2));
+            TEST_TRUE(lua_toboolean(L2, -1));
+        });
+    });
+}
+
+#endif
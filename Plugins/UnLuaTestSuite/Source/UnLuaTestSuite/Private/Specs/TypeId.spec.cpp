@@ -0,0 +1,78 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "UnLuaBase.h"
+#include "LowLevel.h"
+#include "Misc/AutomationTest.h"
+#include "UnLuaTestHelpers.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FUnLuaTypeIdSpec, "UnLua.API.TypeId", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+    TSharedPtr<UnLua::FLuaEnv> Env;
+    lua_State* L;
+END_DEFINE_SPEC(FUnLuaTypeIdSpec)
+
+void FUnLuaTypeIdSpec::Define()
+{
+    BeforeEach([this]
+    {
+        Env = MakeShared<UnLua::FLuaEnv>();
+        L = Env->GetMainState();
+    });
+
+    AfterEach([this]
+    {
+        Env.Reset();
+        L = nullptr;
+    });
+
+    Describe(TEXT("GetTypeId"), [this]
+    {
+        It(TEXT("同一元表名总是得到同一个ID"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const int32 TypeId = UnLua::LowLevel::GetTypeId("FVector");
+            TEST_TRUE(TypeId > 0);
+            TEST_EQUAL(UnLua::LowLevel::GetTypeId("FVector"), TypeId);
+            TEST_TRUE(UnLua::LowLevel::GetTypeId("TArray") != TypeId);
+            TEST_EQUAL(UnLua::LowLevel::GetTypeName(TypeId), FString(TEXT("FVector")));
+            TEST_EQUAL(UnLua::LowLevel::GetTypeId(""), 0);
+        });
+
+        It(TEXT("userdata的类型ID与元表名一致，并在多个Lua环境间共享"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            Env->DoString("return UE.FVector(), UE.TArray(0)");
+            TEST_EQUAL(UnLua::LowLevel::GetTypeId(L, -2), UnLua::LowLevel::GetTypeId("FVector"));
+            TEST_EQUAL(UnLua::LowLevel::GetTypeId(L, -1), UnLua::LowLevel::GetTypeId("TArray"));
+
+            const auto OtherEnv = MakeShared<UnLua::FLuaEnv>();
+            const auto OtherL = OtherEnv->GetMainState();
+            OtherEnv->DoString("return UE.FVector()");
+            TEST_EQUAL(UnLua::LowLevel::GetTypeId(OtherL, -1), UnLua::LowLevel::GetTypeId("FVector"));
+        });
+
+        It(TEXT("非userdata或没有元表名时返回0"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const int32 Top = lua_gettop(L);
+            lua_newtable(L);
+            lua_pushinteger(L, 1);
+            TEST_EQUAL(UnLua::LowLevel::GetTypeId(L, -2), 0);
+            TEST_EQUAL(UnLua::LowLevel::GetTypeId(L, -1), 0);
+            TEST_EQUAL(lua_gettop(L), Top + 2);
+        });
+    });
+}
+
+#endif
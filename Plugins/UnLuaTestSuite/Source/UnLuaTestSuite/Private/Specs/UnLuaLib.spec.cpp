@@ -0,0 +1,183 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+//
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License");
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+
+#include "UnLuaBase.h"
+#include "UnLuaTemplate.h"
+#include "Misc/AutomationTest.h"
+#include "UnLuaTestHelpers.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FUnLuaLibSpec, "UnLua.API.UnLuaLib", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+    TSharedPtr<UnLua::FLuaEnv> Env;
+    lua_State* L;
+END_DEFINE_SPEC(FUnLuaLibSpec)
+
+void FUnLuaLibSpec::Define()
+{
+    BeforeEach([this]
+    {
+        Env = MakeShared<UnLua::FLuaEnv>();
+        L = Env->GetMainState();
+    });
+
+    AfterEach([this]
+    {
+        Env.Reset();
+        L = nullptr;
+    });
+
+    Describe(TEXT("Snapshot"), [this]
+    {
+        It(TEXT("一次读取结构体的多个字段"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Vector = UE.FVector(1, 2, 3)
+            local Values = UnLua.Snapshot(Vector, {"X", "Y", "Z"})
+            return Values.X, Values.Y, Values.Z
+            )";
+            Env->DoString(Chunk);
+            TEST_EQUAL(lua_tonumber(L, -3), 1.0);
+            TEST_EQUAL(lua_tonumber(L, -2), 2.0);
+            TEST_EQUAL(lua_tonumber(L, -1), 3.0);
+        });
+
+        It(TEXT("读取UObject的字段，不存在的字段为nil"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Stub = NewObject(UE.UUnLuaTestStub)
+            Stub.Counter = 5
+            local Values = UnLua.Snapshot(Stub, {"Counter", "NotExist"})
+            return Values.Counter, Values.NotExist
+            )";
+            Env->DoString(Chunk);
+            TEST_EQUAL((int32)lua_tointeger(L, -2), 5);
+            TEST_TRUE(lua_isnil(L, -1));
+        });
+
+        It(TEXT("复用传入的结果表"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Fields = {"X", "Y"}
+            local Out = {}
+            local First = UnLua.Snapshot(UE.FVector(1, 2, 3), Fields, Out)
+            local Second = UnLua.Snapshot(UE.FVector(4, 5, 6), Fields, Out)
+            return First == Out and Second == Out, Out.X
+            )";
+            Env->DoString(Chunk);
+            TEST_TRUE(lua_toboolean(L, -2));
+            TEST_EQUAL(lua_tonumber(L, -1), 4.0);
+        });
+    });
+
+    Describe(TEXT("Apply"), [this]
+    {
+        It(TEXT("按表中的键写入字段"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Vector = UE.FVector(1, 2, 3)
+            local Count = UnLua.Apply(Vector, {X = 10, Z = 30, NotExist = 0})
+            return Count, Vector.X, Vector.Y, Vector.Z
+            )";
+            Env->DoString(Chunk);
+            TEST_EQUAL((int32)lua_tointeger(L, -4), 2);
+            TEST_EQUAL(lua_tonumber(L, -3), 10.0);
+            TEST_EQUAL(lua_tonumber(L, -2), 2.0);
+            TEST_EQUAL(lua_tonumber(L, -1), 30.0);
+        });
+
+        It(TEXT("指定字段表时只写入这些字段"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Stub = NewObject(UE.UUnLuaTestStub)
+            local Source = NewObject(UE.UUnLuaTestStub)
+            Source.Counter = 42
+            local Fields = {"Counter"}
+            local Count = UnLua.Apply(Stub, UnLua.Snapshot(Source, Fields), Fields)
+            return Count, Stub.Counter
+            )";
+            Env->DoString(Chunk);
+            TEST_EQUAL((int32)lua_tointeger(L, -2), 1);
+            TEST_EQUAL((int32)lua_tointeger(L, -1), 42);
+        });
+    });
+
+    Describe(TEXT("Release"), [this]
+    {
+        It(TEXT("释放的结构体被同类型的临时结构体复用"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local A = UE.FVector(1, 2, 3)
+            local B = UE.FVector(4, 5, 6)
+            local C = A + B
+            local Released = UnLua.Release(C)
+            local D = A + B
+            return Released, rawequal(C, D), D.X
+            )";
+            Env->DoString(Chunk);
+            TEST_TRUE(lua_toboolean(L, -3));
+            TEST_TRUE(lua_toboolean(L, -2));
+            TEST_EQUAL(lua_tonumber(L, -1), 5.0);
+        });
+
+        It(TEXT("重复释放或非结构体不会放入池中"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local V = UE.FVector()
+            return UnLua.Release(V), UnLua.Release(V), UnLua.Release({})
+            )";
+            Env->DoString(Chunk);
+            TEST_TRUE(lua_toboolean(L, -3));
+            TEST_FALSE(lua_toboolean(L, -2));
+            TEST_FALSE(lua_toboolean(L, -1));
+        });
+    });
+
+    Describe(TEXT("Class"), [this]
+    {
+        It(TEXT("沿Super链查找字段并缓存到实例上"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Base = UnLua.Class()
+            Base.Value = 1
+            function Base:Get() return self.Value end
+            local Derived = UnLua.Class()
+            Derived.Super = Base
+            local Instance = setmetatable({}, Derived)
+            return Instance:Get(), rawget(Instance, "Get") == Base.Get, rawget(Instance, "Value")
+            )";
+            Env->DoString(Chunk);
+            TEST_EQUAL((int32)lua_tointeger(L, -3), 1);
+            TEST_TRUE(lua_toboolean(L, -2));
+            TEST_EQUAL((int32)lua_tointeger(L, -1), 1);
+        });
+
+        It(TEXT("不存在的字段返回nil，赋值写到实例上"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Class = UnLua.Class()
+            local Instance = setmetatable({}, Class)
+            local Missing = Instance.NotExist
+            Instance.NotExist = 5
+            return Missing, rawget(Instance, "NotExist"), rawget(Class, "NotExist") ~= nil
+            )";
+            Env->DoString(Chunk);
+            TEST_TRUE(lua_isnil(L, -3));
+            TEST_EQUAL((int32)lua_tointeger(L, -2), 5);
+            TEST_TRUE(lua_toboolean(L, -1));
+        });
+    });
+}
+
+#endif
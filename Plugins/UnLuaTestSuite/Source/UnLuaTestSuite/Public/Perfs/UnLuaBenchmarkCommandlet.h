@@ -0,0 +1,37 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "UnLuaBenchmarkCommandlet.generated.h"
+
+/**
+ * 无界面的性能基准测试，可以在-nullrhi下运行
+ *
+ * -run=UnLuaBenchmark [-Iterations=100000] [-Repeat=5] [-Filter=Name] [-Output=File.json] [-Baseline=File.json] [-Threshold=0.1]
+ *
+ * 输出每个操作的耗时（纳秒）与Lua内存分配次数/字节数，指定Baseline时与之对比，超过阈值的回退会使返回值非0
+ */
+UCLASS()
+class UUnLuaBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UUnLuaBenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -21,6 +21,7 @@
 #include "GameFramework/Character.h"
 #include "UnLua.h"
 #include "UnLuaInterface.h"
+#include "LuaModuleLocator.h"
 #include "UnLuaTestHelpers.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FUnLuaTestSimpleEvent);
@@ -108,6 +109,15 @@ public:
 
     UFUNCTION(BlueprintCallable)
     int32 TestForIssue407(TArray<int32> Array);
+
+    UFUNCTION(BlueprintImplementableEvent)
+    int32 TestNativeEvent(int32 Value);
+};
+
+UCLASS()
+class UNLUATESTSUITE_API UUnLuaTestStubChild : public UUnLuaTestStub
+{
+    GENERATED_BODY()
 };
 
 UCLASS()
@@ -167,6 +177,15 @@ struct UNLUATESTSUITE_API FUnLuaTestTableRow : public FTableRowBase
     }
 };
 
+UCLASS()
+class UNLUATESTSUITE_API UUnLuaTestModuleLocator : public ULuaModuleLocator
+{
+    GENERATED_BODY()
+
+public:
+    virtual FString Locate(const UObject* Object) override { return Object->GetName(); }
+};
+
 struct UNLUATESTSUITE_API FUnLuaTestLib
 {
     static void TestForBaseSpec1(int32 A, int32& B, const int32& C, FString& D)